@@ -13,4 +13,7 @@ namespace ROCKSDB_NAMESPACE {
 
 constexpr uint64_t kInvalidBlobFileNumber = 0;
 
+// The compress_format_version used for the values stored in blob files.
+constexpr uint32_t kBlobCompressionFormatVersion = 2;
+
 }  // namespace ROCKSDB_NAMESPACE
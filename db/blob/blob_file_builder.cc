@@ -0,0 +1,279 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#ifndef ROCKSDB_LITE
+
+#include "db/blob/blob_file_builder.h"
+
+#include <cassert>
+
+#include "db/blob/blob_constants.h"
+#include "db/blob/blob_file_addition.h"
+#include "db/blob/blob_index.h"
+#include "db/blob/blob_log_format.h"
+#include "db/blob/blob_log_writer.h"
+#include "db/dbformat.h"
+#include "file/filename.h"
+#include "file/read_write_util.h"
+#include "file/writable_file_writer.h"
+#include "options/cf_options.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "table/block_based/block_based_table_builder.h"
+#include "test_util/sync_point.h"
+#include "util/compression.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+BlobFileBuilder::BlobFileBuilder(
+    std::function<uint64_t()> file_number_generator, Env* env, FileSystem* fs,
+    const ImmutableCFOptions* immutable_cf_options,
+    const FileOptions* file_options, uint32_t column_family_id,
+    Env::IOPriority io_priority, Env::WriteLifeTimeHint write_hint,
+    std::vector<BlobFileAddition>* blob_file_additions)
+    : file_number_generator_(std::move(file_number_generator)),
+      env_(env),
+      fs_(fs),
+      immutable_cf_options_(immutable_cf_options),
+      file_options_(file_options),
+      column_family_id_(column_family_id),
+      io_priority_(io_priority),
+      write_hint_(write_hint),
+      blob_file_additions_(blob_file_additions),
+      blob_count_(0),
+      blob_bytes_(0) {
+  assert(file_number_generator_);
+  assert(env_);
+  assert(fs_);
+  assert(immutable_cf_options_);
+  assert(!immutable_cf_options_->cf_paths.empty());
+  assert(file_options_);
+  assert(blob_file_additions_);
+}
+
+BlobFileBuilder::~BlobFileBuilder() = default;
+
+Status BlobFileBuilder::Add(const Slice& key, const Slice& value,
+                            std::string* blob_index) {
+  assert(blob_index);
+  assert(blob_index->empty());
+
+  if (value.size() < immutable_cf_options_->min_blob_size) {
+    return Status::OK();
+  }
+
+  {
+    const Status s = OpenBlobFileIfNeeded();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  Slice blob = value;
+  std::string compressed_blob;
+  CompressionType compression_type = kNoCompression;
+  CompressBlobIfNeeded(&blob, &compressed_blob, &compression_type);
+
+  uint64_t blob_file_number = 0;
+  uint64_t blob_offset = 0;
+
+  {
+    const Status s =
+        WriteBlobToFile(key, blob, &blob_file_number, &blob_offset);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  {
+    const Status s = CloseBlobFileIfNeeded();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  BlobIndex::EncodeBlob(blob_index, blob_file_number, blob_offset, blob.size(),
+                        compression_type);
+
+  return Status::OK();
+}
+
+Status BlobFileBuilder::Finish() {
+  if (!IsBlobFileOpen()) {
+    return Status::OK();
+  }
+
+  return CloseBlobFile();
+}
+
+void BlobFileBuilder::Abandon() {
+  if (!IsBlobFileOpen()) {
+    return;
+  }
+
+  const std::string blob_file_path = writer_->file()->file_name();
+
+  writer_.reset();
+  blob_count_ = 0;
+  blob_bytes_ = 0;
+
+  fs_->DeleteFile(blob_file_path, IOOptions(), nullptr);
+}
+
+bool BlobFileBuilder::IsBlobFileOpen() const { return !!writer_; }
+
+Status BlobFileBuilder::OpenBlobFileIfNeeded() {
+  if (IsBlobFileOpen()) {
+    return Status::OK();
+  }
+
+  assert(!blob_count_);
+  assert(!blob_bytes_);
+
+  const uint64_t blob_file_number = file_number_generator_();
+  const std::string blob_file_path = BlobFileName(
+      immutable_cf_options_->cf_paths.front().path, blob_file_number);
+
+  std::unique_ptr<FSWritableFile> file;
+
+  {
+    TEST_SYNC_POINT("BlobFileBuilder::OpenBlobFileIfNeeded:NewWritableFile");
+    const Status s =
+        NewWritableFile(fs_, blob_file_path, &file, *file_options_);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  assert(file);
+  file->SetIOPriority(io_priority_);
+  file->SetWriteLifeTimeHint(write_hint_);
+
+  Statistics* const statistics = immutable_cf_options_->statistics;
+
+  std::unique_ptr<WritableFileWriter> file_writer(new WritableFileWriter(
+      std::move(file), blob_file_path, *file_options_, env_, statistics,
+      immutable_cf_options_->listeners,
+      immutable_cf_options_->file_checksum_gen_factory));
+
+  std::unique_ptr<blob_db::Writer> blob_log_writer(new blob_db::Writer(
+      std::move(file_writer), env_, statistics, blob_file_number,
+      file_options_->bytes_per_sync, immutable_cf_options_->use_fsync));
+
+  constexpr bool has_ttl = false;
+  const blob_db::ExpirationRange expiration_range;
+
+  blob_db::BlobLogHeader header(column_family_id_,
+                                immutable_cf_options_->blob_compression_type,
+                                has_ttl, expiration_range);
+
+  {
+    const Status s = blob_log_writer->WriteHeader(header);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  writer_ = std::move(blob_log_writer);
+
+  return Status::OK();
+}
+
+void BlobFileBuilder::CompressBlobIfNeeded(
+    Slice* blob, std::string* compressed_blob,
+    CompressionType* compression_type) const {
+  assert(blob);
+  assert(compressed_blob);
+  assert(compressed_blob->empty());
+  assert(compression_type);
+
+  *compression_type = immutable_cf_options_->blob_compression_type;
+  if (*compression_type == kNoCompression) {
+    return;
+  }
+
+  CompressionOptions opts;
+  CompressionContext context(*compression_type);
+  constexpr uint64_t sample_for_compression = 0;
+
+  CompressionInfo info(opts, context, CompressionDict::GetEmptyDict(),
+                       *compression_type, sample_for_compression);
+
+  // CompressBlock() falls back to kNoCompression (and returns the raw value)
+  // if the value does not compress well; the blob index records the actual
+  // type.
+  *blob = CompressBlock(*blob, info, compression_type,
+                        kBlobCompressionFormatVersion, false /* do_sample */,
+                        compressed_blob, nullptr, nullptr);
+}
+
+Status BlobFileBuilder::WriteBlobToFile(const Slice& key, const Slice& blob,
+                                        uint64_t* blob_file_number,
+                                        uint64_t* blob_offset) {
+  assert(IsBlobFileOpen());
+  assert(blob_file_number);
+  assert(blob_offset);
+
+  uint64_t key_offset = 0;
+
+  const Status s =
+      writer_->AddRecord(ExtractUserKey(key), blob, &key_offset, blob_offset);
+  if (!s.ok()) {
+    return s;
+  }
+
+  *blob_file_number = writer_->get_log_number();
+
+  ++blob_count_;
+  blob_bytes_ += blob_db::BlobLogRecord::kHeaderSize +
+                 ExtractUserKey(key).size() + blob.size();
+
+  return Status::OK();
+}
+
+Status BlobFileBuilder::CloseBlobFile() {
+  assert(IsBlobFileOpen());
+
+  blob_db::BlobLogFooter footer;
+  footer.blob_count = blob_count_;
+
+  std::string checksum_method;
+  std::string checksum_value;
+
+  const Status s =
+      writer_->AppendFooter(footer, &checksum_method, &checksum_value);
+  if (!s.ok()) {
+    return s;
+  }
+
+  const uint64_t blob_file_number = writer_->get_log_number();
+
+  assert(blob_file_additions_);
+  blob_file_additions_->emplace_back(blob_file_number, blob_count_,
+                                     blob_bytes_, std::move(checksum_method),
+                                     std::move(checksum_value));
+
+  writer_.reset();
+  blob_count_ = 0;
+  blob_bytes_ = 0;
+
+  return Status::OK();
+}
+
+Status BlobFileBuilder::CloseBlobFileIfNeeded() {
+  assert(IsBlobFileOpen());
+
+  const WritableFileWriter* const file_writer = writer_->file();
+  assert(file_writer);
+
+  if (file_writer->GetFileSize() < immutable_cf_options_->blob_file_size) {
+    return Status::OK();
+  }
+
+  return CloseBlobFile();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,93 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#ifndef ROCKSDB_LITE
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/env.h"
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+enum CompressionType : unsigned char;
+class FileSystem;
+struct FileOptions;
+struct ImmutableCFOptions;
+class BlobFileAddition;
+class Slice;
+class Status;
+
+namespace blob_db {
+class Writer;
+}  // namespace blob_db
+
+// Writes the large values of a flush or compaction output to blob files, and
+// produces the blob references (see BlobIndex) to be stored in the table
+// files in their place. A new blob file is started whenever the current one
+// reaches blob_file_size. Each completed blob file is reported in
+// *blob_file_additions so that it can be added to the MANIFEST in the same
+// VersionEdit as the table files referencing it.
+class BlobFileBuilder {
+ public:
+  BlobFileBuilder(std::function<uint64_t()> file_number_generator, Env* env,
+                  FileSystem* fs,
+                  const ImmutableCFOptions* immutable_cf_options,
+                  const FileOptions* file_options, uint32_t column_family_id,
+                  Env::IOPriority io_priority,
+                  Env::WriteLifeTimeHint write_hint,
+                  std::vector<BlobFileAddition>* blob_file_additions);
+
+  BlobFileBuilder(const BlobFileBuilder&) = delete;
+  BlobFileBuilder& operator=(const BlobFileBuilder&) = delete;
+
+  ~BlobFileBuilder();
+
+  // If the value is at least min_blob_size bytes, appends it to the current
+  // blob file and sets *blob_index to the encoded reference. Otherwise leaves
+  // *blob_index empty, and the value should be stored inline.
+  // REQUIRES: `key` is an internal key.
+  Status Add(const Slice& key, const Slice& value, std::string* blob_index);
+
+  // Completes the current blob file, if any.
+  Status Finish();
+
+  // Abandons and deletes the current blob file, if any. Blob files completed
+  // earlier are reported in *blob_file_additions and must be deleted by the
+  // caller if the job fails.
+  void Abandon();
+
+ private:
+  bool IsBlobFileOpen() const;
+  Status OpenBlobFileIfNeeded();
+  void CompressBlobIfNeeded(Slice* blob, std::string* compressed_blob,
+                            CompressionType* compression_type) const;
+  Status WriteBlobToFile(const Slice& key, const Slice& blob,
+                         uint64_t* blob_file_number, uint64_t* blob_offset);
+  Status CloseBlobFile();
+  Status CloseBlobFileIfNeeded();
+
+  std::function<uint64_t()> file_number_generator_;
+  Env* env_;
+  FileSystem* fs_;
+  const ImmutableCFOptions* immutable_cf_options_;
+  const FileOptions* file_options_;
+  uint32_t column_family_id_;
+  Env::IOPriority io_priority_;
+  Env::WriteLifeTimeHint write_hint_;
+  std::vector<BlobFileAddition>* blob_file_additions_;
+  std::unique_ptr<blob_db::Writer> writer_;
+  uint64_t blob_count_;
+  uint64_t blob_bytes_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,118 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/blob/blob_file_cache.h"
+
+#include <cassert>
+#include <memory>
+
+#include "db/blob/blob_file_reader.h"
+#include "monitoring/statistics.h"
+#include "options/cf_options.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "test_util/sync_point.h"
+#include "util/hash.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+#ifndef ROCKSDB_LITE
+void DeleteBlobFileReader(const Slice& /*key*/, void* value) {
+  delete reinterpret_cast<BlobFileReader*>(value);
+}
+#endif  // ROCKSDB_LITE
+
+const size_t kNumberOfMutexStripes = 128;
+
+}  // namespace
+
+BlobFileCache::BlobFileCache(Cache* cache,
+                             const ImmutableCFOptions* immutable_cf_options,
+                             const FileOptions* file_options,
+                             uint32_t column_family_id,
+                             HistogramImpl* blob_file_read_hist)
+    : cache_(cache),
+      immutable_cf_options_(immutable_cf_options),
+      file_options_(file_options),
+      column_family_id_(column_family_id),
+      blob_file_read_hist_(blob_file_read_hist),
+      mutex_(kNumberOfMutexStripes, GetSliceNPHash64) {
+  assert(cache_);
+  assert(immutable_cf_options_);
+  assert(file_options_);
+}
+
+Status BlobFileCache::GetBlobFileReader(uint64_t blob_file_number,
+                                        Cache::Handle** handle) {
+  assert(handle);
+#ifndef ROCKSDB_LITE
+  const Slice key(reinterpret_cast<const char*>(&blob_file_number),
+                  sizeof(blob_file_number));
+
+  *handle = cache_->Lookup(key);
+  if (*handle != nullptr) {
+    return Status::OK();
+  }
+
+  TEST_SYNC_POINT("BlobFileCache::GetBlobFileReader:DoubleCheck");
+
+  // Check again while holding mutex
+  MutexLock lock(mutex_.get(key));
+
+  *handle = cache_->Lookup(key);
+  if (*handle != nullptr) {
+    return Status::OK();
+  }
+
+  std::unique_ptr<BlobFileReader> reader;
+
+  {
+    assert(file_options_);
+    const Status s = BlobFileReader::Create(
+        *immutable_cf_options_, *file_options_, column_family_id_,
+        blob_file_read_hist_, blob_file_number, &reader);
+    if (!s.ok()) {
+      RecordTick(immutable_cf_options_->statistics, NO_FILE_ERRORS);
+      return s;
+    }
+  }
+
+  {
+    constexpr size_t charge = 1;
+
+    const Status s = cache_->Insert(key, reader.get(), charge,
+                                    &DeleteBlobFileReader, handle);
+    if (!s.ok()) {
+      RecordTick(immutable_cf_options_->statistics, NO_FILE_ERRORS);
+      return s;
+    }
+  }
+
+  reader.release();
+
+  return Status::OK();
+#else   // ROCKSDB_LITE
+  (void)blob_file_number;
+  (void)column_family_id_;
+  (void)blob_file_read_hist_;
+  *handle = nullptr;
+  return Status::NotSupported("Blob files are not supported in LITE mode");
+#endif  // ROCKSDB_LITE
+}
+
+BlobFileReader* BlobFileCache::GetReaderFromHandle(
+    Cache::Handle* handle) const {
+  assert(handle);
+  return reinterpret_cast<BlobFileReader*>(cache_->Value(handle));
+}
+
+void BlobFileCache::ReleaseHandle(Cache::Handle* handle) {
+  assert(handle);
+  cache_->Release(handle);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
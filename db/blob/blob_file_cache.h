@@ -0,0 +1,55 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#include <cinttypes>
+
+#include "rocksdb/cache.h"
+#include "rocksdb/rocksdb_namespace.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct ImmutableCFOptions;
+struct FileOptions;
+class HistogramImpl;
+class Status;
+class BlobFileReader;
+class Slice;
+
+// Caches the open BlobFileReaders of a column family. The readers live in
+// the DB-wide table cache, keyed by file number like the table readers
+// (file numbers are unique across table and blob files), so the number of
+// open files stays bounded by max_open_files, and obsolete blob files are
+// evicted with TableCache::Evict().
+class BlobFileCache {
+ public:
+  BlobFileCache(Cache* cache, const ImmutableCFOptions* immutable_cf_options,
+                const FileOptions* file_options, uint32_t column_family_id,
+                HistogramImpl* blob_file_read_hist);
+
+  BlobFileCache(const BlobFileCache&) = delete;
+  BlobFileCache& operator=(const BlobFileCache&) = delete;
+
+  // Looks up the reader of the given blob file, opening the file on a cache
+  // miss. On success, the returned handle must be released with
+  // ReleaseHandle().
+  Status GetBlobFileReader(uint64_t blob_file_number, Cache::Handle** handle);
+
+  BlobFileReader* GetReaderFromHandle(Cache::Handle* handle) const;
+
+  void ReleaseHandle(Cache::Handle* handle);
+
+ private:
+  Cache* cache_;
+  const ImmutableCFOptions* immutable_cf_options_;
+  const FileOptions* file_options_;
+  uint32_t column_family_id_;
+  HistogramImpl* blob_file_read_hist_;
+  // Ensures that a blob file is opened only once on concurrent misses.
+  Striped<port::Mutex, Slice> mutex_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,291 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#ifndef ROCKSDB_LITE
+
+#include "db/blob/blob_file_reader.h"
+
+#include <cassert>
+#include <string>
+
+#include "db/blob/blob_constants.h"
+#include "db/blob/blob_log_format.h"
+#include "file/filename.h"
+#include "monitoring/statistics.h"
+#include "options/cf_options.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+#include "table/format.h"
+#include "test_util/sync_point.h"
+#include "util/compression.h"
+#include "util/stop_watch.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+Status BlobFileReader::Create(const ImmutableCFOptions& immutable_cf_options,
+                              const FileOptions& file_options,
+                              uint32_t column_family_id,
+                              HistogramImpl* blob_file_read_hist,
+                              uint64_t blob_file_number,
+                              std::unique_ptr<BlobFileReader>* reader) {
+  assert(reader);
+  assert(!immutable_cf_options.cf_paths.empty());
+
+  const std::string blob_file_path = BlobFileName(
+      immutable_cf_options.cf_paths.front().path, blob_file_number);
+
+  FileSystem* const fs = immutable_cf_options.fs;
+  assert(fs);
+
+  uint64_t file_size = 0;
+  Status s = fs->GetFileSize(blob_file_path, IOOptions(), &file_size, nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+
+  if (file_size < blob_db::BlobLogHeader::kSize +
+                      blob_db::BlobLogFooter::kSize) {
+    return Status::Corruption("Malformed blob file");
+  }
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  s = fs->NewRandomAccessFile(blob_file_path, file_options, &file, nullptr);
+  RecordTick(immutable_cf_options.statistics, NO_FILE_OPENS);
+  if (!s.ok()) {
+    return s;
+  }
+
+  assert(file);
+
+  if (immutable_cf_options.advise_random_on_open) {
+    file->Hint(FSRandomAccessFile::kRandom);
+  }
+
+  std::unique_ptr<RandomAccessFileReader> file_reader(
+      new RandomAccessFileReader(
+          std::move(file), blob_file_path, immutable_cf_options.env,
+          immutable_cf_options.statistics, BLOB_DB_BLOB_FILE_READ_MICROS,
+          blob_file_read_hist, immutable_cf_options.rate_limiter,
+          immutable_cf_options.listeners));
+
+  Slice slice;
+  std::string buf;
+  AlignedBuf aligned_buf;
+
+  {
+    TEST_SYNC_POINT("BlobFileReader::Create:ReadHeader");
+    s = ReadFromFile(file_reader.get(), 0, blob_db::BlobLogHeader::kSize,
+                     &slice, &buf, &aligned_buf);
+    if (!s.ok()) {
+      return s;
+    }
+
+    blob_db::BlobLogHeader header;
+    s = header.DecodeFrom(slice);
+    if (!s.ok()) {
+      return s;
+    }
+
+    if (header.has_ttl) {
+      return Status::Corruption("Unexpected TTL blob file");
+    }
+
+    if (header.column_family_id != column_family_id) {
+      return Status::Corruption("Column family ID mismatch");
+    }
+  }
+
+  {
+    TEST_SYNC_POINT("BlobFileReader::Create:ReadFooter");
+    s = ReadFromFile(file_reader.get(),
+                     file_size - blob_db::BlobLogFooter::kSize,
+                     blob_db::BlobLogFooter::kSize, &slice, &buf,
+                     &aligned_buf);
+    if (!s.ok()) {
+      return s;
+    }
+
+    blob_db::BlobLogFooter footer;
+    s = footer.DecodeFrom(slice);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  reader->reset(new BlobFileReader(immutable_cf_options,
+                                   std::move(file_reader), file_size));
+
+  return Status::OK();
+}
+
+BlobFileReader::BlobFileReader(
+    const ImmutableCFOptions& immutable_cf_options,
+    std::unique_ptr<RandomAccessFileReader>&& file_reader, uint64_t file_size)
+    : immutable_cf_options_(immutable_cf_options),
+      file_reader_(std::move(file_reader)),
+      file_size_(file_size) {
+  assert(file_reader_);
+}
+
+BlobFileReader::~BlobFileReader() = default;
+
+Status BlobFileReader::ReadFromFile(const RandomAccessFileReader* file_reader,
+                                    uint64_t read_offset, size_t read_size,
+                                    Slice* slice, std::string* buf,
+                                    AlignedBuf* aligned_buf) {
+  assert(slice);
+  assert(buf);
+  assert(aligned_buf);
+  assert(file_reader);
+
+  Status s;
+
+  if (file_reader->use_direct_io()) {
+    constexpr char* scratch = nullptr;
+
+    s = file_reader->Read(IOOptions(), read_offset, read_size, slice, scratch,
+                          aligned_buf);
+  } else {
+    buf->resize(read_size);
+    constexpr AlignedBuf* aligned_scratch = nullptr;
+
+    s = file_reader->Read(IOOptions(), read_offset, read_size, slice,
+                          &(*buf)[0], aligned_scratch);
+  }
+
+  if (!s.ok()) {
+    return s;
+  }
+
+  if (slice->size() != read_size) {
+    return Status::Corruption("Failed to read data from blob file");
+  }
+
+  return Status::OK();
+}
+
+Status BlobFileReader::GetBlob(const ReadOptions& read_options,
+                               const Slice& user_key, uint64_t offset,
+                               uint64_t value_size,
+                               CompressionType compression_type,
+                               PinnableSlice* value) const {
+  assert(value);
+
+  const uint64_t key_size = user_key.size();
+
+  if (offset < blob_db::BlobLogHeader::kSize +
+                   blob_db::BlobLogRecord::kHeaderSize + key_size ||
+      offset + value_size > file_size_ - blob_db::BlobLogFooter::kSize) {
+    return Status::Corruption("Invalid blob offset");
+  }
+
+  // With checksum verification, we read the whole record (header, key and
+  // value); otherwise, only the value.
+  const uint64_t adjustment =
+      read_options.verify_checksums
+          ? blob_db::BlobLogRecord::kHeaderSize + key_size
+          : 0;
+  assert(offset >= adjustment);
+
+  Slice record_slice;
+  std::string buf;
+  AlignedBuf aligned_buf;
+
+  {
+    TEST_SYNC_POINT("BlobFileReader::GetBlob:ReadFromFile");
+
+    const Status s = ReadFromFile(file_reader_.get(), offset - adjustment,
+                                  static_cast<size_t>(value_size + adjustment),
+                                  &record_slice, &buf, &aligned_buf);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  RecordTick(immutable_cf_options_.statistics, BLOB_DB_BLOB_FILE_BYTES_READ,
+             record_slice.size());
+
+  if (read_options.verify_checksums) {
+    const Status s = VerifyBlob(record_slice, user_key, value_size);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  const Slice value_slice(record_slice.data() + adjustment,
+                          static_cast<size_t>(value_size));
+
+  return UncompressBlobIfNeeded(value_slice, compression_type, value);
+}
+
+Status BlobFileReader::VerifyBlob(const Slice& record_slice,
+                                  const Slice& user_key,
+                                  uint64_t value_size) {
+  blob_db::BlobLogRecord record;
+
+  const Slice header_slice(record_slice.data(),
+                           blob_db::BlobLogRecord::kHeaderSize);
+
+  {
+    const Status s = record.DecodeHeaderFrom(header_slice);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  if (record.key_size != user_key.size()) {
+    return Status::Corruption("Key size mismatch when reading blob");
+  }
+
+  if (record.value_size != value_size) {
+    return Status::Corruption("Value size mismatch when reading blob");
+  }
+
+  record.key = Slice(record_slice.data() + blob_db::BlobLogRecord::kHeaderSize,
+                     record.key_size);
+  if (record.key != user_key) {
+    return Status::Corruption("Key mismatch when reading blob");
+  }
+
+  record.value = Slice(record.key.data() + record.key_size,
+                       static_cast<size_t>(value_size));
+
+  return record.CheckBlobCRC();
+}
+
+Status BlobFileReader::UncompressBlobIfNeeded(const Slice& value_slice,
+                                              CompressionType compression_type,
+                                              PinnableSlice* value) const {
+  if (compression_type == kNoCompression) {
+    value->PinSelf(value_slice);
+    return Status::OK();
+  }
+
+  BlockContents contents;
+
+  {
+    StopWatch stop_watch(immutable_cf_options_.env,
+                         immutable_cf_options_.statistics,
+                         BLOB_DB_DECOMPRESSION_MICROS);
+    UncompressionContext context(compression_type);
+    UncompressionInfo info(context, UncompressionDict::GetEmptyDict(),
+                           compression_type);
+
+    const Status s = UncompressBlockContentsForCompressionType(
+        info, value_slice.data(), value_slice.size(), &contents,
+        kBlobCompressionFormatVersion, immutable_cf_options_);
+    if (!s.ok()) {
+      return Status::Corruption("Unable to uncompress blob");
+    }
+  }
+
+  value->PinSelf(contents.data);
+
+  return Status::OK();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // ROCKSDB_LITE
@@ -0,0 +1,75 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+#pragma once
+
+#ifndef ROCKSDB_LITE
+
+#include <cinttypes>
+#include <memory>
+
+#include "file/random_access_file_reader.h"
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+enum CompressionType : unsigned char;
+struct FileOptions;
+struct ImmutableCFOptions;
+class HistogramImpl;
+struct ReadOptions;
+class Slice;
+class PinnableSlice;
+class Status;
+
+// Reads the blobs of a blob file written by BlobFileBuilder. Instances are
+// immutable after creation and can be shared by concurrent readers; they are
+// cached by BlobFileCache.
+class BlobFileReader {
+ public:
+  // Opens the blob file and verifies its header and footer.
+  static Status Create(const ImmutableCFOptions& immutable_cf_options,
+                       const FileOptions& file_options,
+                       uint32_t column_family_id,
+                       HistogramImpl* blob_file_read_hist,
+                       uint64_t blob_file_number,
+                       std::unique_ptr<BlobFileReader>* reader);
+
+  BlobFileReader(const BlobFileReader&) = delete;
+  BlobFileReader& operator=(const BlobFileReader&) = delete;
+
+  ~BlobFileReader();
+
+  // Reads the blob of `value_size` bytes stored at `offset` for user_key,
+  // and decompresses it if needed. With read_options.verify_checksums, the
+  // whole record is read and its checksums and key are verified as well.
+  Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                 uint64_t offset, uint64_t value_size,
+                 CompressionType compression_type, PinnableSlice* value) const;
+
+ private:
+  BlobFileReader(const ImmutableCFOptions& immutable_cf_options,
+                 std::unique_ptr<RandomAccessFileReader>&& file_reader,
+                 uint64_t file_size);
+
+  static Status ReadFromFile(const RandomAccessFileReader* file_reader,
+                             uint64_t read_offset, size_t read_size,
+                             Slice* slice, std::string* buf,
+                             AlignedBuf* aligned_buf);
+
+  static Status VerifyBlob(const Slice& record_slice, const Slice& user_key,
+                           uint64_t value_size);
+
+  Status UncompressBlobIfNeeded(const Slice& value_slice,
+                                CompressionType compression_type,
+                                PinnableSlice* value) const;
+
+  const ImmutableCFOptions& immutable_cf_options_;
+  std::unique_ptr<RandomAccessFileReader> file_reader_;
+  uint64_t file_size_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+
+#endif  // ROCKSDB_LITE
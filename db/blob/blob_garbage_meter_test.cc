@@ -0,0 +1,155 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/blob/blob_garbage_meter.h"
+
+#include <string>
+#include <vector>
+
+#include "db/blob/blob_index.h"
+#include "db/blob/blob_log_format.h"
+#include "db/dbformat.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+struct BlobReference {
+  std::string user_key;
+  uint64_t blob_file_number;
+  uint64_t offset;
+  uint64_t size;
+
+  uint64_t GetBytes() const {
+    return blob_db::BlobLogRecord::kHeaderSize + user_key.size() + size;
+  }
+
+  void Encode(std::string* key, std::string* value) const {
+    constexpr SequenceNumber seq = 1;
+    *key = InternalKey(user_key, seq, kTypeBlobIndex).Encode().ToString();
+    BlobIndex::EncodeBlob(value, blob_file_number, offset, size,
+                          kNoCompression);
+  }
+};
+
+class BlobGarbageMeterTest : public testing::Test {
+ public:
+  static void ProcessInFlow(BlobGarbageMeter* meter,
+                            const BlobReference& ref) {
+    std::string key;
+    std::string value;
+    ref.Encode(&key, &value);
+    ASSERT_OK(meter->ProcessInFlow(key, value));
+  }
+
+  static void ProcessOutFlow(BlobGarbageMeter* meter,
+                             const BlobReference& ref) {
+    std::string key;
+    std::string value;
+    ref.Encode(&key, &value);
+    ASSERT_OK(meter->ProcessOutFlow(key, value));
+  }
+};
+
+TEST_F(BlobGarbageMeterTest, MeasureGarbage) {
+  BlobGarbageMeter meter;
+
+  const std::vector<BlobReference> blobs{
+      {"key0", 4, 1234, 555}, {"key1", 5, 1234, 666}, {"key2", 6, 1234, 777},
+      {"key3", 4, 2345, 888}, {"key4", 5, 2345, 999}};
+
+  for (const auto& blob : blobs) {
+    ProcessInFlow(&meter, blob);
+  }
+
+  // Blob file #4 loses both of its blobs, #5 one of them, #6 none.
+  ProcessOutFlow(&meter, blobs[1]);
+  ProcessOutFlow(&meter, blobs[2]);
+
+  const auto& flows = meter.flows();
+  ASSERT_EQ(flows.size(), 3);
+
+  {
+    const auto it = flows.find(4);
+    ASSERT_NE(it, flows.end());
+    ASSERT_TRUE(it->second.HasGarbage());
+    ASSERT_EQ(it->second.GetGarbageCount(), 2);
+    ASSERT_EQ(it->second.GetGarbageBytes(),
+              blobs[0].GetBytes() + blobs[3].GetBytes());
+  }
+
+  {
+    const auto it = flows.find(5);
+    ASSERT_NE(it, flows.end());
+    ASSERT_TRUE(it->second.HasGarbage());
+    ASSERT_EQ(it->second.GetGarbageCount(), 1);
+    ASSERT_EQ(it->second.GetGarbageBytes(), blobs[4].GetBytes());
+  }
+
+  {
+    const auto it = flows.find(6);
+    ASSERT_NE(it, flows.end());
+    ASSERT_FALSE(it->second.HasGarbage());
+  }
+}
+
+TEST_F(BlobGarbageMeterTest, IgnoreUnrelatedEntries) {
+  BlobGarbageMeter meter;
+
+  // Plain values are not counted.
+  const std::string value_key =
+      InternalKey("key", 1, kTypeValue).Encode().ToString();
+  ASSERT_OK(meter.ProcessInFlow(value_key, "value"));
+  ASSERT_OK(meter.ProcessOutFlow(value_key, "value"));
+
+  // Neither are references to blob files with no inflow, e.g. to new blob
+  // files written by the compaction.
+  ProcessOutFlow(&meter, {"key", 7, 1234, 100});
+
+  ASSERT_TRUE(meter.flows().empty());
+}
+
+TEST_F(BlobGarbageMeterTest, Merge) {
+  const BlobReference first{"key0", 4, 1234, 555};
+  const BlobReference second{"key1", 4, 2345, 666};
+
+  BlobGarbageMeter meter;
+  ProcessInFlow(&meter, first);
+
+  BlobGarbageMeter other;
+  ProcessInFlow(&other, second);
+  ProcessOutFlow(&other, second);
+
+  meter.Merge(other);
+
+  const auto& flows = meter.flows();
+  ASSERT_EQ(flows.size(), 1);
+
+  const auto& flow = flows.begin()->second;
+  ASSERT_EQ(flow.GetInFlow().GetCount(), 2);
+  ASSERT_EQ(flow.GetOutFlow().GetCount(), 1);
+  ASSERT_EQ(flow.GetGarbageCount(), 1);
+  ASSERT_EQ(flow.GetGarbageBytes(), first.GetBytes());
+}
+
+TEST_F(BlobGarbageMeterTest, CorruptBlobIndex) {
+  BlobGarbageMeter meter;
+
+  const std::string key =
+      InternalKey("key", 1, kTypeBlobIndex).Encode().ToString();
+  ASSERT_TRUE(meter.ProcessInFlow(key, "\xff").IsCorruption());
+
+  std::string inlined;
+  BlobIndex::EncodeInlinedTTL(&inlined, 1000, "value");
+  ASSERT_TRUE(meter.ProcessInFlow(key, inlined).IsCorruption());
+
+  ASSERT_TRUE(meter.ProcessInFlow("bad", "value").IsCorruption());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
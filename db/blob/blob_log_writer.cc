@@ -13,6 +13,7 @@
 #include "file/writable_file_writer.h"
 #include "monitoring/statistics.h"
 #include "rocksdb/env.h"
+#include "rocksdb/file_checksum.h"
 #include "util/coding.h"
 #include "util/stop_watch.h"
 
@@ -56,7 +57,9 @@ Status Writer::WriteHeader(BlobLogHeader& header) {
   return s;
 }
 
-Status Writer::AppendFooter(BlobLogFooter& footer) {
+Status Writer::AppendFooter(BlobLogFooter& footer,
+                            std::string* checksum_method,
+                            std::string* checksum_value) {
   assert(block_offset_ != 0);
   assert(last_elem_type_ == kEtFileHdr || last_elem_type_ == kEtRecord);
 
@@ -66,7 +69,25 @@ Status Writer::AppendFooter(BlobLogFooter& footer) {
   Status s = dest_->Append(Slice(str));
   if (s.ok()) {
     block_offset_ += str.size();
-    s = dest_->Close();
+    s = Sync();
+    if (s.ok()) {
+      s = dest_->Close();
+    }
+    if (s.ok()) {
+      assert(!!checksum_method == !!checksum_value);
+      if (checksum_method != nullptr) {
+        std::string method = dest_->GetFileChecksumFuncName();
+        if (method != kUnknownFileChecksumFuncName) {
+          *checksum_method = std::move(method);
+        }
+      }
+      if (checksum_value != nullptr) {
+        std::string value = dest_->GetFileChecksum();
+        if (value != kUnknownFileChecksum) {
+          *checksum_value = std::move(value);
+        }
+      }
+    }
     dest_.reset();
   }
 
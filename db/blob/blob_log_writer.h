@@ -58,7 +58,12 @@ class Writer {
                             const Slice& val, uint64_t* key_offset,
                             uint64_t* blob_offset);
 
-  Status AppendFooter(BlobLogFooter& footer);
+  // Appends the footer, then syncs and closes the file. If non-null,
+  // checksum_method and checksum_value receive the full file checksum when
+  // a file checksum generator is configured.
+  Status AppendFooter(BlobLogFooter& footer,
+                      std::string* checksum_method = nullptr,
+                      std::string* checksum_value = nullptr);
 
   Status WriteHeader(BlobLogHeader& header);
 
@@ -0,0 +1,453 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "db/blob/blob_log_format.h"
+#include "db/db_test_util.h"
+#include "port/stack_trace.h"
+#include "test_util/sync_point.h"
+#include "util/compression.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class DBBlobBasicTest : public DBTestBase {
+ protected:
+  DBBlobBasicTest() : DBTestBase("/db_blob_basic_test") {}
+
+  Options GetBlobOptions() {
+    Options options = CurrentOptions();
+    options.enable_blob_files = true;
+    options.disable_auto_compactions = true;
+    return options;
+  }
+
+  size_t NumBlobFiles() {
+    VersionSet* const versions = dbfull()->TEST_GetVersionSet();
+    assert(versions);
+    ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+    assert(cfd);
+    Version* const current = cfd->current();
+    assert(current);
+    return current->storage_info()->GetBlobFiles().size();
+  }
+
+  std::vector<uint64_t> GetBlobFileNumbers() {
+    VersionSet* const versions = dbfull()->TEST_GetVersionSet();
+    assert(versions);
+    ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+    assert(cfd);
+    Version* const current = cfd->current();
+    assert(current);
+    std::vector<uint64_t> result;
+    for (const auto& pair : current->storage_info()->GetBlobFiles()) {
+      result.push_back(pair.first);
+    }
+    return result;
+  }
+
+  std::shared_ptr<BlobFileMetaData> GetBlobFileMetaData(
+      uint64_t blob_file_number) {
+    VersionSet* const versions = dbfull()->TEST_GetVersionSet();
+    assert(versions);
+    ColumnFamilyData* const cfd = versions->GetColumnFamilySet()->GetDefault();
+    assert(cfd);
+    Version* const current = cfd->current();
+    assert(current);
+    const auto& blob_files = current->storage_info()->GetBlobFiles();
+    const auto it = blob_files.find(blob_file_number);
+    return it == blob_files.end() ? nullptr : it->second;
+  }
+};
+
+#ifndef ROCKSDB_LITE
+
+TEST_F(DBBlobBasicTest, GetBlobFromFlush) {
+  Options options = GetBlobOptions();
+  Reopen(options);
+
+  constexpr char key[] = "key";
+  constexpr char blob_value[] = "blob_value";
+
+  ASSERT_OK(Put(key, blob_value));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), 1);
+
+  ASSERT_EQ(Get(key), blob_value);
+
+  // Reading the value requires I/O, which is not allowed in block cache tier.
+  ReadOptions read_options;
+  read_options.read_tier = kBlockCacheTier;
+
+  PinnableSlice result;
+  ASSERT_TRUE(db_->Get(read_options, db_->DefaultColumnFamily(), key, &result)
+                  .IsIncomplete());
+
+  // The value is still readable after a reopen.
+  Reopen(options);
+  ASSERT_EQ(Get(key), blob_value);
+}
+
+TEST_F(DBBlobBasicTest, MinBlobSize) {
+  Options options = GetBlobOptions();
+  options.min_blob_size = 10;
+  Reopen(options);
+
+  constexpr char small_key[] = "small";
+  constexpr char small_value[] = "short";
+  constexpr char large_key[] = "large";
+  constexpr char large_value[] = "long_enough_to_be_a_blob";
+
+  ASSERT_OK(Put(small_key, small_value));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), 0);
+
+  ASSERT_OK(Put(large_key, large_value));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), 1);
+
+  ASSERT_EQ(Get(small_key), small_value);
+  ASSERT_EQ(Get(large_key), large_value);
+}
+
+TEST_F(DBBlobBasicTest, BlobFileSize) {
+  Options options = GetBlobOptions();
+  options.blob_file_size = 1;
+  Reopen(options);
+
+  // Every blob file holds a single blob.
+  constexpr int num_keys = 4;
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), num_keys);
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), "blob" + ToString(i));
+  }
+}
+
+TEST_F(DBBlobBasicTest, MultiGetBlobs) {
+  Options options = GetBlobOptions();
+  options.min_blob_size = 5;
+  Reopen(options);
+
+  ASSERT_OK(Put("a", "in"));
+  ASSERT_OK(Put("b", "first_blob"));
+  ASSERT_OK(Put("c", "second_blob"));
+  ASSERT_OK(Flush());
+
+  std::array<Slice, 4> keys{{"a", "b", "c", "d"}};
+  std::array<PinnableSlice, 4> values;
+  std::array<Status, 4> statuses;
+
+  db_->MultiGet(ReadOptions(), db_->DefaultColumnFamily(), keys.size(),
+                keys.data(), values.data(), statuses.data());
+
+  ASSERT_OK(statuses[0]);
+  ASSERT_EQ(values[0], "in");
+  ASSERT_OK(statuses[1]);
+  ASSERT_EQ(values[1], "first_blob");
+  ASSERT_OK(statuses[2]);
+  ASSERT_EQ(values[2], "second_blob");
+  ASSERT_TRUE(statuses[3].IsNotFound());
+}
+
+TEST_F(DBBlobBasicTest, IterateBlobs) {
+  Options options = GetBlobOptions();
+  Reopen(options);
+
+  constexpr int num_keys = 10;
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+
+  // Overwrite and delete some of the keys in the memtable.
+  ASSERT_OK(Put(Key(3), "new_value"));
+  ASSERT_OK(Delete(Key(5)));
+
+  auto expected_value = [](int i) {
+    return i == 3 ? std::string("new_value") : "blob" + ToString(i);
+  };
+
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+
+  int i = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+    if (i == 5) {
+      ++i;
+    }
+    ASSERT_EQ(iter->key(), Key(i));
+    ASSERT_EQ(iter->value(), expected_value(i));
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(i, num_keys);
+
+  i = num_keys - 1;
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev(), --i) {
+    if (i == 5) {
+      --i;
+    }
+    ASSERT_EQ(iter->key(), Key(i));
+    ASSERT_EQ(iter->value(), expected_value(i));
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(i, -1);
+}
+
+TEST_F(DBBlobBasicTest, BlobsSurviveCompaction) {
+  Options options = GetBlobOptions();
+  options.min_blob_size = 8;
+  Reopen(options);
+
+  constexpr int num_keys = 20;
+  for (int i = 0; i < num_keys; ++i) {
+    // Only the odd keys have values large enough to be stored in blob files.
+    ASSERT_OK(Put(Key(i), i % 2 ? "blob_value" + ToString(i) : "v"));
+    if (i % 5 == 4) {
+      ASSERT_OK(Flush());
+    }
+  }
+  const size_t num_blob_files = NumBlobFiles();
+  ASSERT_GT(num_blob_files, 0);
+
+  // The blob indexes are copied as they are, so no new blob file is written.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumBlobFiles(), num_blob_files);
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), i % 2 ? "blob_value" + ToString(i) : "v");
+  }
+}
+
+TEST_F(DBBlobBasicTest, CompactionWritesBlobs) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  Reopen(options);
+
+  // Write two overlapping table files so that they cannot be trivially moved.
+  constexpr int num_keys = 10;
+  for (int i = 0; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "value" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  for (int i = 1; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "value" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), 0);
+
+  // Turning on blob files moves the values out of the table files on the
+  // next compaction.
+  options.enable_blob_files = true;
+  Reopen(options);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumBlobFiles(), 1);
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), "value" + ToString(i));
+  }
+}
+
+TEST_F(DBBlobBasicTest, CompressedBlobs) {
+  if (!Snappy_Supported()) {
+    return;
+  }
+
+  Options options = GetBlobOptions();
+  options.blob_compression_type = kSnappyCompression;
+  Reopen(options);
+
+  const std::string compressible_value(1000, 'x');
+  Random rnd(301);
+  const std::string incompressible_value = RandomString(&rnd, 10);
+
+  ASSERT_OK(Put("compressible", compressible_value));
+  ASSERT_OK(Put("incompressible", incompressible_value));
+  ASSERT_OK(Flush());
+
+  ASSERT_EQ(Get("compressible"), compressible_value);
+  ASSERT_EQ(Get("incompressible"), incompressible_value);
+
+  ReadOptions read_options;
+  read_options.verify_checksums = false;
+
+  std::string value;
+  ASSERT_OK(db_->Get(read_options, "compressible", &value));
+  ASSERT_EQ(value, compressible_value);
+}
+
+TEST_F(DBBlobBasicTest, MergeOperatorNotSupported) {
+  Options options = GetBlobOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+
+  ASSERT_TRUE(TryReopen(options).IsNotSupported());
+}
+
+TEST_F(DBBlobBasicTest, CompactionRecordsGarbage) {
+  Options options = GetBlobOptions();
+  Reopen(options);
+
+  ASSERT_OK(Put("a", "first_a"));
+  ASSERT_OK(Put("b", "first_b"));
+  ASSERT_OK(Flush());
+
+  const std::vector<uint64_t> original = GetBlobFileNumbers();
+  ASSERT_EQ(original.size(), 1);
+
+  // Overwriting a turns its first blob into garbage once compacted. (c makes
+  // the two table files overlap so that they are not trivially moved.)
+  ASSERT_OK(Put("a", "second_a"));
+  ASSERT_OK(Put("c", "first_c"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  {
+    const auto meta = GetBlobFileMetaData(original[0]);
+    ASSERT_NE(meta, nullptr);
+    ASSERT_EQ(meta->GetTotalBlobCount(), 2);
+    ASSERT_EQ(meta->GetGarbageBlobCount(), 1);
+    ASSERT_EQ(meta->GetGarbageBlobBytes(),
+              blob_db::BlobLogRecord::kHeaderSize + 1 + strlen("first_a"));
+  }
+
+  // Deleting b makes the whole file garbage, so it is dropped.
+  ASSERT_OK(Delete("b"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  ASSERT_EQ(GetBlobFileMetaData(original[0]), nullptr);
+  ASSERT_EQ(NumBlobFiles(), 1);
+  ASSERT_EQ(Get("a"), "second_a");
+  ASSERT_EQ(Get("b"), "NOT_FOUND");
+  ASSERT_EQ(Get("c"), "first_c");
+}
+
+TEST_F(DBBlobBasicTest, GarbageCollectionRelocatesBlobs) {
+  Options options = GetBlobOptions();
+  Reopen(options);
+
+  constexpr int num_keys = 10;
+  for (int i = 0; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  for (int i = 1; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+
+  const std::vector<uint64_t> original = GetBlobFileNumbers();
+  ASSERT_EQ(original.size(), 2);
+
+  // Only the older half of the blob files is collected.
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 0.5;
+  Reopen(options);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  const std::vector<uint64_t> current = GetBlobFileNumbers();
+  ASSERT_EQ(current.size(), 2);
+  ASSERT_EQ(GetBlobFileMetaData(original[0]), nullptr);
+  ASSERT_NE(GetBlobFileMetaData(original[1]), nullptr);
+  ASSERT_GT(current.back(), original.back());
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), "blob" + ToString(i));
+  }
+}
+
+TEST_F(DBBlobBasicTest, GarbageCollectionInlinesBlobs) {
+  Options options = GetBlobOptions();
+  Reopen(options);
+
+  constexpr int num_keys = 10;
+  for (int i = 0; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  for (int i = 1; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "blob" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumBlobFiles(), 2);
+
+  // With blob files turned off, the collected blobs are moved back into the
+  // table files.
+  options.enable_blob_files = false;
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 1.0;
+  Reopen(options);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumBlobFiles(), 0);
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), "blob" + ToString(i));
+  }
+}
+
+TEST_F(DBBlobBasicTest, GarbageCollectionWithPipelinedCompaction) {
+  Options options = GetBlobOptions();
+  options.enable_pipelined_compaction = true;
+  Reopen(options);
+
+  // Enough keys for the input to span several batches of the pipeline, so
+  // that both threads run at the same time.
+  constexpr int num_keys = 10000;
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_OK(Put(Key(i), "old" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  for (int i = 0; i < num_keys; i += 2) {
+    ASSERT_OK(Put(Key(i), "new" + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+
+  const std::vector<uint64_t> original = GetBlobFileNumbers();
+  ASSERT_EQ(original.size(), 2);
+
+  // The input is read on the pipeline thread while the blobs are counted and
+  // relocated on the compaction thread. The older blob file is all garbage
+  // afterwards, half overwritten and half relocated.
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 0.5;
+  Reopen(options);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  const std::vector<uint64_t> current = GetBlobFileNumbers();
+  ASSERT_EQ(current.size(), 2);
+  ASSERT_EQ(GetBlobFileMetaData(original[0]), nullptr);
+  ASSERT_NE(GetBlobFileMetaData(original[1]), nullptr);
+
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(Get(Key(i)), (i % 2 == 0 ? "new" : "old") + ToString(i));
+  }
+}
+
+TEST_F(DBBlobBasicTest, InvalidGarbageCollectionAgeCutoff) {
+  Options options = GetBlobOptions();
+  options.enable_blob_garbage_collection = true;
+  options.blob_garbage_collection_age_cutoff = 1.5;
+
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+}
+
+#endif  // !ROCKSDB_LITE
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -13,6 +13,8 @@
 #include <deque>
 #include <vector>
 
+#include "db/blob/blob_file_addition.h"
+#include "db/blob/blob_file_builder.h"
 #include "db/compaction/compaction_iterator.h"
 #include "db/dbformat.h"
 #include "db/event_helpers.h"
@@ -21,6 +23,7 @@
 #include "db/range_del_aggregator.h"
 #include "db/table_cache.h"
 #include "db/version_edit.h"
+#include "db/version_set.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
 #include "file/writable_file_writer.h"
@@ -67,13 +70,14 @@ TableBuilder* NewTableBuilder(
 }
 
 Status BuildTable(
-    const std::string& dbname, Env* env, FileSystem* fs,
+    const std::string& dbname, VersionSet* versions, Env* env, FileSystem* fs,
     const ImmutableCFOptions& ioptions,
     const MutableCFOptions& mutable_cf_options, const FileOptions& file_options,
     TableCache* table_cache, InternalIterator* iter,
     std::vector<std::unique_ptr<FragmentedRangeTombstoneIterator>>
         range_del_iters,
-    FileMetaData* meta, const InternalKeyComparator& internal_comparator,
+    FileMetaData* meta, std::vector<BlobFileAddition>* blob_file_additions,
+    const InternalKeyComparator& internal_comparator,
     const std::vector<std::unique_ptr<IntTblPropCollectorFactory>>*
         int_tbl_prop_collector_factories,
     uint32_t column_family_id, const std::string& column_family_name,
@@ -124,7 +128,9 @@ Status BuildTable(
       bool use_direct_writes = file_options.use_direct_writes;
       TEST_SYNC_POINT_CALLBACK("BuildTable:create_file", &use_direct_writes);
 #endif  // !NDEBUG
-      s = NewWritableFile(fs, fname, &file, file_options);
+      FileOptions fo_copy = file_options;
+      fo_copy.temperature = meta->temperature;
+      s = NewWritableFile(fs, fname, &file, fo_copy);
       if (!s.ok()) {
         EventHelpers::LogAndNotifyTableFileCreationFinished(
             event_logger, ioptions.listeners, dbname, column_family_name, fname,
@@ -147,6 +153,19 @@ Status BuildTable(
           0 /*target_file_size*/, file_creation_time, db_id, db_session_id);
     }
 
+    std::unique_ptr<BlobFileBuilder> blob_file_builder;
+#ifndef ROCKSDB_LITE
+    if (ioptions.enable_blob_files && blob_file_additions != nullptr) {
+      assert(versions);
+      blob_file_builder.reset(new BlobFileBuilder(
+          [versions]() { return versions->NewFileNumber(); }, env, fs,
+          &ioptions, &file_options, column_family_id, io_priority, write_hint,
+          blob_file_additions));
+    }
+#else
+    (void)versions;
+#endif  // ROCKSDB_LITE
+
     MergeHelper merge(env, internal_comparator.user_comparator(),
                       ioptions.merge_operator, nullptr, ioptions.info_log,
                       true /* internal key corruption is not ok */,
@@ -159,10 +178,26 @@ Status BuildTable(
         ShouldReportDetailedTime(env, ioptions.statistics),
         true /* internal key corruption is not ok */, range_del_agg.get());
     c_iter.SeekToFirst();
+    std::string blob_index;
     for (; c_iter.Valid(); c_iter.Next()) {
       const Slice& key = c_iter.key();
       const Slice& value = c_iter.value();
       const ParsedInternalKey& ikey = c_iter.ikey();
+      if (blob_file_builder && ikey.type == kTypeValue) {
+        blob_index.clear();
+        s = blob_file_builder->Add(key, value, &blob_index);
+        if (!s.ok()) {
+          break;
+        }
+        if (!blob_index.empty()) {
+          // Store the reference to the blob in place of the value.
+          InternalKey blob_key(ikey.user_key, ikey.sequence, kTypeBlobIndex);
+          builder->Add(blob_key.Encode(), blob_index);
+          meta->UpdateBoundaries(blob_key.Encode(), blob_index, ikey.sequence,
+                                 kTypeBlobIndex);
+          continue;
+        }
+      }
       builder->Add(key, value);
       meta->UpdateBoundaries(key, value, ikey.sequence, ikey.type);
 
@@ -186,7 +221,9 @@ Status BuildTable(
 
     // Finish and check for builder errors
     bool empty = builder->IsEmpty();
-    s = c_iter.status();
+    if (s.ok()) {
+      s = c_iter.status();
+    }
     TEST_SYNC_POINT("BuildTable:BeforeFinishBuildTable");
     if (!s.ok() || empty) {
       builder->Abandon();
@@ -195,6 +232,14 @@ Status BuildTable(
     }
     *io_status = builder->io_status();
 
+    if (blob_file_builder) {
+      if (s.ok() && !empty) {
+        s = blob_file_builder->Finish();
+      } else {
+        blob_file_builder->Abandon();
+      }
+    }
+
     if (s.ok() && !empty) {
       uint64_t file_size = builder->FileSize();
       meta->fd.file_size = file_size;
@@ -262,6 +307,15 @@ Status BuildTable(
 
   if (!s.ok() || meta->fd.GetFileSize() == 0) {
     fs->DeleteFile(fname, IOOptions(), nullptr);
+
+    if (blob_file_additions != nullptr) {
+      for (const BlobFileAddition& blob_file_addition : *blob_file_additions) {
+        fs->DeleteFile(BlobFileName(ioptions.cf_paths.front().path,
+                                    blob_file_addition.GetBlobFileNumber()),
+                       IOOptions(), nullptr);
+      }
+      blob_file_additions->clear();
+    }
   }
 
   if (meta->fd.GetFileSize() == 0) {
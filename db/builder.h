@@ -26,6 +26,7 @@ namespace ROCKSDB_NAMESPACE {
 
 struct Options;
 struct FileMetaData;
+class BlobFileAddition;
 
 class Env;
 struct EnvOptions;
@@ -33,6 +34,7 @@ class Iterator;
 class SnapshotChecker;
 class TableCache;
 class VersionEdit;
+class VersionSet;
 class TableBuilder;
 class WritableFileWriter;
 class InternalStats;
@@ -60,16 +62,21 @@ TableBuilder* NewTableBuilder(
 // If no data is present in *iter, meta->file_size will be set to
 // zero, and no Table file will be produced.
 //
+// If options.enable_blob_files is set and blob_file_additions is not null,
+// large values are written to blob files numbered by `versions`, and the
+// blob files are reported in *blob_file_additions on success.
+//
 // @param column_family_name Name of the column family that is also identified
 //    by column_family_id, or empty string if unknown.
 extern Status BuildTable(
-    const std::string& dbname, Env* env, FileSystem* fs,
+    const std::string& dbname, VersionSet* versions, Env* env, FileSystem* fs,
     const ImmutableCFOptions& options,
     const MutableCFOptions& mutable_cf_options, const FileOptions& file_options,
     TableCache* table_cache, InternalIterator* iter,
     std::vector<std::unique_ptr<FragmentedRangeTombstoneIterator>>
         range_del_iters,
-    FileMetaData* meta, const InternalKeyComparator& internal_comparator,
+    FileMetaData* meta, std::vector<BlobFileAddition>* blob_file_additions,
+    const InternalKeyComparator& internal_comparator,
     const std::vector<std::unique_ptr<IntTblPropCollectorFactory>>*
         int_tbl_prop_collector_factories,
     uint32_t column_family_id, const std::string& column_family_name,
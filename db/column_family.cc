@@ -15,8 +15,10 @@
 #include <string>
 #include <vector>
 
+#include "db/blob/blob_file_cache.h"
 #include "db/compaction/compaction_picker.h"
 #include "db/compaction/compaction_picker_fifo.h"
+#include "db/compaction/compaction_picker_hybrid.h"
 #include "db/compaction/compaction_picker_level.h"
 #include "db/compaction/compaction_picker_universal.h"
 #include "db/db_impl/db_impl.h"
@@ -341,6 +343,22 @@ ColumnFamilyOptions SanitizeOptions(const ImmutableDBOptions& db_options,
     }
   }
 
+  if (result.level_compaction_num_tiered_levels > 1) {
+#ifdef ROCKSDB_LITE
+    result.level_compaction_num_tiered_levels = 0;
+#else
+    if (result.compaction_style != kCompactionStyleLevel ||
+        result.num_levels < 3) {
+      // The tiered levels need at least one leveled level below them.
+      result.level_compaction_num_tiered_levels = 0;
+    } else {
+      result.level_compaction_num_tiered_levels = std::min(
+          result.level_compaction_num_tiered_levels, result.num_levels - 1);
+      result.level_compaction_dynamic_level_bytes = false;
+    }
+#endif  // ROCKSDB_LITE
+  }
+
   if (result.max_compaction_bytes == 0) {
     result.max_compaction_bytes = result.target_file_size_base * 25;
   }
@@ -546,9 +564,22 @@ ColumnFamilyData::ColumnFamilyData(
         new InternalStats(ioptions_.num_levels, db_options.env, this));
     table_cache_.reset(new TableCache(ioptions_, file_options, _table_cache,
                                       block_cache_tracer));
+    blob_file_cache_.reset(
+        new BlobFileCache(_table_cache, ioptions(), &file_options, id_,
+                          nullptr /* blob_file_read_hist */));
     if (ioptions_.compaction_style == kCompactionStyleLevel) {
+#ifndef ROCKSDB_LITE
+      if (ioptions_.level_compaction_num_tiered_levels > 1) {
+        compaction_picker_.reset(
+            new HybridCompactionPicker(ioptions_, &internal_comparator_));
+      } else {
+        compaction_picker_.reset(
+            new LevelCompactionPicker(ioptions_, &internal_comparator_));
+      }
+#else
       compaction_picker_.reset(
           new LevelCompactionPicker(ioptions_, &internal_comparator_));
+#endif  // !ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
     } else if (ioptions_.compaction_style == kCompactionStyleUniversal) {
       compaction_picker_.reset(
@@ -1313,6 +1344,32 @@ Status ColumnFamilyData::ValidateOptions(
           "Block-Based Table format. ");
     }
   }
+
+  if (cf_options.enable_blob_files) {
+#ifdef ROCKSDB_LITE
+    return Status::NotSupported("Blob files are not supported in LITE mode");
+#else
+    if (cf_options.merge_operator) {
+      return Status::NotSupported(
+          "Merge operator is not supported with blob files");
+    }
+    if (cf_options.blob_file_size == 0) {
+      return Status::InvalidArgument("blob_file_size should be positive");
+    }
+    if (!CompressionTypeSupported(cf_options.blob_compression_type)) {
+      return Status::InvalidArgument(
+          "Compression type " +
+          CompressionTypeToString(cf_options.blob_compression_type) +
+          " is not linked with the binary.");
+    }
+#endif  // ROCKSDB_LITE
+  }
+  if (cf_options.blob_garbage_collection_age_cutoff < 0.0 ||
+      cf_options.blob_garbage_collection_age_cutoff > 1.0) {
+    return Status::InvalidArgument(
+        "The age cutoff for blob garbage collection should be in the range "
+        "[0.0, 1.0].");
+  }
   return s;
 }
 
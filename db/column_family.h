@@ -31,6 +31,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Version;
 class VersionSet;
+class BlobFileCache;
 class VersionStorageInfo;
 class MemTable;
 class MemTableListVersion;
@@ -381,6 +382,7 @@ class ColumnFamilyData {
                          SequenceNumber earliest_seq);
 
   TableCache* table_cache() const { return table_cache_.get(); }
+  BlobFileCache* blob_file_cache() const { return blob_file_cache_.get(); }
 
   // See documentation in compaction_picker.h
   // REQUIRES: DB mutex held
@@ -540,6 +542,7 @@ class ColumnFamilyData {
   const bool is_delete_range_supported_;
 
   std::unique_ptr<TableCache> table_cache_;
+  std::unique_ptr<BlobFileCache> blob_file_cache_;
 
   std::unique_ptr<InternalStats> internal_stats_;
 
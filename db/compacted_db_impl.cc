@@ -143,6 +143,10 @@ Status CompactedDBImpl::Open(const Options& options,
   if (options.merge_operator.get() != nullptr) {
     return Status::InvalidArgument("merge operator is not supported");
   }
+  if (options.skip_opening_table_readers_on_db_open) {
+    return Status::InvalidArgument(
+        "require skip_opening_table_readers_on_db_open = false");
+  }
   DBOptions db_options(options);
   std::unique_ptr<CompactedDBImpl> db(new CompactedDBImpl(db_options, dbname));
   Status s = db->Init(options);
@@ -12,7 +12,9 @@
 
 #include "db/column_family.h"
 #include "db/compaction/compaction.h"
+#include "file/filename.h"
 #include "rocksdb/compaction_filter.h"
+#include "rocksdb/sst_partitioner.h"
 #include "test_util/sync_point.h"
 #include "util/string_util.h"
 
@@ -214,7 +216,8 @@ Compaction::Compaction(VersionStorageInfo* vstorage,
                        std::vector<FileMetaData*> _grandparents,
                        bool _manual_compaction, double _score,
                        bool _deletion_compaction,
-                       CompactionReason _compaction_reason)
+                       CompactionReason _compaction_reason,
+                       bool _explicit_output_path)
     : input_vstorage_(vstorage),
       start_level_(_inputs[0].level),
       output_level_(_output_level),
@@ -237,7 +240,9 @@ Compaction::Compaction(VersionStorageInfo* vstorage,
       is_full_compaction_(IsFullCompaction(vstorage, inputs_)),
       is_manual_compaction_(_manual_compaction),
       is_trivial_move_(false),
-      compaction_reason_(_compaction_reason) {
+      compaction_reason_(_compaction_reason),
+      output_temperature_(Temperature::kUnknown),
+      explicit_output_path_(_explicit_output_path) {
   MarkFilesBeingCompacted(true);
   if (is_manual_compaction_) {
     compaction_reason_ = CompactionReason::kManualCompaction;
@@ -251,6 +256,20 @@ Compaction::Compaction(VersionStorageInfo* vstorage,
     output_compression_opts_.max_dict_bytes = 0;
     output_compression_opts_.zstd_max_train_bytes = 0;
   }
+  // Data cools down as it moves to lower levels, and cold data stays cold.
+  if (output_level_ == 0) {
+    output_temperature_ = Temperature::kHot;
+  } else if (bottommost_level_ ||
+             compaction_reason_ == CompactionReason::kChangeTemperature ||
+             IsOutputCold()) {
+    output_temperature_ = Temperature::kCold;
+  } else {
+    output_temperature_ = Temperature::kWarm;
+  }
+  if (!explicit_output_path_) {
+    output_path_id_ = GetPathIdForTemperature(
+        immutable_cf_options_.cf_paths, output_temperature_, output_path_id_);
+  }
 
 #ifndef NDEBUG
   for (size_t i = 1; i < inputs_.size(); ++i) {
@@ -328,7 +347,15 @@ bool Compaction::IsTrivialMove() const {
 
   // assert inputs_.size() == 1
 
+  std::unique_ptr<SstPartitioner> partitioner = CreateSstPartitioner();
+
   for (const auto& file : inputs_.front().files) {
+    if (partitioner != nullptr &&
+        !partitioner->CanDoTrivialMove(file->smallest.user_key(),
+                                       file->largest.user_key())) {
+      return false;
+    }
+
     std::vector<FileMetaData*> file_grand_parents;
     if (output_level_ + 1 >= number_levels_) {
       continue;
@@ -525,6 +552,21 @@ std::unique_ptr<CompactionFilter> Compaction::CreateCompactionFilter() const {
       context);
 }
 
+std::unique_ptr<SstPartitioner> Compaction::CreateSstPartitioner() const {
+  if (!immutable_cf_options_.sst_partitioner_factory) {
+    return nullptr;
+  }
+
+  SstPartitioner::Context context;
+  context.is_full_compaction = is_full_compaction_;
+  context.is_manual_compaction = is_manual_compaction_;
+  context.output_level = output_level_;
+  context.smallest_user_key = smallest_user_key_;
+  context.largest_user_key = largest_user_key_;
+  return immutable_cf_options_.sst_partitioner_factory->CreatePartitioner(
+      context);
+}
+
 bool Compaction::IsOutputLevelEmpty() const {
   return inputs_.back().level != output_level_ || inputs_.back().empty();
 }
@@ -543,6 +585,37 @@ bool Compaction::ShouldFormSubcompactions() const {
   }
 }
 
+bool Compaction::IsOutputCold() const {
+  bool all_inputs_cold = true;
+  for (const auto& level_files : inputs_) {
+    for (const auto& file : level_files.files) {
+      if (file->temperature != Temperature::kCold) {
+        all_inputs_cold = false;
+      }
+    }
+  }
+  if (all_inputs_cold) {
+    return true;
+  }
+
+  // The output would be marked for a temperature change right away
+  // otherwise (see VersionStorageInfo::ComputeFilesMarkedForTemperatureChange).
+  const uint64_t cold_file_age_seconds =
+      mutable_cf_options_.cold_file_age_seconds;
+  if (cold_file_age_seconds == 0) {
+    return false;
+  }
+  int64_t temp_current_time;
+  if (!immutable_cf_options_.env->GetCurrentTime(&temp_current_time).ok()) {
+    return false;
+  }
+  const uint64_t current_time = static_cast<uint64_t>(temp_current_time);
+  const uint64_t oldest_ancester_time = MinInputFileOldestAncesterTime();
+  return cold_file_age_seconds <= current_time &&
+         oldest_ancester_time != port::kMaxUint64 &&
+         oldest_ancester_time < current_time - cold_file_age_seconds;
+}
+
 uint64_t Compaction::MinInputFileOldestAncesterTime() const {
   uint64_t min_oldest_ancester_time = port::kMaxUint64;
   for (const auto& level_files : inputs_) {
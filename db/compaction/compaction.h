@@ -64,6 +64,7 @@ class Version;
 class ColumnFamilyData;
 class VersionStorageInfo;
 class CompactionFilter;
+class SstPartitioner;
 
 // A Compaction encapsulates metadata about a compaction.
 class Compaction {
@@ -78,7 +79,8 @@ class Compaction {
              std::vector<FileMetaData*> grandparents,
              bool manual_compaction = false, double score = -1,
              bool deletion_compaction = false,
-             CompactionReason compaction_reason = CompactionReason::kUnknown);
+             CompactionReason compaction_reason = CompactionReason::kUnknown,
+             bool explicit_output_path = false);
 
   // No copying allowed
   Compaction(const Compaction&) = delete;
@@ -167,6 +169,9 @@ class Compaction {
   // Whether need to write output file to second DB path.
   uint32_t output_path_id() const { return output_path_id_; }
 
+  // The temperature of the files written by the compaction.
+  Temperature output_temperature() const { return output_temperature_; }
+
   // Is this a trivial compaction that can be implemented by just
   // moving a single input file to the next level (no merging or splitting)
   bool IsTrivialMove() const;
@@ -255,6 +260,9 @@ class Compaction {
   // Create a CompactionFilter from compaction_filter_factory
   std::unique_ptr<CompactionFilter> CreateCompactionFilter() const;
 
+  // Create an SstPartitioner from sst_partitioner_factory
+  std::unique_ptr<SstPartitioner> CreateSstPartitioner() const;
+
   // Is the input level corresponding to output_level_ empty?
   bool IsOutputLevelEmpty() const;
 
@@ -318,6 +326,10 @@ class Compaction {
   static bool IsFullCompaction(VersionStorageInfo* vstorage,
                                const std::vector<CompactionInputFiles>& inputs);
 
+  // Returns true if all the inputs are cold, or if the output data is older
+  // than cold_file_age_seconds.
+  bool IsOutputCold() const;
+
   VersionStorageInfo* input_vstorage_;
 
   const int start_level_;    // the lowest level to be compacted
@@ -333,7 +345,7 @@ class Compaction {
   ColumnFamilyData* cfd_;
   Arena arena_;          // Arena used to allocate space for file_levels_
 
-  const uint32_t output_path_id_;
+  uint32_t output_path_id_;
   CompressionType output_compression_;
   CompressionOptions output_compression_opts_;
   // If true, then the comaction can be done by simply deleting input files.
@@ -376,6 +388,14 @@ class Compaction {
 
   // Reason for compaction
   CompactionReason compaction_reason_;
+
+  // Temperature of the output files, derived from the output level, the
+  // compaction reason and the inputs.
+  Temperature output_temperature_;
+
+  // If true, output_path_id_ was chosen by the caller and is kept whatever
+  // the output temperature is.
+  const bool explicit_output_path_;
 };
 
 // Return sum of sizes of all files in `files`.
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <cinttypes>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
 #include <random>
@@ -18,8 +20,15 @@
 #include <utility>
 #include <vector>
 
+#include "db/blob/blob_counting_iterator.h"
+#include "db/blob/blob_file_addition.h"
+#include "db/blob/blob_file_builder.h"
+#include "db/blob/blob_garbage_meter.h"
+#include "db/blob/blob_index.h"
 #include "db/builder.h"
 #include "db/compaction/compaction_job.h"
+#include "db/compaction/deletion_run_converter.h"
+#include "db/compaction/pipelined_input_iterator.h"
 #include "db/db_impl/db_impl.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
@@ -32,6 +41,7 @@
 #include "db/merge_context.h"
 #include "db/merge_helper.h"
 #include "db/range_del_aggregator.h"
+#include "db/table_cache.h"
 #include "db/version_set.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
@@ -45,6 +55,7 @@
 #include "port/port.h"
 #include "rocksdb/db.h"
 #include "rocksdb/env.h"
+#include "rocksdb/sst_partitioner.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
 #include "rocksdb/table.h"
@@ -52,8 +63,10 @@
 #include "table/block_based/block_based_table_factory.h"
 #include "table/merging_iterator.h"
 #include "table/table_builder.h"
+#include "table/table_reader.h"
 #include "test_util/sync_point.h"
 #include "util/coding.h"
+#include "util/defer.h"
 #include "util/mutexlock.h"
 #include "util/random.h"
 #include "util/stop_watch.h"
@@ -95,6 +108,8 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "ExternalSstIngestion";
     case CompactionReason::kPeriodicCompaction:
       return "PeriodicCompaction";
+    case CompactionReason::kChangeTemperature:
+      return "ChangeTemperature";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -125,6 +140,11 @@ struct CompactionJob::SubcompactionState {
 
   // State kept for output being generated
   std::vector<Output> outputs;
+  // Blob files produced by this subcompaction
+  std::vector<BlobFileAddition> blob_file_additions;
+  // Measures the garbage this subcompaction produces in the blob files of the
+  // input version; null if there are no such blob files.
+  std::unique_ptr<BlobGarbageMeter> blob_garbage_meter;
   std::unique_ptr<WritableFileWriter> outfile;
   std::unique_ptr<TableBuilder> builder;
   Output* current_output() {
@@ -154,6 +174,8 @@ struct CompactionJob::SubcompactionState {
   uint64_t overlapped_bytes = 0;
   // A flag determine whether the key has been seen in ShouldStopBefore()
   bool seen_key = false;
+  // The last key added to the current output, for the SST partitioner.
+  std::string last_key_for_partitioner;
 
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
@@ -180,6 +202,8 @@ struct CompactionJob::SubcompactionState {
     end = std::move(o.end);
     status = std::move(o.status);
     outputs = std::move(o.outputs);
+    blob_file_additions = std::move(o.blob_file_additions);
+    blob_garbage_meter = std::move(o.blob_garbage_meter);
     outfile = std::move(o.outfile);
     builder = std::move(o.builder);
     current_output_file_size = std::move(o.current_output_file_size);
@@ -190,6 +214,7 @@ struct CompactionJob::SubcompactionState {
     grandparent_index = std::move(o.grandparent_index);
     overlapped_bytes = std::move(o.overlapped_bytes);
     seen_key = std::move(o.seen_key);
+    last_key_for_partitioner = std::move(o.last_key_for_partitioner);
     return *this;
   }
 
@@ -200,18 +225,24 @@ struct CompactionJob::SubcompactionState {
 
   // Returns true iff we should stop building the current output
   // before processing "internal_key".
-  bool ShouldStopBefore(const Slice& internal_key, uint64_t curr_file_size) {
+  bool ShouldStopBefore(const Slice& internal_key, uint64_t curr_file_size,
+                        SstPartitioner* partitioner) {
     const InternalKeyComparator* icmp =
         &compaction->column_family_data()->internal_comparator();
     const std::vector<FileMetaData*>& grandparents = compaction->grandparents();
 
     // Scan to find earliest grandparent file that contains key.
+    bool crossed_grandparent_boundary = false;
     while (grandparent_index < grandparents.size() &&
            icmp->Compare(internal_key,
                          grandparents[grandparent_index]->largest.Encode()) >
                0) {
       if (seen_key) {
         overlapped_bytes += grandparents[grandparent_index]->fd.GetFileSize();
+        crossed_grandparent_boundary =
+            icmp->user_comparator()->Compare(
+                ExtractUserKey(internal_key),
+                grandparents[grandparent_index]->largest.user_key()) > 0;
       }
       assert(grandparent_index + 1 >= grandparents.size() ||
              icmp->Compare(
@@ -228,6 +259,30 @@ struct CompactionJob::SubcompactionState {
       return true;
     }
 
+    // Once the current output is at least half the target file size, end it
+    // at the end of a grandparent file rather than in the middle of one, so
+    // that the output files line up with the files of the next level. When
+    // they are compacted further, each of them then overlaps fewer files.
+    if (crossed_grandparent_boundary &&
+        curr_file_size >= compaction->max_output_file_size() / 2) {
+      overlapped_bytes = 0;
+      return true;
+    }
+
+    if (partitioner != nullptr && !last_key_for_partitioner.empty()) {
+      const Slice last_user_key = ExtractUserKey(last_key_for_partitioner);
+      const Slice current_user_key = ExtractUserKey(internal_key);
+      // Never split the versions of a user key across files.
+      if (icmp->user_comparator()->Compare(last_user_key, current_user_key) !=
+              0 &&
+          partitioner->ShouldPartition(PartitionerRequest(
+              last_user_key, current_user_key, curr_file_size)) ==
+              kRequired) {
+        overlapped_bytes = 0;
+        return true;
+      }
+    }
+
     return false;
   }
 };
@@ -430,145 +485,108 @@ void CompactionJob::Prepare() {
   }
 }
 
-struct RangeWithSize {
-  Range range;
-  uint64_t size;
-
-  RangeWithSize(const Slice& a, const Slice& b, uint64_t s = 0)
-      : range(a, b), size(s) {}
-};
-
 void CompactionJob::GenSubcompactionBoundaries() {
   auto* c = compact_->compaction;
   auto* cfd = c->column_family_data();
   const Comparator* cfd_comparator = cfd->user_comparator();
-  std::vector<Slice> bounds;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
 
-  // Add the starting and/or ending key of certain input files as a potential
-  // boundary
+  // Sample the key distribution of every input file from its index block.
+  // The anchors split each file into ranges much finer than the file, so
+  // that the work can be balanced even when the input consists of a few
+  // large files covering the same key range, like overlapping L0 files or
+  // the sorted runs of a universal compaction. Files whose table format
+  // cannot provide anchors contribute their endpoints only.
+  std::vector<TableReader::Anchor> anchors;
+  // Obtaining the anchors could potentially create a table reader and read
+  // the index block, so unlock db mutex to reduce contention. The input
+  // version is referenced by the compaction and will not change.
+  db_mutex_->Unlock();
   for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
     int lvl = c->level(lvl_idx);
-    if (lvl >= start_lvl && lvl <= out_lvl) {
-      const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
-      size_t num_files = flevel->num_files;
-
-      if (num_files == 0) {
-        continue;
-      }
-
-      if (lvl == 0) {
-        // For level 0 add the starting and ending key of each file since the
-        // files may have greatly differing key ranges (not range-partitioned)
-        for (size_t i = 0; i < num_files; i++) {
-          bounds.emplace_back(flevel->files[i].smallest_key);
-          bounds.emplace_back(flevel->files[i].largest_key);
-        }
-      } else {
-        // For all other levels add the smallest/largest key in the level to
-        // encompass the range covered by that level
-        bounds.emplace_back(flevel->files[0].smallest_key);
-        bounds.emplace_back(flevel->files[num_files - 1].largest_key);
-        if (lvl == out_lvl) {
-          // For the last level include the starting keys of all files since
-          // the last level is the largest and probably has the widest key
-          // range. Since it's range partitioned, the ending key of one file
-          // and the starting key of the next are very close (or identical).
-          for (size_t i = 1; i < num_files; i++) {
-            bounds.emplace_back(flevel->files[i].smallest_key);
-          }
-        }
+    if (lvl < start_lvl || lvl > out_lvl) {
+      continue;
+    }
+    for (size_t i = 0; i < c->num_input_files(lvl_idx); i++) {
+      const FileMetaData* f = c->input(lvl_idx, i);
+      size_t num_anchors = anchors.size();
+      Status s = cfd->table_cache()->ApproximateKeyAnchors(
+          ReadOptions(), cfd->internal_comparator(), f->fd, &anchors,
+          c->mutable_cf_options()->prefix_extractor.get());
+      if (!s.ok()) {
+        anchors.erase(anchors.begin() + num_anchors, anchors.end());
+        anchors.emplace_back(f->smallest.user_key(), 0);
+        anchors.emplace_back(f->largest.user_key(), f->fd.GetFileSize());
       }
     }
   }
+  db_mutex_->Lock();
 
-  std::sort(bounds.begin(), bounds.end(),
-            [cfd_comparator](const Slice& a, const Slice& b) -> bool {
-              return cfd_comparator->Compare(ExtractUserKey(a),
-                                             ExtractUserKey(b)) < 0;
+  std::sort(anchors.begin(), anchors.end(),
+            [cfd_comparator](const TableReader::Anchor& a,
+                             const TableReader::Anchor& b) -> bool {
+              return cfd_comparator->Compare(a.user_key, b.user_key) < 0;
             });
-  // Remove duplicated entries from bounds
-  bounds.erase(
-      std::unique(bounds.begin(), bounds.end(),
-                  [cfd_comparator](const Slice& a, const Slice& b) -> bool {
-                    return cfd_comparator->Compare(ExtractUserKey(a),
-                                                   ExtractUserKey(b)) == 0;
-                  }),
-      bounds.end());
-
-  // Combine consecutive pairs of boundaries into ranges with an approximate
-  // size of data covered by keys in that range
   uint64_t sum = 0;
-  std::vector<RangeWithSize> ranges;
-  // Get input version from CompactionState since it's already referenced
-  // earlier in SetInputVersioCompaction::SetInputVersion and will not change
-  // when db_mutex_ is released below
-  auto* v = compact_->compaction->input_version();
-  for (auto it = bounds.begin();;) {
-    const Slice a = *it;
-    ++it;
-
-    if (it == bounds.end()) {
-      break;
-    }
-
-    const Slice b = *it;
-
-    // ApproximateSize could potentially create table reader iterator to seek
-    // to the index block and may incur I/O cost in the process. Unlock db
-    // mutex to reduce contention
-    db_mutex_->Unlock();
-    uint64_t size = versions_->ApproximateSize(SizeApproximationOptions(), v, a,
-                                               b, start_lvl, out_lvl + 1,
-                                               TableReaderCaller::kCompaction);
-    db_mutex_->Lock();
-    ranges.emplace_back(a, b, size);
-    sum += size;
+  for (const auto& anchor : anchors) {
+    sum += anchor.range_size;
   }
 
-  // Group the ranges into subcompactions
+  // Group the ranges between anchors into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  int base_level = v->storage_info()->base_level();
+  int base_level = c->input_version()->storage_info()->base_level();
   uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
       sum / min_file_fill_percent /
       MaxFileSizeForLevel(*(c->mutable_cf_options()), out_lvl,
           c->immutable_cf_options()->compaction_style, base_level,
           c->immutable_cf_options()->level_compaction_dynamic_level_bytes)));
   uint64_t subcompactions =
-      std::min({static_cast<uint64_t>(ranges.size()),
+      std::min({static_cast<uint64_t>(anchors.size()),
                 static_cast<uint64_t>(c->max_subcompactions()),
                 max_output_files});
 
   if (subcompactions > 1) {
     double mean = sum * 1.0 / subcompactions;
     // Greedily add ranges to the subcompaction until the sum of the ranges'
-    // sizes becomes >= the expected mean size of a subcompaction
-    sum = 0;
-    for (size_t i = 0; i + 1 < ranges.size(); i++) {
-      sum += ranges[i].size;
-      if (subcompactions == 1) {
-        // If there's only one left to schedule then it goes to the end so no
-        // need to put an end boundary
+    // sizes becomes >= the expected mean size of a subcompaction. A range
+    // ends at its anchor key, which becomes the start of the next
+    // subcompaction.
+    uint64_t accumulated = 0;
+    uint64_t assigned = 0;
+    for (size_t i = 0; i + 1 < anchors.size() && subcompactions > 1; i++) {
+      accumulated += anchors[i].range_size;
+      if (accumulated < mean) {
         continue;
       }
-      if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
-        sizes_.emplace_back(sum);
-        subcompactions--;
-        sum = 0;
+      const std::string& key = anchors[i].user_key;
+      if (!boundary_keys_.empty() &&
+          cfd_comparator->Compare(boundary_keys_.back(), key) == 0) {
+        continue;
       }
+      boundary_keys_.push_back(key);
+      sizes_.emplace_back(accumulated);
+      assigned += accumulated;
+      subcompactions--;
+      accumulated = 0;
     }
-    sizes_.emplace_back(sum + ranges.back().size);
+    // The last subcompaction goes to the end so it needs no end boundary
+    sizes_.emplace_back(sum - assigned);
   } else {
-    // Only one range so its size is the total sum of sizes computed above
+    // Only one subcompaction so its size is the total sum of sizes
     sizes_.emplace_back(sum);
   }
+  for (const auto& key : boundary_keys_) {
+    boundaries_.emplace_back(key);
+  }
+  TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:Sizes",
+                           &sizes_);
 }
 
 Status CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kCompaction);
   TEST_SYNC_POINT("CompactionJob::Run():Start");
   log_buffer_->FlushBufferToLog();
   LogCompaction();
@@ -789,6 +807,15 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
          << compact_->sub_compact_states.size() << "output_compression"
          << CompressionTypeToString(compact_->compaction->output_compression());
 
+  if (compact_->sub_compact_states.size() > 1) {
+    stream << "subcompaction_time_micros";
+    stream.StartArray();
+    for (const auto& sc : compact_->sub_compact_states) {
+      stream << sc.compaction_job_stats.elapsed_micros;
+    }
+    stream.EndArray();
+  }
+
   if (compaction_job_stats_ != nullptr) {
     stream << "num_single_delete_mismatches"
            << compaction_job_stats_->num_single_del_mismatch;
@@ -818,8 +845,17 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
 
 void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   assert(sub_compact != nullptr);
+  // Subcompactions other than the first run on threads of their own.
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kCompaction);
 
+  uint64_t start_micros = env_->NowMicros();
   uint64_t prev_cpu_micros = env_->NowCPUNanos() / 1000;
+  // Recorded on every return, so that each subcompaction has an entry even
+  // if it fails early.
+  Defer record_subcompaction_elapsed_micros([&]() {
+    sub_compact->compaction_job_stats.subcompaction_elapsed_micros.assign(
+        1, env_->NowMicros() - start_micros);
+  });
 
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
@@ -843,10 +879,67 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   CompactionRangeDelAggregator range_del_agg(&cfd->internal_comparator(),
                                              existing_snapshots_);
 
+  // With pipelined compaction, the input is read on another thread, so the
+  // range tombstones of the input files are added to the aggregator upfront
+  // instead of by the input iterator as it opens the files.
+  const bool pipelined = db_options_.enable_pipelined_compaction;
+  if (pipelined) {
+    Status s = versions_->AddInputRangeTombstones(
+        sub_compact->compaction, sub_compact->start, sub_compact->end,
+        &range_del_agg);
+    if (!s.ok()) {
+      sub_compact->status = s;
+      return;
+    }
+  }
+
   // Although the v2 aggregator is what the level iterator(s) know about,
   // the AddTombstones calls will be propagated down to the v1 aggregator.
-  std::unique_ptr<InternalIterator> input(versions_->MakeInputIterator(
-      sub_compact->compaction, &range_del_agg, file_options_for_read_));
+  std::unique_ptr<InternalIterator> raw_input(versions_->MakeInputIterator(
+      sub_compact->compaction, pipelined ? nullptr : &range_del_agg,
+      file_options_for_read_));
+  InternalIterator* input = raw_input.get();
+
+  // If the input version has blob files, count the blobs of the input so that
+  // the garbage produced by the compaction can be recorded in the MANIFEST.
+  Version* const input_version = sub_compact->compaction->input_version();
+  assert(input_version);
+  const auto& input_blob_files = input_version->storage_info()->GetBlobFiles();
+
+  std::unique_ptr<PipelinedInputIterator> pipelined_input;
+  if (pipelined) {
+    pipelined_input.reset(new PipelinedInputIterator(
+        input, cfd->user_comparator(), sub_compact->end));
+    input = pipelined_input.get();
+  }
+
+  // The blobs are counted on this thread, which also records the outflow
+  // of the compaction in the same BlobGarbageMeter.
+  std::unique_ptr<InternalIterator> blob_counting_iter;
+  if (!input_blob_files.empty()) {
+    sub_compact->blob_garbage_meter.reset(new BlobGarbageMeter);
+    blob_counting_iter.reset(new BlobCountingIterator(
+        input, cfd->user_comparator(), sub_compact->end,
+        sub_compact->blob_garbage_meter.get()));
+    input = blob_counting_iter.get();
+  }
+
+  // With blob garbage collection, the blobs of the oldest blob files are
+  // relocated, i.e. those in files numbered below this cutoff.
+  uint64_t blob_gc_cutoff_file_number = kInvalidBlobFileNumber;
+  if (cfd->ioptions()->enable_blob_garbage_collection &&
+      !input_blob_files.empty()) {
+    const size_t cutoff_index = static_cast<size_t>(
+        cfd->ioptions()->blob_garbage_collection_age_cutoff *
+        input_blob_files.size());
+    if (cutoff_index >= input_blob_files.size()) {
+      blob_gc_cutoff_file_number = std::numeric_limits<uint64_t>::max();
+    } else {
+      auto it = input_blob_files.begin();
+      std::advance(it, cutoff_index);
+      blob_gc_cutoff_file_number = it->first;
+    }
+  }
 
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_PROCESS_KV);
@@ -897,33 +990,69 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
 
   Status status;
   sub_compact->c_iter.reset(new CompactionIterator(
-      input.get(), cfd->user_comparator(), &merge, versions_->LastSequence(),
+      input, cfd->user_comparator(), &merge, versions_->LastSequence(),
       &existing_snapshots_, earliest_write_conflict_snapshot_,
       snapshot_checker_, env_, ShouldReportDetailedTime(env_, stats_), false,
       &range_del_agg, sub_compact->compaction, compaction_filter,
       shutting_down_, preserve_deletes_seqnum_, manual_compaction_paused_,
       db_options_.info_log));
   auto c_iter = sub_compact->c_iter.get();
-  c_iter->SeekToFirst();
-  if (c_iter->Valid() && sub_compact->compaction->output_level() != 0) {
+
+  std::unique_ptr<BlobFileBuilder> blob_file_builder;
+#ifndef ROCKSDB_LITE
+  if (cfd->ioptions()->enable_blob_files) {
+    blob_file_builder.reset(new BlobFileBuilder(
+        [this]() { return versions_->NewFileNumber(); }, env_, fs_,
+        cfd->ioptions(), &file_options_, cfd->GetID(), Env::IOPriority::IO_LOW,
+        write_hint_, &sub_compact->blob_file_additions));
+  }
+#endif  // ROCKSDB_LITE
+  std::string blob_index;
+  InternalKey blob_key;
+  PinnableSlice relocated_blob;
+  InternalKey relocated_key;
+
+  std::unique_ptr<SstPartitioner> partitioner =
+      sub_compact->compaction->output_level() == 0
+          ? nullptr
+          : sub_compact->compaction->CreateSstPartitioner();
+
+  // Runs of point deletions are replaced by range tombstones, except where the
+  // deletions are dropped or must be kept as they are.
+  const Compaction* compaction = sub_compact->compaction;
+  size_t deletion_run_threshold =
+      cfd->ioptions()->compaction_deletion_run_threshold;
+  if (compaction->output_level() == 0 || compaction->bottommost_level() ||
+      cfd->ioptions()->allow_ingest_behind ||
+      cfd->ioptions()->preserve_deletes || snapshot_checker_ != nullptr ||
+      cfd->user_comparator()->timestamp_size() > 0) {
+    deletion_run_threshold = 0;
+  }
+  DeletionRunConverter output_iter(
+      c_iter, compaction, &cfd->internal_comparator(), &existing_snapshots_,
+      &range_del_agg, file_options_for_read_, end, deletion_run_threshold);
+
+  output_iter.SeekToFirst();
+  if (output_iter.Valid() && sub_compact->compaction->output_level() != 0) {
     // ShouldStopBefore() maintains state based on keys processed so far. The
     // compaction loop always calls it on the "next" key, thus won't tell it the
     // first key. So we do that here.
-    sub_compact->ShouldStopBefore(c_iter->key(),
-                                  sub_compact->current_output_file_size);
+    sub_compact->ShouldStopBefore(output_iter.key(),
+                                  sub_compact->current_output_file_size,
+                                  partitioner.get());
   }
   const auto& c_iter_stats = c_iter->iter_stats();
 
-  while (status.ok() && !cfd->IsDropped() && c_iter->Valid()) {
-    // Invariant: c_iter.status() is guaranteed to be OK if c_iter->Valid()
-    // returns true.
-    const Slice& key = c_iter->key();
-    const Slice& value = c_iter->value();
+  while (status.ok() && !cfd->IsDropped() && output_iter.Valid()) {
+    // Invariant: output_iter.status() is guaranteed to be OK if
+    // output_iter.Valid() returns true.
+    const Slice& key = output_iter.key();
+    const Slice& value = output_iter.value();
 
     // If an end key (exclusive) is specified, check if the current key is
     // >= than it and exit if it is because the iterator is out of its range
     if (end != nullptr &&
-        cfd->user_comparator()->Compare(c_iter->user_key(), *end) >= 0) {
+        cfd->user_comparator()->Compare(output_iter.user_key(), *end) >= 0) {
       break;
     }
     if (c_iter_stats.num_input_records % kRecordStatsEvery ==
@@ -942,13 +1071,63 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     }
     assert(sub_compact->builder != nullptr);
     assert(sub_compact->current_output() != nullptr);
-    sub_compact->builder->Add(key, value);
+    const ParsedInternalKey& ikey = output_iter.ikey();
+    Slice output_key = key;
+    Slice output_value = value;
+    ValueType output_type = ikey.type;
+    if (ikey.type == kTypeBlobIndex &&
+        blob_gc_cutoff_file_number != kInvalidBlobFileNumber) {
+      BlobIndex old_blob_index;
+      status = old_blob_index.DecodeFrom(value);
+      if (!status.ok()) {
+        break;
+      }
+      if (!old_blob_index.IsInlined() && !old_blob_index.HasTTL() &&
+          old_blob_index.file_number() < blob_gc_cutoff_file_number) {
+        // Read the blob and write it out as a plain value, which is moved to
+        // a new blob file below if blob files are (still) enabled.
+        relocated_blob.Reset();
+        status = input_version->GetBlob(ReadOptions(), ikey.user_key, value,
+                                        &relocated_blob);
+        if (!status.ok()) {
+          break;
+        }
+        relocated_key.Set(ikey.user_key, ikey.sequence, kTypeValue);
+        output_key = relocated_key.Encode();
+        output_value = relocated_blob;
+        output_type = kTypeValue;
+      }
+    }
+    if (blob_file_builder && output_type == kTypeValue) {
+      blob_index.clear();
+      status = blob_file_builder->Add(output_key, output_value, &blob_index);
+      if (!status.ok()) {
+        break;
+      }
+      if (!blob_index.empty()) {
+        // Store the reference to the blob in place of the value.
+        blob_key.Set(ikey.user_key, ikey.sequence, kTypeBlobIndex);
+        output_key = blob_key.Encode();
+        output_value = blob_index;
+        output_type = kTypeBlobIndex;
+      }
+    }
+    if (sub_compact->blob_garbage_meter && output_type == kTypeBlobIndex) {
+      status = sub_compact->blob_garbage_meter->ProcessOutFlow(output_key,
+                                                               output_value);
+      if (!status.ok()) {
+        break;
+      }
+    }
+    sub_compact->builder->Add(output_key, output_value);
     sub_compact->current_output_file_size =
         sub_compact->builder->EstimatedFileSize();
-    const ParsedInternalKey& ikey = c_iter->ikey();
     sub_compact->current_output()->meta.UpdateBoundaries(
-        key, value, ikey.sequence, ikey.type);
+        output_key, output_value, ikey.sequence, output_type);
     sub_compact->num_output_records++;
+    if (partitioner) {
+      sub_compact->last_key_for_partitioner.assign(key.data(), key.size());
+    }
 
     // Close output file if it is big enough. Two possibilities determine it's
     // time to close it: (1) the current key should be this file's last key, (2)
@@ -972,14 +1151,15 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
         "CompactionJob::Run():PausingManualCompaction:2",
         reinterpret_cast<void*>(
             const_cast<std::atomic<bool>*>(manual_compaction_paused_)));
-    c_iter->Next();
-    if (c_iter->status().IsManualCompactionPaused()) {
+    output_iter.Next();
+    if (output_iter.status().IsManualCompactionPaused()) {
       break;
     }
-    if (!output_file_ended && c_iter->Valid() &&
+    if (!output_file_ended && output_iter.Valid() &&
         sub_compact->compaction->output_level() != 0 &&
-        sub_compact->ShouldStopBefore(c_iter->key(),
-                                      sub_compact->current_output_file_size) &&
+        sub_compact->ShouldStopBefore(output_iter.key(),
+                                      sub_compact->current_output_file_size,
+                                      partitioner.get()) &&
         sub_compact->builder != nullptr) {
       // (2) this key belongs to the next file. For historical reasons, the
       // iterator status after advancing will be given to
@@ -989,8 +1169,8 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     }
     if (output_file_ended) {
       const Slice* next_key = nullptr;
-      if (c_iter->Valid()) {
-        next_key = &c_iter->key();
+      if (output_iter.Valid()) {
+        next_key = &output_iter.key();
       }
       CompactionIterationStats range_del_out_stats;
       status =
@@ -1036,7 +1216,7 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     status = input->status();
   }
   if (status.ok()) {
-    status = c_iter->status();
+    status = output_iter.status();
   }
 
   if (status.ok() && sub_compact->builder == nullptr &&
@@ -1057,6 +1237,16 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     RecordDroppedKeys(range_del_out_stats, &sub_compact->compaction_job_stats);
   }
 
+  if (blob_file_builder) {
+    if (status.ok()) {
+      status = blob_file_builder->Finish();
+    } else {
+      blob_file_builder->Abandon();
+    }
+  }
+
+  sub_compact->compaction_job_stats.elapsed_micros =
+      env_->NowMicros() - start_micros;
   sub_compact->compaction_job_stats.cpu_micros =
       env_->NowCPUNanos() / 1000 - prev_cpu_micros;
 
@@ -1079,7 +1269,15 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   }
 
   sub_compact->c_iter.reset();
-  input.reset();
+  blob_counting_iter.reset();
+  if (pipelined_input) {
+    // Account the reads of the input thread to this one, like those of a
+    // non-pipelined compaction.
+    pipelined_input->Stop();
+    IOSTATS_ADD(bytes_read, pipelined_input->GetBytesRead());
+    pipelined_input.reset();
+  }
+  raw_input.reset();
   sub_compact->status = status;
 }
 
@@ -1448,6 +1646,24 @@ Status CompactionJob::InstallCompactionResults(
     for (const auto& out : sub_compact.outputs) {
       compaction->edit()->AddFile(compaction->output_level(), out.meta);
     }
+    for (const auto& blob_file_addition : sub_compact.blob_file_additions) {
+      compaction->edit()->AddBlobFile(blob_file_addition);
+    }
+  }
+
+  // Record the garbage the compaction produced in the existing blob files.
+  BlobGarbageMeter blob_garbage_meter;
+  for (const auto& sub_compact : compact_->sub_compact_states) {
+    if (sub_compact.blob_garbage_meter) {
+      blob_garbage_meter.Merge(*sub_compact.blob_garbage_meter);
+    }
+  }
+  for (const auto& pair : blob_garbage_meter.flows()) {
+    const auto& flow = pair.second;
+    if (flow.HasGarbage()) {
+      compaction->edit()->AddBlobFileGarbage(
+          pair.first, flow.GetGarbageCount(), flow.GetGarbageBytes());
+    }
   }
   return versions_->LogAndApply(compaction->column_family_data(),
                                 mutable_cf_options, compaction->edit(),
@@ -1488,7 +1704,9 @@ Status CompactionJob::OpenCompactionOutputFile(
   TEST_SYNC_POINT_CALLBACK("CompactionJob::OpenCompactionOutputFile",
                            &syncpoint_arg);
 #endif
-  Status s = NewWritableFile(fs_, fname, &writable_file, file_options_);
+  FileOptions fo_copy = file_options_;
+  fo_copy.temperature = sub_compact->compaction->output_temperature();
+  Status s = NewWritableFile(fs_, fname, &writable_file, fo_copy);
   if (!s.ok()) {
     ROCKS_LOG_ERROR(
         db_options_.info_log,
@@ -1527,6 +1745,7 @@ Status CompactionJob::OpenCompactionOutputFile(
                                  sub_compact->compaction->output_path_id(), 0);
     out.meta.oldest_ancester_time = oldest_ancester_time;
     out.meta.file_creation_time = current_time;
+    out.meta.temperature = fo_copy.temperature;
     out.finished = false;
     sub_compact->outputs.push_back(out);
   }
@@ -1538,8 +1757,8 @@ Status CompactionJob::OpenCompactionOutputFile(
   const auto& listeners =
       sub_compact->compaction->immutable_cf_options()->listeners;
   sub_compact->outfile.reset(
-      new WritableFileWriter(std::move(writable_file), fname, file_options_,
-                             env_, db_options_.statistics.get(), listeners,
+      new WritableFileWriter(std::move(writable_file), fname, fo_copy, env_,
+                             db_options_.statistics.get(), listeners,
                              db_options_.file_checksum_gen_factory.get()));
 
   // If the Column family flag is to only optimize filters for hits,
@@ -1631,6 +1850,10 @@ void CompactionJob::UpdateCompactionStats() {
     for (const auto& out : sub_compact.outputs) {
       compaction_stats_.bytes_written += out.meta.fd.file_size;
     }
+    for (const auto& blob_file_addition : sub_compact.blob_file_additions) {
+      compaction_stats_.bytes_written +=
+          blob_file_addition.GetTotalBlobBytes();
+    }
   }
 
   if (compaction_stats_.num_input_records > num_output_records) {
@@ -194,7 +194,9 @@ class CompactionJob {
   bool bottommost_level_;
   bool paranoid_file_checks_;
   bool measure_io_stats_;
-  // Stores the Slices that designate the boundaries for each subcompaction
+  // Stores the user keys that designate the boundaries for each
+  // subcompaction, and Slices pointing to them
+  std::vector<std::string> boundary_keys_;
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
@@ -361,7 +361,9 @@ Compaction* CompactionPicker::CompactFiles(
       mutable_cf_options.max_compaction_bytes, output_path_id, compression_type,
       GetCompressionOptions(mutable_cf_options, vstorage, output_level),
       compact_options.max_subcompactions,
-      /* grandparents */ {}, true);
+      /* grandparents */ {}, /* is manual */ true, /* score */ -1,
+      /* deletion_compaction */ false, CompactionReason::kUnknown,
+      /* explicit_output_path */ true);
   RegisterCompaction(c);
   return c;
 }
@@ -26,6 +26,17 @@ uint64_t GetTotalFilesSize(const std::vector<FileMetaData*>& files) {
   }
   return total_size;
 }
+
+// Returns the creation time recorded in the table properties, or the oldest
+// ancester time from the MANIFEST when the table reader is not open yet
+// (see DBOptions::skip_opening_table_readers_on_db_open). Returns 0 when
+// neither is known.
+uint64_t GetCreationTime(FileMetaData* f) {
+  if (f->fd.table_reader && f->fd.table_reader->GetTableProperties()) {
+    return f->fd.table_reader->GetTableProperties()->creation_time;
+  }
+  return f->oldest_ancester_time;
+}
 }  // anonymous namespace
 
 bool FIFOCompactionPicker::NeedsCompaction(
@@ -72,13 +83,11 @@ Compaction* FIFOCompactionPicker::PickTTLCompaction(
     for (auto ritr = level_files.rbegin(); ritr != level_files.rend(); ++ritr) {
       FileMetaData* f = *ritr;
       assert(f);
-      if (f->fd.table_reader && f->fd.table_reader->GetTableProperties()) {
-        uint64_t creation_time =
-            f->fd.table_reader->GetTableProperties()->creation_time;
-        if (creation_time == 0 ||
-            creation_time >= (current_time - mutable_cf_options.ttl)) {
-          break;
-        }
+      // Files of unknown age are never dropped.
+      uint64_t creation_time = GetCreationTime(f);
+      if (creation_time == 0 ||
+          creation_time >= (current_time - mutable_cf_options.ttl)) {
+        break;
       }
       total_size -= f->compensated_file_size;
       inputs[0].files.push_back(f);
@@ -96,11 +105,8 @@ Compaction* FIFOCompactionPicker::PickTTLCompaction(
   }
 
   for (const auto& f : inputs[0].files) {
-    uint64_t creation_time = 0;
     assert(f);
-    if (f->fd.table_reader && f->fd.table_reader->GetTableProperties()) {
-      creation_time = f->fd.table_reader->GetTableProperties()->creation_time;
-    }
+    uint64_t creation_time = GetCreationTime(f);
     ROCKS_LOG_BUFFER(log_buffer,
                      "[%s] FIFO compaction: picking file %" PRIu64
                      " with creation time %" PRIu64 " for deletion",
@@ -0,0 +1,58 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/compaction_picker_hybrid.h"
+#ifndef ROCKSDB_LITE
+
+#include <string>
+
+#include "db/compaction/compaction_picker_universal.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+Compaction* HybridCompactionPicker::PickCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer,
+    SequenceNumber earliest_memtable_seqno) {
+  const int last_tiered_level =
+      ioptions_.level_compaction_num_tiered_levels - 1;
+  assert(last_tiered_level > 0);
+  assert(last_tiered_level < vstorage->num_levels() - 1);
+
+  // The sorted runs of the tiered levels are scored as L0.
+  double tiered_score = 0;
+  for (int i = 0; i <= vstorage->MaxInputLevel(); i++) {
+    if (vstorage->CompactionScoreLevel(i) == 0) {
+      tiered_score = vstorage->CompactionScore(i);
+      break;
+    }
+  }
+
+  // Scores are sorted in descending order, so merge the sorted runs first if
+  // they are the most urgent, and otherwise only when no leveled compaction
+  // can be picked.
+  Compaction* c = nullptr;
+  if (tiered_score >= 1 && tiered_score >= vstorage->CompactionScore(0)) {
+    c = PickTieredLevelsCompaction(ioptions_, icmp_, cf_name,
+                                   mutable_cf_options, vstorage, this,
+                                   log_buffer, last_tiered_level);
+  }
+  if (c == nullptr) {
+    c = LevelCompactionPicker::PickCompaction(cf_name, mutable_cf_options,
+                                              vstorage, log_buffer,
+                                              earliest_memtable_seqno);
+  }
+  if (c == nullptr && tiered_score >= 1) {
+    c = PickTieredLevelsCompaction(ioptions_, icmp_, cf_name,
+                                   mutable_cf_options, vstorage, this,
+                                   log_buffer, last_tiered_level);
+  }
+  TEST_SYNC_POINT_CALLBACK("HybridCompactionPicker::PickCompaction:Return", c);
+  return c;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
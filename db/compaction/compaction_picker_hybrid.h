@@ -0,0 +1,30 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+#ifndef ROCKSDB_LITE
+
+#include "db/compaction/compaction_picker_level.h"
+
+namespace ROCKSDB_NAMESPACE {
+// Picking compactions for leveled compaction with
+// level_compaction_num_tiered_levels = K > 1. L0 to L(K-1) hold sorted runs
+// that are merged the way universal compaction merges them, using
+// compaction_options_universal, with outputs never going below L(K-1). The
+// files leaving L(K-1) and all deeper levels are compacted exactly like
+// leveled compaction.
+class HybridCompactionPicker : public LevelCompactionPicker {
+ public:
+  HybridCompactionPicker(const ImmutableCFOptions& ioptions,
+                         const InternalKeyComparator* icmp)
+      : LevelCompactionPicker(ioptions, icmp) {}
+  virtual Compaction* PickCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer,
+      SequenceNumber earliest_memtable_seqno = kMaxSequenceNumber) override;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
+#endif  // !ROCKSDB_LITE
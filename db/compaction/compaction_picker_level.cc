@@ -25,6 +25,9 @@ bool LevelCompactionPicker::NeedsCompaction(
   if (!vstorage->FilesMarkedForPeriodicCompaction().empty()) {
     return true;
   }
+  if (!vstorage->FilesMarkedForTemperatureChange().empty()) {
+    return true;
+  }
   if (!vstorage->BottommostFilesMarkedForCompaction().empty()) {
     return true;
   }
@@ -101,6 +104,13 @@ class LevelCompactionBuilder {
       const autovector<std::pair<int, FileMetaData*>>& level_files,
       bool compact_to_next_level);
 
+  // Whether `level` is one of the tiered levels above the last one (see
+  // level_compaction_num_tiered_levels), which are compacted by
+  // HybridCompactionPicker as sorted runs rather than file by file.
+  bool IsUpperTieredLevel(int level) const {
+    return level < ioptions_.level_compaction_num_tiered_levels - 1;
+  }
+
   const std::string& cf_name_;
   VersionStorageInfo* vstorage_;
   SequenceNumber earliest_mem_seqno_;
@@ -137,7 +147,8 @@ void LevelCompactionBuilder::PickFileToCompact(
     // files as being_compacted, but didn't call ComputeCompactionScore()
     assert(!level_file.second->being_compacted);
     start_level_ = level_file.first;
-    if ((compact_to_next_level &&
+    if (IsUpperTieredLevel(start_level_) ||
+        (compact_to_next_level &&
          start_level_ == vstorage_->num_non_empty_levels() - 1) ||
         (start_level_ == 0 &&
          !compaction_picker_->level0_compactions_in_progress()->empty())) {
@@ -167,6 +178,9 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     start_level_ = vstorage_->CompactionScoreLevel(i);
     assert(i == 0 || start_level_score_ <= vstorage_->CompactionScore(i - 1));
     if (start_level_score_ >= 1) {
+      if (IsUpperTieredLevel(start_level_)) {
+        continue;
+      }
       if (skipped_l0_to_base && start_level_ == vstorage_->base_level()) {
         // If L0->base_level compaction is pending, don't schedule further
         // compaction from base level. Otherwise L0->base_level compaction
@@ -220,6 +234,9 @@ void LevelCompactionBuilder::SetupInitialFiles() {
 
   compaction_picker_->PickFilesMarkedForCompaction(
       cf_name_, vstorage_, &start_level_, &output_level_, &start_level_inputs_);
+  if (!start_level_inputs_.empty() && IsUpperTieredLevel(start_level_)) {
+    start_level_inputs_.clear();
+  }
   if (!start_level_inputs_.empty()) {
     compaction_reason_ = CompactionReason::kFilesMarkedForCompaction;
     return;
@@ -245,6 +262,13 @@ void LevelCompactionBuilder::SetupInitialFiles() {
     compaction_reason_ = CompactionReason::kPeriodicCompaction;
     return;
   }
+
+  // Temperature Change Compaction
+  PickFileToCompact(vstorage_->FilesMarkedForTemperatureChange(), false);
+  if (!start_level_inputs_.empty()) {
+    compaction_reason_ = CompactionReason::kChangeTemperature;
+    return;
+  }
 }
 
 bool LevelCompactionBuilder::SetupOtherL0FilesIfNeeded() {
@@ -9,6 +9,7 @@
 #include <utility>
 #include "db/compaction/compaction.h"
 #include "db/compaction/compaction_picker_fifo.h"
+#include "db/compaction/compaction_picker_hybrid.h"
 #include "db/compaction/compaction_picker_level.h"
 #include "db/compaction/compaction_picker_universal.h"
 
@@ -854,6 +855,86 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping4) {
   ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriMaxReadAmp1) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kMaxReadAmpRatio;
+  mutable_cf_options_.max_bytes_for_level_base = 10000000;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 10;
+
+  Add(2, 6U, "150", "167", 60000000U);  // Overlaps with file 26, 27
+  Add(2, 7U, "168", "169", 60000000U);  // Overlaps with file 27
+  Add(2, 8U, "201", "300", 60000000U);  // Overlaps with nothing
+
+  Add(3, 26U, "160", "165", 60000000U);
+  Add(3, 27U, "166", "170", 60000000U);
+  Add(3, 29U, "401", "500", 60000000U);
+  // File 6 is the most expensive to compact, but it is read often enough to
+  // be the hottest per byte rewritten.
+  file_map_[6U].first->stats.num_reads_sampled = 1000;
+  file_map_[7U].first->stats.num_reads_sampled = 100;
+  file_map_[8U].first->stats.num_reads_sampled = 100;
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, CompactionPriMaxReadAmp2) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kMaxReadAmpRatio;
+  mutable_cf_options_.max_bytes_for_level_base = 10000000;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 10;
+
+  Add(2, 6U, "150", "167", 60000000U);  // Overlaps with file 26, 27
+  Add(2, 7U, "168", "169", 60000000U);  // Overlaps with file 27
+  Add(2, 8U, "201", "300", 60000000U);  // Overlaps with nothing
+
+  Add(3, 26U, "160", "165", 60000000U);
+  Add(3, 27U, "166", "170", 60000000U);
+  Add(3, 29U, "401", "500", 60000000U);
+  // Files 6 and 7 are read equally often, and file 7 is cheaper to compact,
+  // but most entries of file 6 are deletions that readers have to skip.
+  for (uint32_t file_number : {6U, 7U}) {
+    FileMetaData* f = file_map_[file_number].first;
+    f->stats.num_reads_sampled = 100;
+    f->num_entries = 1000;
+  }
+  file_map_[6U].first->num_deletions = 600;
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, CompactionPriMaxReadAmpNoReads) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kMaxReadAmpRatio;
+  mutable_cf_options_.max_bytes_for_level_base = 10000000;
+  mutable_cf_options_.max_bytes_for_level_multiplier = 10;
+
+  Add(2, 6U, "150", "167", 60000000U);  // Overlaps with file 26, 27
+  Add(2, 7U, "168", "169", 60000000U);  // Overlaps with file 27
+  Add(2, 8U, "201", "300", 60000000U);  // Overlaps with nothing
+
+  Add(3, 26U, "160", "165", 60000000U);
+  Add(3, 27U, "166", "170", 60000000U);
+  Add(3, 29U, "401", "500", 60000000U);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  // Without any sampled reads, fall back to the smallest overlapping ratio.
+  ASSERT_EQ(8U, compaction->input(0, 0)->fd.GetNumber());
+}
+
 // This test exhibits the bug where we don't properly reset parent_index in
 // PickCompaction()
 TEST_F(CompactionPickerTest, ParentIndexResetBug) {
@@ -1933,6 +2014,86 @@ TEST_F(CompactionPickerTest, UniversalMarkedCompactionStartOutputOverlap) {
     DeleteVersionStorage();
   }
 }
+
+TEST_F(CompactionPickerTest, HybridMergesTieredSortedRuns) {
+  ioptions_.level_compaction_num_tiered_levels = 3;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 3;
+  HybridCompactionPicker hybrid_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Four sorted runs in L0 to L2: more than the trigger, and with a size
+  // amplification of 300%.
+  Add(0, 1U, "a", "m", 1, 0, 401, 410);
+  Add(0, 2U, "c", "z", 1, 0, 301, 310);
+  Add(1, 3U, "a", "z", 1, 0, 201, 210);
+  Add(2, 4U, "a", "z", 1, 0, 101, 110);
+  // The leveled part below is left alone.
+  Add(3, 5U, "a", "z", 1, 0, 1, 10);
+  UpdateVersionStorageInfo();
+
+  ASSERT_TRUE(hybrid_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(
+      hybrid_compaction_picker.PickCompaction(cf_name_, mutable_cf_options_,
+                                              vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kUniversalSizeAmplification,
+            compaction->compaction_reason());
+  ASSERT_EQ(2, compaction->output_level());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(1U, compaction->num_input_files(2));
+  ASSERT_EQ(0U, compaction->num_input_files(3));
+}
+
+TEST_F(CompactionPickerTest, HybridCompactsLastTieredLevelAsLeveled) {
+  ioptions_.level_compaction_num_tiered_levels = 3;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 3;
+  mutable_cf_options_.max_bytes_for_level_base = 100;
+  HybridCompactionPicker hybrid_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(6, kCompactionStyleLevel);
+  Add(0, 1U, "a", "z", 1, 0, 401, 410);
+  // L2 is over its target of max_bytes_for_level_base.
+  Add(2, 2U, "a", "m", 100, 0, 101, 110);
+  Add(2, 3U, "n", "z", 60, 0, 101, 110);
+  Add(3, 4U, "a", "f", 100, 0, 1, 10);
+  Add(3, 5U, "p", "z", 100, 0, 1, 10);
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      hybrid_compaction_picker.PickCompaction(cf_name_, mutable_cf_options_,
+                                              vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction);
+  ASSERT_EQ(CompactionReason::kLevelMaxLevelSize,
+            compaction->compaction_reason());
+  ASSERT_EQ(2, compaction->start_level());
+  ASSERT_EQ(3, compaction->output_level());
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  ASSERT_EQ(2U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(1U, compaction->num_input_files(1));
+  ASSERT_EQ(4U, compaction->input(1, 0)->fd.GetNumber());
+}
+
+TEST_F(CompactionPickerTest, HybridIgnoresSizeOfUpperTieredLevels) {
+  ioptions_.level_compaction_num_tiered_levels = 3;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 3;
+  mutable_cf_options_.max_bytes_for_level_base = 100;
+  HybridCompactionPicker hybrid_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(6, kCompactionStyleLevel);
+  // Two sorted runs, one of them far over max_bytes_for_level_base, but L1
+  // is only compacted as a whole once there are enough sorted runs.
+  Add(0, 1U, "a", "z", 1, 0, 401, 410);
+  Add(1, 2U, "a", "m", 1000, 0, 201, 210);
+  Add(1, 3U, "n", "z", 1000, 0, 201, 210);
+  UpdateVersionStorageInfo();
+
+  ASSERT_FALSE(hybrid_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(
+      hybrid_compaction_picker.PickCompaction(cf_name_, mutable_cf_options_,
+                                              vstorage_.get(), &log_buffer_));
+  ASSERT_FALSE(compaction);
+}
 #endif  // ROCKSDB_LITE
 
 }  // namespace ROCKSDB_NAMESPACE
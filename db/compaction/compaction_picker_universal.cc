@@ -26,25 +26,31 @@
 namespace ROCKSDB_NAMESPACE {
 namespace {
 // A helper class that form universal compactions. The class is used by
-// UniversalCompactionPicker::PickCompaction().
+// UniversalCompactionPicker::PickCompaction() and, for the tiered levels of
+// leveled compaction, by HybridCompactionPicker::PickCompaction().
 // The usage is to create the class, and get the compaction object by calling
 // PickCompaction().
 class UniversalCompactionBuilder {
  public:
+  // Only the sorted runs in L0 to `last_level` are considered, and no
+  // compaction outputs to a level below it.
   UniversalCompactionBuilder(const ImmutableCFOptions& ioptions,
                              const InternalKeyComparator* icmp,
                              const std::string& cf_name,
                              const MutableCFOptions& mutable_cf_options,
                              VersionStorageInfo* vstorage,
-                             UniversalCompactionPicker* picker,
-                             LogBuffer* log_buffer)
+                             CompactionPicker* picker, LogBuffer* log_buffer,
+                             int last_level)
       : ioptions_(ioptions),
         icmp_(icmp),
         cf_name_(cf_name),
         mutable_cf_options_(mutable_cf_options),
         vstorage_(vstorage),
         picker_(picker),
-        log_buffer_(log_buffer) {}
+        log_buffer_(log_buffer),
+        last_level_(last_level) {
+    assert(last_level_ < vstorage_->num_levels());
+  }
 
   // Form and return the compaction object. The caller owns return object.
   Compaction* PickCompaction();
@@ -109,6 +115,12 @@ class UniversalCompactionBuilder {
   // overlapping.
   bool IsInputFilesNonOverlapping(Compaction* c);
 
+  // Whether the sorted runs end above the last level, i.e. this builds the
+  // compactions of the tiered levels of leveled compaction.
+  bool IsTieredLevelsOnly() const {
+    return last_level_ < vstorage_->num_levels() - 1;
+  }
+
   const ImmutableCFOptions& ioptions_;
   const InternalKeyComparator* icmp_;
   double score_;
@@ -116,11 +128,12 @@ class UniversalCompactionBuilder {
   const std::string& cf_name_;
   const MutableCFOptions& mutable_cf_options_;
   VersionStorageInfo* vstorage_;
-  UniversalCompactionPicker* picker_;
+  CompactionPicker* picker_;
   LogBuffer* log_buffer_;
+  const int last_level_;
 
   static std::vector<SortedRun> CalculateSortedRuns(
-      const VersionStorageInfo& vstorage);
+      const VersionStorageInfo& vstorage, int last_level);
 
   // Pick a path ID to place a newly generated file, with its estimated file
   // size.
@@ -281,7 +294,18 @@ Compaction* UniversalCompactionPicker::PickCompaction(
     SequenceNumber /* earliest_memtable_seqno */) {
   UniversalCompactionBuilder builder(ioptions_, icmp_, cf_name,
                                      mutable_cf_options, vstorage, this,
-                                     log_buffer);
+                                     log_buffer, vstorage->num_levels() - 1);
+  return builder.PickCompaction();
+}
+
+Compaction* PickTieredLevelsCompaction(
+    const ImmutableCFOptions& ioptions, const InternalKeyComparator* icmp,
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, CompactionPicker* picker,
+    LogBuffer* log_buffer, int last_tiered_level) {
+  UniversalCompactionBuilder builder(ioptions, icmp, cf_name,
+                                     mutable_cf_options, vstorage, picker,
+                                     log_buffer, last_tiered_level);
   return builder.PickCompaction();
 }
 
@@ -324,13 +348,13 @@ void UniversalCompactionBuilder::SortedRun::DumpSizeInfo(
 
 std::vector<UniversalCompactionBuilder::SortedRun>
 UniversalCompactionBuilder::CalculateSortedRuns(
-    const VersionStorageInfo& vstorage) {
+    const VersionStorageInfo& vstorage, int last_level) {
   std::vector<UniversalCompactionBuilder::SortedRun> ret;
   for (FileMetaData* f : vstorage.LevelFiles(0)) {
     ret.emplace_back(0, f, f->fd.GetFileSize(), f->compensated_file_size,
                      f->being_compacted);
   }
-  for (int level = 1; level < vstorage.num_levels(); level++) {
+  for (int level = 1; level <= last_level; level++) {
     uint64_t total_compensated_size = 0U;
     uint64_t total_size = 0U;
     bool being_compacted = false;
@@ -358,12 +382,25 @@ UniversalCompactionBuilder::CalculateSortedRuns(
 // time-range to compact.
 Compaction* UniversalCompactionBuilder::PickCompaction() {
   const int kLevel0 = 0;
+  // The sorted runs are scored by the L0 score, which is the only score
+  // unless there are leveled levels below the sorted runs.
   score_ = vstorage_->CompactionScore(kLevel0);
-  sorted_runs_ = CalculateSortedRuns(*vstorage_);
+  for (int i = 0; i <= vstorage_->MaxInputLevel(); i++) {
+    if (vstorage_->CompactionScoreLevel(i) == kLevel0) {
+      score_ = vstorage_->CompactionScore(i);
+      break;
+    }
+  }
+  sorted_runs_ = CalculateSortedRuns(*vstorage_, last_level_);
+
+  // Files marked for (periodic) compaction in the tiered levels of leveled
+  // compaction are left to the leveled compactions below them.
+  const bool consider_marked_files = !IsTieredLevelsOnly();
 
   if (sorted_runs_.size() == 0 ||
-      (vstorage_->FilesMarkedForPeriodicCompaction().empty() &&
-       vstorage_->FilesMarkedForCompaction().empty() &&
+      ((!consider_marked_files ||
+        (vstorage_->FilesMarkedForPeriodicCompaction().empty() &&
+         vstorage_->FilesMarkedForCompaction().empty())) &&
        sorted_runs_.size() < (unsigned int)mutable_cf_options_
                                  .level0_file_num_compaction_trigger)) {
     ROCKS_LOG_BUFFER(log_buffer_, "[%s] Universal: nothing to do\n",
@@ -381,7 +418,8 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
   Compaction* c = nullptr;
   // Periodic compaction has higher priority than other type of compaction
   // because it's a hard requirement.
-  if (!vstorage_->FilesMarkedForPeriodicCompaction().empty()) {
+  if (consider_marked_files &&
+      !vstorage_->FilesMarkedForPeriodicCompaction().empty()) {
     // Always need to do a full compaction for periodic compaction.
     c = PickPeriodicCompaction();
   }
@@ -439,7 +477,7 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
     }
   }
 
-  if (c == nullptr) {
+  if (c == nullptr && consider_marked_files) {
     if ((c = PickDeleteTriggeredCompaction()) != nullptr) {
       ROCKS_LOG_BUFFER(log_buffer_,
                        "[%s] Universal: delete triggered compaction\n",
@@ -688,7 +726,7 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
   int start_level = sorted_runs_[start_index].level;
   int output_level;
   if (first_index_after == sorted_runs_.size()) {
-    output_level = vstorage_->num_levels() - 1;
+    output_level = last_level_;
   } else if (sorted_runs_[first_index_after].level == 0) {
     output_level = 0;
   } else {
@@ -733,7 +771,7 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
       vstorage_, ioptions_, mutable_cf_options_, std::move(inputs),
       output_level,
       MaxFileSizeForLevel(mutable_cf_options_, output_level,
-                          kCompactionStyleUniversal),
+                          ioptions_.compaction_style),
       LLONG_MAX, path_id,
       GetCompressionType(ioptions_, vstorage_, mutable_cf_options_, start_level,
                          1, enable_compression),
@@ -1003,9 +1041,10 @@ Compaction* UniversalCompactionBuilder::PickCompactionToOldest(
   }
 
   // output files at the bottom most level, unless it's reserved
-  int output_level = vstorage_->num_levels() - 1;
+  int output_level = last_level_;
   // last level is reserved for the files ingested behind
-  if (ioptions_.allow_ingest_behind) {
+  if (ioptions_.allow_ingest_behind &&
+      output_level == vstorage_->num_levels() - 1) {
     assert(output_level > 1);
     output_level--;
   }
@@ -1017,7 +1056,7 @@ Compaction* UniversalCompactionBuilder::PickCompactionToOldest(
       vstorage_, ioptions_, mutable_cf_options_, std::move(inputs),
       output_level,
       MaxFileSizeForLevel(mutable_cf_options_, output_level,
-                          kCompactionStyleUniversal),
+                          ioptions_.compaction_style),
       LLONG_MAX, path_id,
       GetCompressionType(ioptions_, vstorage_, mutable_cf_options_, start_level,
                          1, true /* enable_compression */),
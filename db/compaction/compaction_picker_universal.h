@@ -27,5 +27,16 @@ class UniversalCompactionPicker : public CompactionPicker {
   virtual bool NeedsCompaction(
       const VersionStorageInfo* vstorage) const override;
 };
+
+// Picks a universal compaction among the sorted runs in L0 to
+// `last_tiered_level` only, i.e. the compaction never reads from nor outputs
+// to a level below `last_tiered_level`. Used by HybridCompactionPicker for the
+// tiered levels of leveled compaction. Returns nullptr if no compaction is
+// needed.
+extern Compaction* PickTieredLevelsCompaction(
+    const ImmutableCFOptions& ioptions, const InternalKeyComparator* icmp,
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, CompactionPicker* picker,
+    LogBuffer* log_buffer, int last_tiered_level);
 }  // namespace ROCKSDB_NAMESPACE
 #endif  // !ROCKSDB_LITE
@@ -0,0 +1,226 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/deletion_run_converter.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "db/column_family.h"
+#include "db/range_tombstone_fragmenter.h"
+#include "db/table_cache.h"
+#include "db/version_set.h"
+#include "table/internal_iterator.h"
+#include "test_util/sync_point.h"
+#include "util/vector_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+DeletionRunConverter::DeletionRunConverter(
+    CompactionIterator* c_iter, const Compaction* compaction,
+    const InternalKeyComparator* icmp,
+    const std::vector<SequenceNumber>* snapshots,
+    CompactionRangeDelAggregator* range_del_agg,
+    const FileOptions& file_options, const Slice* end, size_t min_run_length)
+    : c_iter_(c_iter),
+      compaction_(compaction),
+      icmp_(icmp),
+      snapshots_(snapshots),
+      range_del_agg_(range_del_agg),
+      file_options_(file_options),
+      end_(end),
+      min_run_length_(min_run_length),
+      max_run_bytes_(kMaxRunBytes) {
+  assert(c_iter_ != nullptr);
+  TEST_SYNC_POINT_CALLBACK("DeletionRunConverter::DeletionRunConverter",
+                           &max_run_bytes_);
+}
+
+void DeletionRunConverter::SeekToFirst() {
+  pending_.clear();
+  pos_ = 0;
+  c_iter_->SeekToFirst();
+  CollectRun();
+}
+
+void DeletionRunConverter::Next() {
+  if (pos_ < pending_.size()) {
+    ++pos_;
+    if (pos_ < pending_.size()) {
+      UpdatePending();
+      return;
+    }
+    pending_.clear();
+    pos_ = 0;
+  } else {
+    c_iter_->Next();
+  }
+  CollectRun();
+}
+
+bool DeletionRunConverter::IsRunCandidate() const {
+  if (min_run_length_ < 2 || !c_iter_->Valid() ||
+      c_iter_->ikey().type != kTypeDeletion) {
+    return false;
+  }
+  return end_ == nullptr ||
+         icmp_->user_comparator()->Compare(c_iter_->user_key(), *end_) < 0;
+}
+
+void DeletionRunConverter::CollectRun() {
+  const Comparator* ucmp = icmp_->user_comparator();
+  while (pending_.empty() && IsRunCandidate()) {
+    SequenceNumber min_seq = kMaxSequenceNumber;
+    SequenceNumber max_seq = 0;
+    size_t run_bytes = 0;
+    do {
+      const SequenceNumber seq = c_iter_->ikey().sequence;
+      const SequenceNumber new_min_seq = std::min(min_seq, seq);
+      const SequenceNumber new_max_seq = std::max(max_seq, seq);
+      // A snapshot in [min_seq, max_seq) would see some of the point deletions
+      // but not the range tombstone, so it ends the run.
+      auto snapshot = std::lower_bound(snapshots_->begin(), snapshots_->end(),
+                                       new_min_seq);
+      if (snapshot != snapshots_->end() && *snapshot < new_max_seq) {
+        break;
+      }
+      if (!pending_.empty() &&
+          ucmp->Compare(ExtractUserKey(pending_.back().key),
+                        c_iter_->user_key()) == 0) {
+        break;
+      }
+      min_seq = new_min_seq;
+      max_seq = new_max_seq;
+      pending_.push_back({c_iter_->key().ToString(),
+                          c_iter_->value().ToString()});
+      run_bytes += c_iter_->key().size() + c_iter_->value().size();
+      c_iter_->Next();
+    } while (run_bytes < max_run_bytes_ && IsRunCandidate());
+
+    // The range tombstone covers [k1, kn) of a run k1, ..., kn, and kn keeps
+    // its point deletion, as there is no way to tell the user key after it.
+    if (pending_.size() < std::max<size_t>(min_run_length_, 2)) {
+      break;
+    }
+    const size_t run_length = pending_.size() - 1;
+    const Slice end_user_key = ExtractUserKey(pending_[run_length].key);
+    if (!CanConvert(run_length, end_user_key)) {
+      break;
+    }
+    SequenceNumber seq = 0;
+    for (size_t i = 0; i < run_length; ++i) {
+      seq = std::max(seq, GetInternalKeySeqno(pending_[i].key));
+    }
+    AddRangeTombstone(ExtractUserKey(pending_.front().key), end_user_key, seq);
+    pending_.erase(pending_.begin(), pending_.begin() + run_length);
+  }
+  pos_ = 0;
+  if (!pending_.empty()) {
+    UpdatePending();
+  }
+}
+
+bool DeletionRunConverter::CanConvert(size_t run_length,
+                                      const Slice& end_user_key) const {
+  const VersionStorageInfo* vstorage =
+      compaction_->input_version()->storage_info();
+  const InternalKey begin(ExtractUserKey(pending_.front().key),
+                          kMaxSequenceNumber, kValueTypeForSeek);
+  const InternalKey end(end_user_key, kMaxSequenceNumber, kValueTypeForSeek);
+
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    std::vector<FileMetaData*> files;
+    vstorage->GetOverlappingInputs(level, &begin, &end, &files);
+    for (const FileMetaData* file : files) {
+      bool is_input = false;
+      for (size_t i = 0; i < compaction_->num_input_levels() && !is_input;
+           ++i) {
+        const std::vector<FileMetaData*>& inputs = *compaction_->inputs(i);
+        is_input =
+            std::find(inputs.begin(), inputs.end(), file) != inputs.end();
+      }
+      if (!is_input &&
+          !CheckFile(*file, level, run_length, end_user_key)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool DeletionRunConverter::CheckFile(const FileMetaData& file, int level,
+                                     size_t run_length,
+                                     const Slice& end_user_key) const {
+  ColumnFamilyData* cfd = compaction_->column_family_data();
+  ReadOptions read_options;
+  read_options.verify_checksums = true;
+  read_options.fill_cache = false;
+  std::unique_ptr<InternalIterator> iter(cfd->table_cache()->NewIterator(
+      read_options, file_options_, *icmp_, file, /*range_del_agg=*/nullptr,
+      compaction_->mutable_cf_options()->prefix_extractor.get(),
+      /*table_reader_ptr=*/nullptr, /*file_read_hist=*/nullptr,
+      TableReaderCaller::kCompaction, /*arena=*/nullptr,
+      /*skip_filters=*/false, level, /*max_file_size_for_l0_meta_pin=*/0,
+      /*smallest_compaction_key=*/nullptr,
+      /*largest_compaction_key=*/nullptr,
+      /*allow_unprepared_value=*/false));
+
+  // Every entry in the range must be an older version of a deleted key, which
+  // the point deletion deleted as well.
+  const Comparator* ucmp = icmp_->user_comparator();
+  const InternalKey begin(ExtractUserKey(pending_.front().key),
+                          kMaxSequenceNumber, kValueTypeForSeek);
+  size_t next_deletion = 0;
+  for (iter->Seek(begin.Encode()); iter->Valid(); iter->Next()) {
+    ParsedInternalKey ikey;
+    if (!ParseInternalKey(iter->key(), &ikey)) {
+      return false;
+    }
+    if (ucmp->Compare(ikey.user_key, end_user_key) >= 0) {
+      break;
+    }
+    int cmp = -1;
+    while (next_deletion < run_length &&
+           (cmp = ucmp->Compare(
+                ExtractUserKey(pending_[next_deletion].key), ikey.user_key)) <
+               0) {
+      ++next_deletion;
+    }
+    if (next_deletion == run_length || cmp != 0 ||
+        ikey.sequence >=
+            GetInternalKeySeqno(pending_[next_deletion].key)) {
+      return false;
+    }
+  }
+  return iter->status().ok();
+}
+
+void DeletionRunConverter::AddRangeTombstone(const Slice& start_user_key,
+                                             const Slice& end_user_key,
+                                             SequenceNumber seq) {
+  std::vector<std::string> keys = {
+      InternalKey(start_user_key, seq, kTypeRangeDeletion).Encode().ToString()};
+  std::vector<std::string> values = {end_user_key.ToString()};
+  std::unique_ptr<InternalIterator> tombstone_iter(
+      new VectorIterator(std::move(keys), std::move(values), icmp_));
+  auto tombstones = std::make_shared<FragmentedRangeTombstoneList>(
+      std::move(tombstone_iter), *icmp_);
+  range_del_agg_->AddTombstones(
+      std::unique_ptr<FragmentedRangeTombstoneIterator>(
+          new FragmentedRangeTombstoneIterator(tombstones, *icmp_,
+                                               kMaxSequenceNumber)));
+}
+
+void DeletionRunConverter::UpdatePending() {
+  assert(pos_ < pending_.size());
+  const Deletion& deletion = pending_[pos_];
+  key_ = deletion.key;
+  value_ = deletion.value;
+  bool ok = ParseInternalKey(key_, &ikey_);
+  assert(ok);
+  (void)ok;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,113 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "db/compaction/compaction.h"
+#include "db/compaction/compaction_iterator.h"
+#include "db/dbformat.h"
+#include "db/range_del_aggregator.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Sits on top of the CompactionIterator of a (sub)compaction and replaces
+// runs of at least `min_run_length` consecutive point deletions in its output
+// by a single range tombstone, which is added to the compaction's range
+// deletion aggregator and written out with the output files. Other entries,
+// and the deletions of runs that are too short or cannot be converted safely,
+// are passed through unchanged. A `min_run_length` below 2 disables the
+// conversion.
+//
+// The range tombstone of a run k1, ..., kn covers [k1, kn) at the largest
+// sequence number of the deletions it replaces, and kn keeps its point
+// deletion. It is only used if it deletes nothing the point deletions did
+// not, i.e. if
+// - no snapshot falls between the sequence numbers of the run, and
+// - the files of the input version that are not inputs of the compaction
+//   hold no entry in [k1, kn) other than older versions of the deleted keys.
+// The latter is checked by reading those files, which bounds the work to the
+// data the tombstone deletes.
+//
+// A run is buffered until it ends, so runs are cut at kMaxRunBytes of keys
+// and values. The rest of a longer run starts a new one.
+class DeletionRunConverter {
+ public:
+  DeletionRunConverter(CompactionIterator* c_iter, const Compaction* compaction,
+                       const InternalKeyComparator* icmp,
+                       const std::vector<SequenceNumber>* snapshots,
+                       CompactionRangeDelAggregator* range_del_agg,
+                       const FileOptions& file_options, const Slice* end,
+                       size_t min_run_length);
+
+  static const size_t kMaxRunBytes = 1 << 20;
+
+  void SeekToFirst();
+  void Next();
+
+  bool Valid() const { return pos_ < pending_.size() || c_iter_->Valid(); }
+  const Slice& key() const {
+    return pos_ < pending_.size() ? key_ : c_iter_->key();
+  }
+  const Slice& value() const {
+    return pos_ < pending_.size() ? value_ : c_iter_->value();
+  }
+  const ParsedInternalKey& ikey() const {
+    return pos_ < pending_.size() ? ikey_ : c_iter_->ikey();
+  }
+  const Slice& user_key() const {
+    return pos_ < pending_.size() ? ikey_.user_key : c_iter_->user_key();
+  }
+  // Like for the CompactionIterator, the status is OK whenever Valid() is
+  // true: an error of the CompactionIterator is reported once the entries
+  // buffered before it have been passed through.
+  Status status() const {
+    return pos_ < pending_.size() ? Status::OK() : c_iter_->status();
+  }
+
+ private:
+  struct Deletion {
+    std::string key;
+    std::string value;
+  };
+
+  // Whether the current entry of the CompactionIterator can be part of a run.
+  bool IsRunCandidate() const;
+  // Collects the next run of deletions from the CompactionIterator into
+  // pending_ and converts it if possible. Whatever remains in pending_ is
+  // passed through before the CompactionIterator's current entry.
+  void CollectRun();
+  // Whether the deletions in pending_[0, run_length) may be replaced by a
+  // range tombstone ending at `end_user_key`, the user key of
+  // pending_[run_length].
+  bool CanConvert(size_t run_length, const Slice& end_user_key) const;
+  bool CheckFile(const FileMetaData& file, int level, size_t run_length,
+                 const Slice& end_user_key) const;
+  void AddRangeTombstone(const Slice& start_user_key,
+                         const Slice& end_user_key, SequenceNumber seq);
+  void UpdatePending();
+
+  CompactionIterator* c_iter_;
+  const Compaction* compaction_;
+  const InternalKeyComparator* icmp_;
+  const std::vector<SequenceNumber>* snapshots_;
+  CompactionRangeDelAggregator* range_del_agg_;
+  const FileOptions file_options_;
+  const Slice* end_;
+  const size_t min_run_length_;
+  size_t max_run_bytes_;
+
+  std::vector<Deletion> pending_;
+  size_t pos_ = 0;
+  Slice key_;
+  Slice value_;
+  ParsedInternalKey ikey_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
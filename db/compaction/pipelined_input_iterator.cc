@@ -0,0 +1,197 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/pipelined_input_iterator.h"
+
+#include "db/dbformat.h"
+#include "monitoring/iostats_context_imp.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// The input thread stays at most kNumBatches - 2 batches of kBatchBytes each
+// ahead of the consumer, which holds on to the other two.
+constexpr size_t kNumBatches = 4;
+constexpr size_t kBatchBytes = 64 << 10;
+}  // namespace
+
+PipelinedInputIterator::PipelinedInputIterator(
+    InternalIterator* iter, const Comparator* user_comparator, const Slice* end)
+    : iter_(iter), user_comparator_(user_comparator), end_(end) {
+  assert(iter_);
+  assert(user_comparator_);
+  for (size_t i = 0; i < kNumBatches; ++i) {
+    batches_.emplace_back(new Batch);
+  }
+}
+
+PipelinedInputIterator::~PipelinedInputIterator() { Stop(); }
+
+bool PipelinedInputIterator::Valid() const {
+  return current_ != nullptr && index_ < current_->entries.size();
+}
+
+void PipelinedInputIterator::SeekToFirst() { Start(nullptr); }
+
+void PipelinedInputIterator::SeekToLast() {
+  assert(false);
+  status_ = Status::NotSupported("SeekToLast not supported");
+}
+
+void PipelinedInputIterator::Seek(const Slice& target) { Start(&target); }
+
+void PipelinedInputIterator::SeekForPrev(const Slice& /* target */) {
+  assert(false);
+  status_ = Status::NotSupported("SeekForPrev not supported");
+}
+
+void PipelinedInputIterator::Next() {
+  assert(Valid());
+  ++index_;
+  if (index_ < current_->entries.size()) {
+    return;
+  }
+  if (current_->last) {
+    status_ = current_->status;
+    return;
+  }
+  FetchBatch();
+}
+
+void PipelinedInputIterator::Prev() {
+  assert(false);
+  status_ = Status::NotSupported("Prev not supported");
+}
+
+Slice PipelinedInputIterator::key() const {
+  assert(Valid());
+  const Batch::Entry& entry = current_->entries[index_];
+  return Slice(current_->data.data() + entry.offset, entry.key_size);
+}
+
+Slice PipelinedInputIterator::value() const {
+  assert(Valid());
+  const Batch::Entry& entry = current_->entries[index_];
+  return Slice(current_->data.data() + entry.offset + entry.key_size,
+               entry.value_size);
+}
+
+Status PipelinedInputIterator::status() const { return status_; }
+
+void PipelinedInputIterator::Stop() {
+  if (input_thread_) {
+    stop_.store(true, std::memory_order_relaxed);
+    free_batches_->finish();
+    input_thread_->join();
+    input_thread_.reset();
+  }
+}
+
+void PipelinedInputIterator::Start(const Slice* target) {
+  Stop();
+  if (target != nullptr) {
+    seek_target_.assign(target->data(), target->size());
+  }
+
+  // Keep the current batch alive, as the caller may still hold slices of the
+  // current entry, and hand all the others to the new input thread.
+  if (current_ != nullptr) {
+    previous_ = current_;
+    current_ = nullptr;
+  }
+  index_ = 0;
+  status_ = Status::OK();
+  free_batches_.reset(new WorkQueue<Batch*>());
+  full_batches_.reset(new WorkQueue<Batch*>());
+  for (const auto& batch : batches_) {
+    if (batch.get() != previous_) {
+      free_batches_->push(batch.get());
+    }
+  }
+
+  stop_.store(false, std::memory_order_relaxed);
+  const bool seek_to_first = target == nullptr;
+  input_thread_.reset(new port::Thread(
+      [this, seek_to_first] { BGWorkReadInput(seek_to_first); }));
+  FetchBatch();
+}
+
+void PipelinedInputIterator::FetchBatch() {
+  Batch* batch = nullptr;
+  if (!full_batches_->pop(batch)) {
+    // The input thread only ends without handing over a last batch if it was
+    // stopped.
+    current_ = nullptr;
+    status_ = Status::Aborted("Compaction input thread stopped");
+    return;
+  }
+  if (previous_ != nullptr) {
+    free_batches_->push(previous_);
+  }
+  previous_ = current_;
+  current_ = batch;
+  index_ = 0;
+  if (current_->entries.empty()) {
+    assert(current_->last);
+    status_ = current_->status;
+  }
+}
+
+void PipelinedInputIterator::BGWorkReadInput(bool seek_to_first) {
+  uint64_t prev_bytes_read = IOSTATS(bytes_read);
+  if (seek_to_first) {
+    iter_->SeekToFirst();
+  } else {
+    iter_->Seek(seek_target_);
+  }
+
+  Batch* batch = nullptr;
+  while (!stop_.load(std::memory_order_relaxed) &&
+         free_batches_->pop(batch)) {
+    if (batch->data.capacity() > 4 * kBatchBytes) {
+      // Don't hold on to the memory of a batch with a huge value.
+      std::string().swap(batch->data);
+    }
+    batch->Clear();
+    const bool last = FillBatch(batch);
+
+    const uint64_t bytes_read = IOSTATS(bytes_read);
+    bytes_read_.fetch_add(bytes_read - prev_bytes_read,
+                          std::memory_order_relaxed);
+    prev_bytes_read = bytes_read;
+
+    full_batches_->push(batch);
+    if (last) {
+      break;
+    }
+  }
+  full_batches_->finish();
+}
+
+bool PipelinedInputIterator::FillBatch(Batch* batch) {
+  while (iter_->Valid()) {
+    const Slice key = iter_->key();
+    if (end_ != nullptr && key.size() >= 8 &&
+        user_comparator_->Compare(ExtractUserKey(key), *end_) >= 0) {
+      batch->last = true;
+      return true;
+    }
+    const Slice value = iter_->value();
+    batch->entries.push_back({batch->data.size(), key.size(), value.size()});
+    batch->data.append(key.data(), key.size());
+    batch->data.append(value.data(), value.size());
+
+    iter_->Next();
+    if (batch->data.size() >= kBatchBytes ||
+        stop_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+  }
+  batch->status = iter_->status();
+  batch->last = true;
+  return true;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
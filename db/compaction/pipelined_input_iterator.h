@@ -0,0 +1,109 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/comparator.h"
+#include "rocksdb/status.h"
+#include "table/internal_iterator.h"
+#include "util/work_queue.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// An internal iterator that reads its input iterator on a separate thread, so
+// that the input I/O, block decompression and merging of a compaction run
+// concurrently with the compaction iterator and the table builder consuming
+// it. The input thread copies the key-value pairs into a bounded number of
+// batches, which are handed over to the consumer and recycled once it has
+// moved past them. Keys and values stay valid until the consumer has moved
+// past the batch after theirs, but are not reported as pinned.
+//
+// Entries at or past the (exclusive) user key `end` are not read. Only forward
+// iteration is supported, and Seek() restarts the input thread, so it is meant
+// for the rare seeks of a compaction (e.g. CompactionFilter's
+// kRemoveAndSkipUntil). The input iterator must not be used by anyone else,
+// including adding range tombstones to a range deletion aggregator read by the
+// consumer, while this iterator is alive.
+class PipelinedInputIterator : public InternalIterator {
+ public:
+  PipelinedInputIterator(InternalIterator* iter,
+                         const Comparator* user_comparator, const Slice* end);
+  ~PipelinedInputIterator() override;
+
+  bool Valid() const override;
+  void SeekToFirst() override;
+  void SeekToLast() override;
+  void Seek(const Slice& target) override;
+  void SeekForPrev(const Slice& target) override;
+  void Next() override;
+  void Prev() override;
+  Slice key() const override;
+  Slice value() const override;
+  Status status() const override;
+
+  // Stops the input thread. The iterator is invalid afterwards.
+  void Stop();
+
+  // The number of bytes read from files by the input thread so far.
+  uint64_t GetBytesRead() const {
+    return bytes_read_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Batch {
+    struct Entry {
+      size_t offset;
+      size_t key_size;
+      size_t value_size;
+    };
+
+    void Clear() {
+      data.clear();
+      entries.clear();
+      last = false;
+      status = Status::OK();
+    }
+
+    std::string data;
+    std::vector<Entry> entries;
+    // Whether the input is exhausted (or failed) after this batch.
+    bool last = false;
+    Status status;
+  };
+
+  // Starts the input thread after seeking the input to `target`, or to the
+  // first entry if `target` is nullptr, and waits for the first batch.
+  void Start(const Slice* target);
+  void FetchBatch();
+  void BGWorkReadInput(bool seek_to_first);
+  bool FillBatch(Batch* batch);
+
+  InternalIterator* iter_;
+  const Comparator* user_comparator_;
+  const Slice* end_;
+
+  std::vector<std::unique_ptr<Batch>> batches_;
+  std::unique_ptr<WorkQueue<Batch*>> free_batches_;
+  std::unique_ptr<WorkQueue<Batch*>> full_batches_;
+  std::unique_ptr<port::Thread> input_thread_;
+  std::string seek_target_;
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> bytes_read_{0};
+
+  // The batch being consumed, and the one before it, which is kept alive so
+  // that the slices of the previous entry remain valid.
+  Batch* current_ = nullptr;
+  Batch* previous_ = nullptr;
+  size_t index_ = 0;
+  Status status_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
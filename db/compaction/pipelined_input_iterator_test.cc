@@ -0,0 +1,136 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/pipelined_input_iterator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "table/internal_iterator.h"
+#include "test_util/testharness.h"
+#include "util/vector_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class PipelinedInputIteratorTest : public testing::Test {
+ public:
+  PipelinedInputIteratorTest() : icmp_(BytewiseComparator()) {}
+
+  static std::string UserKey(int i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "key%06d", i);
+    return buf;
+  }
+
+  // Large enough values so that the input spans many batches.
+  static std::string Value(int i) { return std::string(1000, 'a' + i % 26); }
+
+  std::unique_ptr<InternalIterator> NewInput(int num_keys) {
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (int i = 0; i < num_keys; ++i) {
+      keys.push_back(
+          InternalKey(UserKey(i), 100, kTypeValue).Encode().ToString());
+      values.push_back(Value(i));
+    }
+    return std::unique_ptr<InternalIterator>(
+        new VectorIterator(std::move(keys), std::move(values), &icmp_));
+  }
+
+  static void CheckEntry(const InternalIterator& iter, int i) {
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(UserKey(i), ExtractUserKey(iter.key()).ToString());
+    ASSERT_EQ(Value(i), iter.value().ToString());
+  }
+
+  InternalKeyComparator icmp_;
+};
+
+TEST_F(PipelinedInputIteratorTest, ReadAll) {
+  const int kNumKeys = 1000;
+  std::unique_ptr<InternalIterator> input = NewInput(kNumKeys);
+  PipelinedInputIterator iter(input.get(), BytewiseComparator(), nullptr);
+
+  iter.SeekToFirst();
+  for (int i = 0; i < kNumKeys; ++i) {
+    CheckEntry(iter, i);
+    iter.Next();
+  }
+  ASSERT_FALSE(iter.Valid());
+  ASSERT_OK(iter.status());
+}
+
+TEST_F(PipelinedInputIteratorTest, PreviousEntryStaysValid) {
+  const int kNumKeys = 1000;
+  std::unique_ptr<InternalIterator> input = NewInput(kNumKeys);
+  PipelinedInputIterator iter(input.get(), BytewiseComparator(), nullptr);
+
+  iter.SeekToFirst();
+  Slice prev_key = iter.key();
+  Slice prev_value = iter.value();
+  for (int i = 1; i < kNumKeys; ++i) {
+    iter.Next();
+    CheckEntry(iter, i);
+    ASSERT_EQ(UserKey(i - 1), ExtractUserKey(prev_key).ToString());
+    ASSERT_EQ(Value(i - 1), prev_value.ToString());
+    prev_key = iter.key();
+    prev_value = iter.value();
+  }
+}
+
+TEST_F(PipelinedInputIteratorTest, SeekWithEnd) {
+  const int kNumKeys = 1000;
+  std::unique_ptr<InternalIterator> input = NewInput(kNumKeys);
+  const std::string end = UserKey(700);
+  const Slice end_slice(end);
+  PipelinedInputIterator iter(input.get(), BytewiseComparator(), &end_slice);
+
+  iter.Seek(InternalKey(UserKey(200), kMaxSequenceNumber, kValueTypeForSeek)
+                .Encode());
+  for (int i = 200; i < 300; ++i) {
+    CheckEntry(iter, i);
+    iter.Next();
+  }
+
+  // Skip ahead, e.g. for CompactionFilter::Decision::kRemoveAndSkipUntil.
+  iter.Seek(InternalKey(UserKey(600), kMaxSequenceNumber, kValueTypeForSeek)
+                .Encode());
+  for (int i = 600; i < 700; ++i) {
+    CheckEntry(iter, i);
+    iter.Next();
+  }
+  ASSERT_FALSE(iter.Valid());
+  ASSERT_OK(iter.status());
+}
+
+TEST_F(PipelinedInputIteratorTest, StopEarly) {
+  std::unique_ptr<InternalIterator> input = NewInput(10000);
+  {
+    PipelinedInputIterator iter(input.get(), BytewiseComparator(), nullptr);
+    iter.SeekToFirst();
+    CheckEntry(iter, 0);
+    // The destructor stops the input thread, which is blocked on the bounded
+    // number of batches.
+  }
+}
+
+TEST_F(PipelinedInputIteratorTest, InputError) {
+  std::unique_ptr<InternalIterator> input(
+      NewErrorInternalIterator<Slice>(Status::Corruption("bad block")));
+  PipelinedInputIterator iter(input.get(), BytewiseComparator(), nullptr);
+
+  iter.SeekToFirst();
+  ASSERT_FALSE(iter.Valid());
+  ASSERT_TRUE(iter.status().IsCorruption());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
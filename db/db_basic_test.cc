@@ -521,6 +521,67 @@ TEST_F(DBBasicTest, ManifestRollOver) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBBasicTest, ManifestRollOverOnTailSize) {
+  // Remove the minimum size of a tail that causes a roll over, so that a few
+  // flushes are enough.
+  SyncPoint::GetInstance()->SetCallBack(
+      "VersionSet::ProcessManifestWrites:MinTailSize",
+      [](void* arg) { *static_cast<uint64_t*>(arg) = 0; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  for (int tail_size_pct : {0, 100}) {
+    Options options = CurrentOptions();
+    options.disable_auto_compactions = true;
+    options.max_manifest_tail_size_pct = tail_size_pct;
+    DestroyAndReopen(options);
+
+    // The first write after DB::Open starts a new manifest in any case.
+    ASSERT_OK(Put(Key(0), "val0"));
+    ASSERT_OK(Flush());
+
+    // The edits of the next flushes outgrow the snapshot of the single file
+    // so far, so the manifest is rolled over, and a snapshot of the files so
+    // far is written, when the percentage is set.
+    std::set<uint64_t> manifests = {dbfull()->TEST_Current_Manifest_FileNo()};
+    const int kNumFlushes = 20;
+    for (int i = 1; i <= kNumFlushes; ++i) {
+      ASSERT_OK(Put(Key(i), "val" + ToString(i)));
+      ASSERT_OK(Flush());
+      manifests.insert(dbfull()->TEST_Current_Manifest_FileNo());
+    }
+    if (tail_size_pct == 0) {
+      ASSERT_EQ(1, manifests.size());
+    } else {
+      // Each snapshot holds more files than the previous one, so it takes
+      // more flushes to outgrow it.
+      ASSERT_GT(manifests.size(), 2);
+      ASSERT_LT(manifests.size(), kNumFlushes);
+    }
+
+    Reopen(options);
+    ASSERT_EQ(kNumFlushes + 1, NumTableFilesAtLevel(0));
+    for (int i = 0; i <= kNumFlushes; ++i) {
+      ASSERT_EQ("val" + ToString(i), Get(Key(i)));
+    }
+  }
+
+  // With the default minimum, such a small tail does not cause a roll over.
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_manifest_tail_size_pct = 100;
+  DestroyAndReopen(options);
+  ASSERT_OK(Put(Key(0), "val0"));
+  ASSERT_OK(Flush());
+  const uint64_t manifest = dbfull()->TEST_Current_Manifest_FileNo();
+  for (int i = 1; i <= 20; ++i) {
+    ASSERT_OK(Put(Key(i), "val" + ToString(i)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(manifest, dbfull()->TEST_Current_Manifest_FileNo());
+}
+
 TEST_F(DBBasicTest, IdentityAcrossRestarts1) {
   do {
     std::string id1;
@@ -1519,6 +1580,96 @@ TEST_F(DBBasicTest, MultiGetBatchedMultiLevel) {
   }
 }
 
+TEST_F(DBBasicTest, MultiGetBatchedMultiLevelAsyncIO) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions bbto;
+  bbto.filter_policy.reset(NewBloomFilterPolicy(10, false));
+  options.table_factory.reset(NewBlockBasedTableFactory(bbto));
+  Reopen(options);
+  int num_keys = 0;
+
+  // Keys that sort in insertion order keep the flushed files apart, so that
+  // they are trivially moved and each level ends up with several files.
+  for (int i = 0; i < 128; ++i) {
+    ASSERT_OK(Put(Key(i), "val_l2_" + std::to_string(i)));
+    num_keys++;
+    if (num_keys == 8) {
+      Flush();
+      num_keys = 0;
+    }
+  }
+  MoveFilesToLevel(2);
+
+  for (int i = 0; i < 128; i += 3) {
+    ASSERT_OK(Put(Key(i), "val_l1_" + std::to_string(i)));
+    num_keys++;
+    if (num_keys == 8) {
+      Flush();
+      num_keys = 0;
+    }
+  }
+  if (num_keys > 0) {
+    Flush();
+    num_keys = 0;
+  }
+  MoveFilesToLevel(1);
+
+  int num_prefetches = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "BlockBasedTable::MultiGetPrefetch:Prefetch",
+      [&](void* /*arg*/) { num_prefetches++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<std::string> key_strs;
+  std::vector<Slice> keys;
+  for (int i = 40; i < 72; ++i) {
+    key_strs.push_back(Key(i));
+  }
+  for (const auto& key : key_strs) {
+    keys.emplace_back(key);
+  }
+  std::vector<PinnableSlice> values(keys.size());
+  std::vector<Status> statuses(keys.size());
+
+  SetPerfLevel(kEnableCount);
+  get_perf_context()->Reset();
+  ReadOptions ro;
+  ro.async_io = true;
+  db_->MultiGet(ro, dbfull()->DefaultColumnFamily(), keys.size(), keys.data(),
+                values.data(), statuses.data());
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  const uint64_t bloom_sst_hit_count = get_perf_context()->bloom_sst_hit_count;
+  const uint64_t bloom_sst_miss_count =
+      get_perf_context()->bloom_sst_miss_count;
+
+  // The batch spans several files in both L1 and L2
+  ASSERT_GT(num_prefetches, 1);
+
+  // The filter counters are the same as without prefetching
+  {
+    std::vector<PinnableSlice> sync_values(keys.size());
+    std::vector<Status> sync_statuses(keys.size());
+    get_perf_context()->Reset();
+    db_->MultiGet(ReadOptions(), dbfull()->DefaultColumnFamily(), keys.size(),
+                  keys.data(), sync_values.data(), sync_statuses.data());
+    ASSERT_GT(bloom_sst_miss_count, 0);
+    ASSERT_EQ(get_perf_context()->bloom_sst_hit_count, bloom_sst_hit_count);
+    ASSERT_EQ(get_perf_context()->bloom_sst_miss_count, bloom_sst_miss_count);
+    SetPerfLevel(kDisable);
+  }
+  for (unsigned int j = 0; j < keys.size(); ++j) {
+    int key = j + 40;
+    ASSERT_OK(statuses[j]);
+    if (key % 3 == 0) {
+      ASSERT_EQ(values[j], "val_l1_" + std::to_string(key));
+    } else {
+      ASSERT_EQ(values[j], "val_l2_" + std::to_string(key));
+    }
+  }
+}
+
 TEST_F(DBBasicTest, MultiGetBatchedMultiLevelMerge) {
   Options options = CurrentOptions();
   options.disable_auto_compactions = true;
@@ -8,11 +8,13 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include "db/db_test_util.h"
+#include "env/composite_env_wrapper.h"
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/concurrent_task_limiter.h"
 #include "rocksdb/experimental.h"
 #include "rocksdb/sst_file_writer.h"
+#include "rocksdb/sst_partitioner.h"
 #include "rocksdb/utilities/convenience.h"
 #include "test_util/fault_injection_test_env.h"
 #include "test_util/sync_point.h"
@@ -4133,6 +4135,242 @@ TEST_F(DBCompactionTest, LevelPeriodicCompactionWithCompactionFilters) {
   }
 }
 
+TEST_F(DBCompactionTest, TemperatureBasedPlacement) {
+  // Records the temperature each table file was created with.
+  class TemperatureFS : public FileSystemWrapper {
+   public:
+    TemperatureFS() : FileSystemWrapper(FileSystem::Default()) {}
+
+    IOStatus NewWritableFile(const std::string& fname,
+                             const FileOptions& file_opts,
+                             std::unique_ptr<FSWritableFile>* result,
+                             IODebugContext* dbg) override {
+      uint64_t number;
+      FileType type;
+      if (ParseFileName(fname.substr(fname.rfind('/') + 1), &number, &type) &&
+          type == kTableFile) {
+        MutexLock l(&mutex_);
+        temperatures_[number] = file_opts.temperature;
+      }
+      return target()->NewWritableFile(fname, file_opts, result, dbg);
+    }
+
+    Temperature GetTemperature(uint64_t number) {
+      MutexLock l(&mutex_);
+      auto iter = temperatures_.find(number);
+      return iter == temperatures_.end() ? Temperature::kUnknown
+                                         : iter->second;
+    }
+
+   private:
+    port::Mutex mutex_;
+    std::map<uint64_t, Temperature> temperatures_;
+  };
+
+  auto fs = std::make_shared<TemperatureFS>();
+  std::unique_ptr<Env> temperature_env(new CompositeEnvWrapper(env_, fs));
+  env_->time_elapse_only_sleep_ = false;
+  env_->addon_time_.store(0);
+
+  Options options = CurrentOptions();
+  options.env = temperature_env.get();
+  options.num_levels = 3;
+  options.db_paths.emplace_back(dbname_, port::kMaxUint64);
+  options.db_paths.emplace_back(dbname_ + "_2", port::kMaxUint64,
+                                Temperature::kCold);
+  DestroyAndReopen(options);
+
+  int temperature_compactions = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        Compaction* compaction = reinterpret_cast<Compaction*>(arg);
+        if (compaction->compaction_reason() ==
+            CompactionReason::kChangeTemperature) {
+          temperature_compactions++;
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  // Checks the temperature of the only file in `level`, both in the version
+  // and as passed to the FileSystem, and that it was placed accordingly.
+  auto check_level = [&](int level, Temperature temperature) {
+    std::vector<std::vector<FileMetaData>> files;
+    dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+    ASSERT_EQ(1U, files[level].size());
+    const FileMetaData& meta = files[level][0];
+    ASSERT_EQ(temperature, meta.temperature);
+    ASSERT_EQ(temperature, fs->GetTemperature(meta.fd.GetNumber()));
+    ASSERT_EQ(temperature == Temperature::kCold ? 1U : 0U,
+              meta.fd.GetPathId());
+  };
+
+  auto write_and_flush = [&](const std::string& value) {
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_OK(Put(Key(i), value));
+    }
+    ASSERT_OK(Flush());
+  };
+
+  // Flush output is hot.
+  write_and_flush("v1");
+  ASSERT_EQ("1", FilesPerLevel());
+  check_level(0, Temperature::kHot);
+
+  // Compaction output with nothing below it is cold and goes to the path
+  // tagged kCold. The trivial move to L2 keeps it there.
+  write_and_flush("v2");
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_OK(dbfull()->TEST_CompactRange(1, nullptr, nullptr));
+  ASSERT_EQ("0,0,1", FilesPerLevel());
+  check_level(2, Temperature::kCold);
+
+  // Compaction output above other data is warm.
+  write_and_flush("v3");
+  write_and_flush("v4");
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+  check_level(1, Temperature::kWarm);
+
+  // Temperatures are persisted in the MANIFEST.
+  Reopen(options);
+  std::vector<std::vector<FileMetaData>> files;
+  dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+  ASSERT_EQ(Temperature::kWarm, files[1][0].temperature);
+  ASSERT_EQ(Temperature::kCold, files[2][0].temperature);
+  ASSERT_EQ(0, temperature_compactions);
+
+  // Once the warm file is old enough and unread, it is rewritten in place as
+  // cold.
+  env_->addon_time_.fetch_add(2 * 60 * 60);
+  ASSERT_OK(dbfull()->SetOptions({{"cold_file_age_seconds", "3600"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(1, temperature_compactions);
+  ASSERT_EQ("0,1,1", FilesPerLevel());
+  check_level(1, Temperature::kCold);
+  check_level(2, Temperature::kCold);
+  ASSERT_EQ("v4", Get(Key(0)));
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  Close();
+}
+
+TEST_F(DBCompactionTest, BackgroundTableFileWrites) {
+  Options options = CurrentOptions();
+  options.enable_background_table_file_writes = true;
+  options.writable_file_max_buffer_size = 4 * 1024;
+  options.bytes_per_sync = 16 * 1024;
+  options.level0_file_num_compaction_trigger = 2;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 100; ++j) {
+      values.push_back(RandomString(&rnd, 1000));
+      ASSERT_OK(Put(Key(j), values.back()));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ("0,1", FilesPerLevel());
+
+  Reopen(options);
+  for (int j = 0; j < 100; ++j) {
+    ASSERT_EQ(values[100 + j], Get(Key(j)));
+  }
+}
+
+TEST_F(DBCompactionTest, ColdDataStaysCold) {
+  env_->time_elapse_only_sleep_ = false;
+  env_->addon_time_.store(0);
+
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.num_levels = 4;
+  options.db_paths.emplace_back(dbname_, port::kMaxUint64);
+  options.db_paths.emplace_back(dbname_ + "_2", port::kMaxUint64,
+                                Temperature::kCold);
+  DestroyAndReopen(options);
+
+  int temperature_compactions = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "LevelCompactionPicker::PickCompaction:Return", [&](void* arg) {
+        Compaction* compaction = reinterpret_cast<Compaction*>(arg);
+        if (compaction->compaction_reason() ==
+            CompactionReason::kChangeTemperature) {
+          temperature_compactions++;
+        }
+      });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  auto get_level_file = [&](int level) {
+    std::vector<std::vector<FileMetaData>> files;
+    dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+    EXPECT_EQ(1U, files[level].size());
+    return files[level][0];
+  };
+
+  auto write_and_flush = [&](const std::string& value) {
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_OK(Put(Key(i), value));
+    }
+    ASSERT_OK(Flush());
+  };
+
+  // Fill L3, so that L1 and L2 are middle levels, then L2 and L1. Two files
+  // are flushed each time, so that they are not trivially moved.
+  write_and_flush("v1");
+  write_and_flush("v2");
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_OK(dbfull()->TEST_CompactRange(1, nullptr, nullptr));
+  ASSERT_OK(dbfull()->TEST_CompactRange(2, nullptr, nullptr));
+  write_and_flush("v3");
+  write_and_flush("v4");
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_OK(dbfull()->TEST_CompactRange(1, nullptr, nullptr));
+  write_and_flush("v5");
+  write_and_flush("v6");
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_EQ("0,1,1,1", FilesPerLevel());
+  ASSERT_EQ(Temperature::kCold, get_level_file(3).temperature);
+  ASSERT_EQ(Temperature::kWarm, get_level_file(1).temperature);
+  ASSERT_EQ(Temperature::kWarm, get_level_file(2).temperature);
+
+  // The L1 and L2 files become cold.
+  env_->addon_time_.fetch_add(2 * 60 * 60);
+  ASSERT_OK(dbfull()->SetOptions({{"cold_file_age_seconds", "3600"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(2, temperature_compactions);
+  ASSERT_EQ("0,1,1,1", FilesPerLevel());
+  ASSERT_EQ(Temperature::kCold, get_level_file(1).temperature);
+  ASSERT_EQ(Temperature::kCold, get_level_file(2).temperature);
+
+  // Compacting them together into L2 writes a cold file, which is not
+  // rewritten again.
+  ASSERT_OK(dbfull()->TEST_CompactRange(1, nullptr, nullptr));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ("0,0,1,1", FilesPerLevel());
+  FileMetaData meta = get_level_file(2);
+  ASSERT_EQ(Temperature::kCold, meta.temperature);
+  ASSERT_EQ(1U, meta.fd.GetPathId());
+  ASSERT_EQ(2, temperature_compactions);
+
+  // CompactFiles() keeps the output path it is given.
+  ASSERT_OK(db_->CompactFiles(CompactionOptions(),
+                              {MakeTableFileName(meta.fd.GetNumber())}, 2,
+                              0 /* output_path_id */));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ("0,0,1,1", FilesPerLevel());
+  meta = get_level_file(2);
+  ASSERT_EQ(Temperature::kCold, meta.temperature);
+  ASSERT_EQ(0U, meta.fd.GetPathId());
+  ASSERT_EQ(2, temperature_compactions);
+  ASSERT_EQ("v6", Get(Key(0)));
+
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+  Close();
+}
+
 TEST_F(DBCompactionTest, CompactRangeDelayedByL0FileCount) {
   // Verify that, when `CompactRangeOptions::allow_write_stall == false`, manual
   // compaction only triggers flush after it's sure stall won't be triggered for
@@ -4710,6 +4948,58 @@ TEST_F(DBCompactionTest, CompactionLimiter) {
   ASSERT_OK(dbfull()->TEST_WaitForCompact());
 }
 
+TEST_P(DBCompactionTestWithParam, PipelinedCompaction) {
+  Options options = CurrentOptions();
+  options.enable_pipelined_compaction = true;
+  options.max_subcompactions = max_subcompactions_;
+  options.disable_auto_compactions = true;
+  options.target_file_size_base = 64 << 10;
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 2000;
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int f = 0; f < 3; ++f) {
+    for (int k = f; k < kNumKeys; k += 2) {
+      std::string value = RandomString(&rnd, 100);
+      ASSERT_OK(Put(Key(k), value));
+      expected[Key(k)] = value;
+    }
+    ASSERT_OK(Delete(Key(f * 100)));
+    expected.erase(Key(f * 100));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(500), Key(700)));
+  expected.erase(expected.lower_bound(Key(500)),
+                 expected.lower_bound(Key(700)));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+
+  // Compact the bottommost files again, so that the range tombstones are
+  // read from an input file.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(1500), Key(1600)));
+  expected.erase(expected.lower_bound(Key(1500)),
+                 expected.lower_bound(Key(1600)));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(options.num_levels - 2);
+  CompactRangeOptions cro;
+  cro.bottommost_level_compaction = BottommostLevelCompaction::kForce;
+  ASSERT_OK(db_->CompactRange(cro, nullptr, nullptr));
+
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  auto expected_it = expected.begin();
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected_it) {
+    ASSERT_NE(expected.end(), expected_it);
+    ASSERT_EQ(expected_it->first, iter->key().ToString());
+    ASSERT_EQ(expected_it->second, iter->value().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(expected.end(), expected_it);
+}
+
 INSTANTIATE_TEST_CASE_P(DBCompactionTestWithParam, DBCompactionTestWithParam,
                         ::testing::Values(std::make_tuple(1, true),
                                           std::make_tuple(1, false),
@@ -5279,6 +5569,227 @@ TEST_P(DBCompactionTestWithParam,
   }
 }
 
+TEST_F(DBCompactionTest, BalancedSubcompactionsOfOverlappingFiles) {
+  class SubcompactionCollector : public EventListener {
+   public:
+    void OnCompactionCompleted(DB* /*db*/,
+                               const CompactionJobInfo& info) override {
+      num_subcompactions = info.stats.subcompaction_elapsed_micros.size();
+    }
+    std::atomic<size_t> num_subcompactions{0};
+  };
+
+  const int kNumFiles = 4;
+  const int kNumKeys = 4000;
+  for (auto style : {kCompactionStyleLevel, kCompactionStyleUniversal}) {
+    Options options = CurrentOptions();
+    options.compaction_style = style;
+    options.num_levels = 4;
+    options.disable_auto_compactions = true;
+    options.max_subcompactions = 4;
+    options.compression = kNoCompression;
+    options.target_file_size_base = 32 << 10;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    auto* collector = new SubcompactionCollector();
+    options.listeners.emplace_back(collector);
+    DestroyAndReopen(options);
+
+    if (style == kCompactionStyleLevel) {
+      // L0->L1 compactions are only split when L1 is not empty.
+      ASSERT_OK(Put(Key(0), "base"));
+      ASSERT_OK(Flush());
+      MoveFilesToLevel(1);
+    }
+    // Every file covers the whole key range, so file boundaries alone cannot
+    // split the compaction into balanced subcompactions.
+    Random rnd(301);
+    for (int f = 0; f < kNumFiles; ++f) {
+      for (int k = f; k < kNumKeys; k += kNumFiles) {
+        ASSERT_OK(Put(Key(k), RandomString(&rnd, 100)));
+      }
+      ASSERT_OK(Flush());
+    }
+
+    std::vector<uint64_t> sizes;
+    SyncPoint::GetInstance()->SetCallBack(
+        "CompactionJob::GenSubcompactionBoundaries:Sizes", [&](void* arg) {
+          sizes = *static_cast<std::vector<uint64_t>*>(arg);
+        });
+    SyncPoint::GetInstance()->EnableProcessing();
+    if (style == kCompactionStyleLevel) {
+      ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+    } else {
+      ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+    }
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+
+    ASSERT_EQ(static_cast<size_t>(options.max_subcompactions), sizes.size());
+    uint64_t min_size = *std::min_element(sizes.begin(), sizes.end());
+    uint64_t max_size = *std::max_element(sizes.begin(), sizes.end());
+    ASSERT_GT(min_size, 0);
+    ASSERT_LT(max_size, 2 * min_size);
+    ASSERT_EQ(sizes.size(), collector->num_subcompactions.load());
+    for (int k = 0; k < kNumKeys; ++k) {
+      ASSERT_NE("NOT_FOUND", Get(Key(k)));
+    }
+  }
+}
+
+TEST_F(DBCompactionTest, TieredUpperLevels) {
+  Options options = CurrentOptions();
+  options.num_levels = 5;
+  options.level_compaction_num_tiered_levels = 3;
+  options.level0_file_num_compaction_trigger = 3;
+  DestroyAndReopen(options);
+
+  // Every flush overlaps all the others, so the sorted runs of L0 to L2 are
+  // merged into fewer runs rather than moved down.
+  const int kNumKeys = 10;
+  for (int f = 0; f < 10; ++f) {
+    for (int k = 0; k < kNumKeys; ++k) {
+      ASSERT_OK(Put(Key(k), "v" + ToString(f)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+    int num_sorted_runs = NumTableFilesAtLevel(0);
+    for (int level = 1; level < 3; ++level) {
+      if (NumTableFilesAtLevel(level) > 0) {
+        ++num_sorted_runs;
+      }
+    }
+    ASSERT_LT(num_sorted_runs, options.level0_file_num_compaction_trigger);
+    // L2 is under max_bytes_for_level_base, so nothing leaves the tiered
+    // levels.
+    ASSERT_EQ(0, NumTableFilesAtLevel(3));
+    ASSERT_EQ(0, NumTableFilesAtLevel(4));
+  }
+  ASSERT_GT(NumTableFilesAtLevel(2), 0);
+
+  // Once L2 exceeds its target, its files are compacted down the leveled way.
+  ASSERT_OK(dbfull()->SetOptions({{"max_bytes_for_level_base", "1"}}));
+  ASSERT_OK(Put(Key(0), "v10"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(0, NumTableFilesAtLevel(2));
+  ASSERT_GT(NumTableFilesAtLevel(3) + NumTableFilesAtLevel(4), 0);
+
+  ASSERT_EQ("v10", Get(Key(0)));
+  for (int k = 1; k < kNumKeys; ++k) {
+    ASSERT_EQ("v9", Get(Key(k)));
+  }
+}
+
+TEST_F(DBCompactionTest, SstPartitionerFixedPrefix) {
+  int32_t trivial_move = 0;
+  int32_t non_trivial_move = 0;
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:TrivialMove",
+      [&](void* /*arg*/) { trivial_move++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:NonTrivial",
+      [&](void* /*arg*/) { non_trivial_move++; });
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->EnableProcessing();
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.sst_partitioner_factory = NewSstPartitionerFixedPrefixFactory(4);
+  DestroyAndReopen(options);
+
+  // A file holding a single prefix can still be moved down.
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(Put("aaaa" + Key(i), "v"));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(1, trivial_move);
+  ASSERT_EQ(0, non_trivial_move);
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+
+  // A file holding several prefixes is rewritten into one file per prefix.
+  const std::vector<std::string> prefixes = {"bbbb", "cccc", "dddd"};
+  for (const auto& prefix : prefixes) {
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_OK(Put(prefix + Key(i), "v"));
+    }
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(1, trivial_move);
+  ASSERT_GT(non_trivial_move, 0);
+
+  ColumnFamilyMetaData cf_meta;
+  db_->GetColumnFamilyMetaData(&cf_meta);
+  size_t num_files = 0;
+  for (const auto& level : cf_meta.levels) {
+    for (const auto& file : level.files) {
+      ASSERT_EQ(file.smallestkey.substr(0, 4), file.largestkey.substr(0, 4));
+      ++num_files;
+    }
+  }
+  ASSERT_EQ(1 + prefixes.size(), num_files);
+
+  for (const auto& prefix : prefixes) {
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_EQ("v", Get(prefix + Key(i)));
+    }
+  }
+  ROCKSDB_NAMESPACE::SyncPoint::GetInstance()->DisableProcessing();
+}
+
+TEST_F(DBCompactionTest, OutputFilesAlignedWithNextLevelFiles) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compression = kNoCompression;
+  options.write_buffer_size = 10 << 20;
+  options.target_file_size_base = 60 << 10;
+  options.target_file_size_multiplier = 1;
+  DestroyAndReopen(options);
+
+  // Two overlapping L0 files, so that they are merged into files of the
+  // target size rather than moved down as they are.
+  const int kNumKeys = 400;
+  Random rnd(301);
+  for (int f = 0; f < 2; ++f) {
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, 1000)));
+    }
+    ASSERT_OK(Flush());
+  }
+  MoveFilesToLevel(2);
+  ASSERT_GT(NumTableFilesAtLevel(2), 2);
+
+  ColumnFamilyMetaData cf_meta;
+  db_->GetColumnFamilyMetaData(&cf_meta);
+  std::set<std::string> l2_largest_keys;
+  for (const auto& file : cf_meta.levels[2].files) {
+    l2_largest_keys.insert(file.largestkey);
+  }
+
+  // With larger output files, the L0->L1 compaction ends each output at the
+  // end of an L2 file, once the output is at least half the target size.
+  ASSERT_OK(dbfull()->SetOptions({{"target_file_size_base", "100000"}}));
+  for (int f = 0; f < 2; ++f) {
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, 1000)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_GT(NumTableFilesAtLevel(1), 1);
+
+  db_->GetColumnFamilyMetaData(&cf_meta);
+  const auto& l1_files = cf_meta.levels[1].files;
+  for (size_t i = 0; i + 1 < l1_files.size(); ++i) {
+    ASSERT_EQ(1, l2_largest_keys.count(l1_files[i].largestkey));
+  }
+}
+
 #endif // !defined(ROCKSDB_LITE)
 }  // namespace ROCKSDB_NAMESPACE
 
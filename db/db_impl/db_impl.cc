@@ -142,6 +142,17 @@ void DumpSupportInfo(Logger* logger) {
   ROCKS_LOG_HEADER(logger, "Fast CRC32 supported: %s",
                    crc32c::IsFastCrc32Supported().c_str());
 }
+
+#ifndef ROCKSDB_LITE
+void DeleteDBRowCacheEntry(const Slice& /*key*/, void* value) {
+  delete reinterpret_cast<std::string*>(value);
+}
+
+void ReleaseDBRowCacheEntry(void* cache, void* handle) {
+  reinterpret_cast<Cache*>(cache)->Release(
+      reinterpret_cast<Cache::Handle*>(handle));
+}
+#endif  // ROCKSDB_LITE
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
@@ -230,6 +241,8 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   // WriteUnprepared, which should use seq_per_batch_.
   assert(batch_per_txn_ || seq_per_batch_);
   env_->GetAbsolutePath(dbname, &db_absolute_path_);
+  file_options_for_compaction_.background_writes =
+      immutable_db_options_.enable_background_table_file_writes;
 
   // Reserve ten files or so for other uses and give the rest to TableCache.
   // Give a large number for setting of "infinite" open files.
@@ -241,6 +254,10 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
   co.num_shard_bits = immutable_db_options_.table_cache_numshardbits;
   co.metadata_charge_policy = kDontChargeCacheMetadata;
   table_cache_ = NewLRUCache(co);
+  if (immutable_db_options_.db_row_cache) {
+    PutVarint64(&db_row_cache_id_,
+                immutable_db_options_.db_row_cache->NewId());
+  }
 
   versions_.reset(new VersionSet(dbname_, &immutable_db_options_, file_options_,
                                  table_cache_.get(), write_buffer_manager_,
@@ -1087,6 +1104,8 @@ Status DBImpl::SetDBOptions(
           file_options_for_compaction_, immutable_db_options_);
       file_options_for_compaction_.compaction_readahead_size =
           mutable_db_options_.compaction_readahead_size;
+      file_options_for_compaction_.background_writes =
+          immutable_db_options_.enable_background_table_file_writes;
       WriteThread::Writer w;
       write_thread_.EnterUnbatched(&w, &mutex_);
       if (total_log_size_ > GetMaxTotalWalSize() || wal_changed) {
@@ -1458,7 +1477,8 @@ InternalIterator* DBImpl::NewInternalIterator(const ReadOptions& read_options,
   MergeIteratorBuilder merge_iter_builder(
       &cfd->internal_comparator(), arena,
       !read_options.total_order_seek &&
-          super_version->mutable_cf_options.prefix_extractor != nullptr);
+          super_version->mutable_cf_options.prefix_extractor != nullptr,
+      read_options.use_loser_tree_merge);
   // Collect iterator for mutable mem
   merge_iter_builder.AddIterator(
       super_version->mem->NewIterator(read_options, arena));
@@ -1544,6 +1564,7 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
 
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, env_);
   StopWatch sw(env_, stats_, DB_GET);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   PERF_TIMER_GUARD(get_snapshot_time);
 
   auto cfh =
@@ -1666,14 +1687,43 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   }
   if (!done) {
     PERF_TIMER_GUARD(get_from_output_files_time);
-    sv->current->Get(
-        read_options, lkey, get_impl_options.value, timestamp, &s,
-        &merge_context, &max_covering_tombstone_seq,
-        get_impl_options.get_value ? get_impl_options.value_found : nullptr,
-        nullptr, nullptr,
-        get_impl_options.get_value ? get_impl_options.callback : nullptr,
-        get_impl_options.get_value ? get_impl_options.is_blob_index : nullptr,
-        get_impl_options.get_value);
+#ifndef ROCKSDB_LITE
+    // When nothing was found in the memtables and the read sees every key in
+    // the SST files, the result only depends on the Version, so it can be
+    // cached until the SuperVersion changes.
+    std::string db_row_cache_key;
+    const bool use_db_row_cache =
+        immutable_db_options_.db_row_cache != nullptr &&
+        read_options.snapshot == nullptr &&
+        !read_options.ignore_range_deletions && last_seq_same_as_publish_seq_ &&
+        get_impl_options.get_value && get_impl_options.callback == nullptr &&
+        get_impl_options.is_blob_index == nullptr &&
+        get_impl_options.value_found == nullptr && ts_sz == 0 && s.ok() &&
+        merge_context.GetNumOperands() == 0 && max_covering_tombstone_seq == 0;
+    if (use_db_row_cache) {
+      db_row_cache_key = db_row_cache_id_;
+      PutVarint32(&db_row_cache_key, cfd->GetID());
+      db_row_cache_key.append(key.data(), key.size());
+      done = GetFromDBRowCache(db_row_cache_key, sv, get_impl_options.value,
+                               &s);
+    }
+#endif  // ROCKSDB_LITE
+    if (!done) {
+      sv->current->Get(
+          read_options, lkey, get_impl_options.value, timestamp, &s,
+          &merge_context, &max_covering_tombstone_seq,
+          get_impl_options.get_value ? get_impl_options.value_found : nullptr,
+          nullptr, nullptr,
+          get_impl_options.get_value ? get_impl_options.callback : nullptr,
+          get_impl_options.get_value ? get_impl_options.is_blob_index
+                                     : nullptr,
+          get_impl_options.get_value);
+#ifndef ROCKSDB_LITE
+      if (use_db_row_cache) {
+        InsertIntoDBRowCache(db_row_cache_key, sv, *get_impl_options.value, s);
+      }
+#endif  // ROCKSDB_LITE
+    }
     RecordTick(stats_, MEMTABLE_MISS);
   }
 
@@ -1712,6 +1762,58 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
   return s;
 }
 
+#ifndef ROCKSDB_LITE
+bool DBImpl::GetFromDBRowCache(const Slice& cache_key, const SuperVersion* sv,
+                               PinnableSlice* value, Status* s) {
+  Cache* const db_row_cache = immutable_db_options_.db_row_cache.get();
+  Cache::Handle* handle = db_row_cache->Lookup(cache_key);
+  if (handle == nullptr) {
+    RecordTick(stats_, DB_ROW_CACHE_MISS);
+    return false;
+  }
+  // The entry is the SuperVersion number it was computed with, followed by
+  // the value type and, for kTypeValue, the value.
+  Slice entry(*static_cast<const std::string*>(db_row_cache->Value(handle)));
+  uint64_t version_number = 0;
+  if (!GetVarint64(&entry, &version_number) ||
+      version_number != sv->version_number || entry.empty()) {
+    db_row_cache->Release(handle);
+    RecordTick(stats_, DB_ROW_CACHE_INVALIDATION);
+    RecordTick(stats_, DB_ROW_CACHE_MISS);
+    return false;
+  }
+  if (static_cast<ValueType>(entry[0]) == kTypeValue) {
+    entry.remove_prefix(1);
+    value->PinSlice(entry, &ReleaseDBRowCacheEntry, db_row_cache, handle);
+    *s = Status::OK();
+  } else {
+    db_row_cache->Release(handle);
+    *s = Status::NotFound();
+  }
+  RecordTick(stats_, DB_ROW_CACHE_HIT);
+  return true;
+}
+
+void DBImpl::InsertIntoDBRowCache(const Slice& cache_key,
+                                  const SuperVersion* sv,
+                                  const PinnableSlice& value, const Status& s) {
+  if (!s.ok() && !s.IsNotFound()) {
+    return;
+  }
+  std::string* entry = new std::string();
+  PutVarint64(entry, sv->version_number);
+  if (s.ok()) {
+    entry->push_back(static_cast<char>(kTypeValue));
+    entry->append(value.data(), value.size());
+  } else {
+    entry->push_back(static_cast<char>(kTypeDeletion));
+  }
+  size_t charge = cache_key.size() + entry->size() + sizeof(std::string);
+  immutable_db_options_.db_row_cache->Insert(cache_key, entry, charge,
+                                             &DeleteDBRowCacheEntry);
+}
+#endif  // ROCKSDB_LITE
+
 std::vector<Status> DBImpl::MultiGet(
     const ReadOptions& read_options,
     const std::vector<ColumnFamilyHandle*>& column_family,
@@ -1727,6 +1829,7 @@ std::vector<Status> DBImpl::MultiGet(
     std::vector<std::string>* timestamps) {
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, env_);
   StopWatch sw(env_, stats_, DB_MULTIGET);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   PERF_TIMER_GUARD(get_snapshot_time);
 
 #ifndef NDEBUG
@@ -2273,6 +2376,7 @@ Status DBImpl::MultiGetImpl(
     ReadCallback* callback, bool* is_blob_index) {
   PERF_CPU_TIMER_GUARD(get_cpu_nanos, env_);
   StopWatch sw(env_, stats_, DB_MULTIGET);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
 
   // For each of the given keys, apply the entire "get" process as follows:
   // First look in the memtable, then in the immutable memtable (if any).
@@ -2707,8 +2811,11 @@ ArenaWrappedDBIter* DBImpl::NewIteratorImpl(const ReadOptions& read_options,
                                             SequenceNumber snapshot,
                                             ReadCallback* read_callback,
                                             bool allow_blob,
-                                            bool allow_refresh) {
-  SuperVersion* sv = cfd->GetReferencedSuperVersion(this);
+                                            bool allow_refresh,
+                                            SuperVersion* sv) {
+  if (sv == nullptr) {
+    sv = cfd->GetReferencedSuperVersion(this);
+  }
 
   TEST_SYNC_POINT("DBImpl::NewIterator:1");
   TEST_SYNC_POINT("DBImpl::NewIterator:2");
@@ -2771,8 +2878,8 @@ ArenaWrappedDBIter* DBImpl::NewIteratorImpl(const ReadOptions& read_options,
   // likely that any iterator pointer is close to the iterator it points to so
   // that they are likely to be in the same cache line and/or page.
   ArenaWrappedDBIter* db_iter = NewArenaWrappedDbIterator(
-      env_, read_options, *cfd->ioptions(), sv->mutable_cf_options, snapshot,
-      sv->mutable_cf_options.max_sequential_skip_in_iterations,
+      env_, read_options, *cfd->ioptions(), sv->mutable_cf_options, sv->current,
+      snapshot, sv->mutable_cf_options.max_sequential_skip_in_iterations,
       sv->version_number, read_callback, this, cfd, allow_blob,
       read_options.snapshot != nullptr ? false : allow_refresh);
 
@@ -2834,6 +2941,95 @@ Status DBImpl::NewIterators(
   return Status::OK();
 }
 
+namespace {
+// Keeps the bounds of a partition iterator alive for as long as the iterator
+struct PartitionBounds {
+  std::string lower;
+  std::string upper;
+  Slice lower_slice;
+  Slice upper_slice;
+};
+
+void DeletePartitionBounds(void* arg1, void* /*arg2*/) {
+  delete reinterpret_cast<PartitionBounds*>(arg1);
+}
+}  // namespace
+
+Status DBImpl::NewPartitionedIterators(const ReadOptions& read_options,
+                                       ColumnFamilyHandle* column_family,
+                                       size_t num_partitions,
+                                       std::vector<Iterator*>* iterators) {
+  if (num_partitions == 0) {
+    return Status::InvalidArgument("num_partitions must be positive");
+  }
+  if (read_options.managed) {
+    return Status::NotSupported("Managed iterator is not supported anymore.");
+  }
+  if (read_options.tailing) {
+    return Status::NotSupported("Tailing iterators cannot be partitioned.");
+  }
+  if (read_options.deadline != std::chrono::microseconds::zero()) {
+    return Status::NotSupported("ReadOptions deadline is not supported");
+  }
+  if (read_options.read_tier == kPersistedTier) {
+    return Status::NotSupported(
+        "ReadTier::kPersistedData is not yet supported in iterators.");
+  }
+  auto cfh = reinterpret_cast<ColumnFamilyHandleImpl*>(column_family);
+  ColumnFamilyData* cfd = cfh->cfd();
+  assert(cfd != nullptr);
+  iterators->clear();
+
+  // All the partitions share one SuperVersion and one sequence number, so
+  // together they see exactly what a single iterator would see.
+  SuperVersion* sv = cfd->GetReferencedSuperVersion(this);
+  std::vector<std::string> boundaries;
+  std::vector<uint64_t> partition_sizes;
+  Status s = sv->current->GetRangePartitions(
+      read_options, read_options.iterate_lower_bound,
+      read_options.iterate_upper_bound, num_partitions, &boundaries,
+      &partition_sizes);
+  if (!s.ok()) {
+    CleanupSuperVersion(sv);
+    return s;
+  }
+  // Note: no need to consider the special case of
+  // last_seq_same_as_publish_seq_==false since this is not supported with
+  // WritePreparedTxnDB
+  SequenceNumber snapshot = read_options.snapshot != nullptr
+                                ? read_options.snapshot->GetSequenceNumber()
+                                : versions_->LastSequence();
+
+  iterators->reserve(boundaries.size() + 1);
+  for (size_t i = 0; i <= boundaries.size(); ++i) {
+    PartitionBounds* bounds = new PartitionBounds;
+    ReadOptions ro = read_options;
+    if (i > 0) {
+      bounds->lower = boundaries[i - 1];
+      bounds->lower_slice = bounds->lower;
+      ro.iterate_lower_bound = &bounds->lower_slice;
+    }
+    if (i < boundaries.size()) {
+      bounds->upper = boundaries[i];
+      bounds->upper_slice = bounds->upper;
+      ro.iterate_upper_bound = &bounds->upper_slice;
+    }
+    if (ro.readahead_size > 0 && partition_sizes[i] > 0) {
+      ro.readahead_size = static_cast<size_t>(
+          std::min<uint64_t>(ro.readahead_size, partition_sizes[i]));
+    }
+    if (i > 0) {
+      sv->Ref();
+    }
+    ArenaWrappedDBIter* iter =
+        NewIteratorImpl(ro, cfd, snapshot, nullptr /* read_callback */,
+                        false /* allow_blob */, false /* allow_refresh */, sv);
+    iter->RegisterCleanup(&DeletePartitionBounds, bounds, nullptr);
+    iterators->push_back(iter);
+  }
+  return Status::OK();
+}
+
 const Snapshot* DBImpl::GetSnapshot() { return GetSnapshotImpl(false); }
 
 #ifndef ROCKSDB_LITE
@@ -259,6 +259,9 @@ class DBImpl : public DB {
       const ReadOptions& options,
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) override;
+  virtual Status NewPartitionedIterators(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      size_t num_partitions, std::vector<Iterator*>* iterators) override;
 
   virtual const Snapshot* GetSnapshot() override;
   virtual void ReleaseSnapshot(const Snapshot* snapshot) override;
@@ -479,13 +482,29 @@ class DBImpl : public DB {
   Status GetImpl(const ReadOptions& options, const Slice& key,
                  GetImplOptions& get_impl_options);
 
+#ifndef ROCKSDB_LITE
+  // Looks up the result of Version::Get() for cache_key in
+  // DBOptions::db_row_cache. On a hit that was cached with sv, sets *value
+  // and *s and returns true.
+  bool GetFromDBRowCache(const Slice& cache_key, const SuperVersion* sv,
+                         PinnableSlice* value, Status* s);
+
+  // Caches the result of Version::Get() on sv for cache_key, if it is a
+  // value or "not found".
+  void InsertIntoDBRowCache(const Slice& cache_key, const SuperVersion* sv,
+                            const PinnableSlice& value, const Status& s);
+#endif  // ROCKSDB_LITE
+
   // If `snapshot` == kMaxSequenceNumber, set a recent one inside the file.
+  // If `sv` is not nullptr, the iterator takes over the caller's reference to
+  // it instead of referencing the current SuperVersion of `cfd`.
   ArenaWrappedDBIter* NewIteratorImpl(const ReadOptions& options,
                                       ColumnFamilyData* cfd,
                                       SequenceNumber snapshot,
                                       ReadCallback* read_callback,
                                       bool allow_blob = false,
-                                      bool allow_refresh = true);
+                                      bool allow_refresh = true,
+                                      SuperVersion* sv = nullptr);
 
   virtual SequenceNumber GetLastPublishedSequence() const {
     if (last_seq_same_as_publish_seq_) {
@@ -986,6 +1005,8 @@ class DBImpl : public DB {
   // db_session_id_ is an identifier that gets reset
   // every time the DB is opened
   std::string db_session_id_;
+  // Prefix of the keys of this DB in DBOptions::db_row_cache.
+  std::string db_row_cache_id_;
   std::unique_ptr<VersionSet> versions_;
   // Flag to check whether we allocated and own the info log file
   bool own_info_log_;
@@ -1316,7 +1316,8 @@ Status DBImpl::ReFitLevel(ColumnFamilyData* cfd, int level, int target_level) {
                    f->fd.smallest_seqno, f->fd.largest_seqno,
                    f->marked_for_compaction, f->oldest_blob_file_number,
                    f->oldest_ancester_time, f->file_creation_time,
-                   f->file_checksum, f->file_checksum_func_name);
+                   f->file_checksum, f->file_checksum_func_name,
+                   f->temperature);
     }
     ROCKS_LOG_DEBUG(immutable_db_options_.info_log,
                     "[%s] Apply version edit:\n%s", cfd->GetName().c_str(),
@@ -2735,7 +2736,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
                            f->fd.largest_seqno, f->marked_for_compaction,
                            f->oldest_blob_file_number, f->oldest_ancester_time,
                            f->file_creation_time, f->file_checksum,
-                           f->file_checksum_func_name);
+                           f->file_checksum_func_name, f->temperature);
 
         ROCKS_LOG_BUFFER(
             log_buffer,
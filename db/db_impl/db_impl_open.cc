@@ -12,10 +12,13 @@
 
 #include "db/builder.h"
 #include "db/error_handler.h"
+#include "db/pipelined_log_reader.h"
 #include "env/composite_env_wrapper.h"
+#include "file/filename.h"
 #include "file/read_write_util.h"
 #include "file/sst_file_manager_impl.h"
 #include "file/writable_file_writer.h"
+#include "monitoring/iostats_context_imp.h"
 #include "monitoring/persistent_stats_history.h"
 #include "options/options_helper.h"
 #include "rocksdb/wal_filter.h"
@@ -353,6 +356,7 @@ Status DBImpl::Recover(
     bool error_if_log_file_exist, bool error_if_data_exists_in_logs,
     uint64_t* recovered_seq) {
   mutex_.AssertHeld();
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kRecovery);
 
   bool is_new_db = false;
   assert(db_lock_ == nullptr);
@@ -840,12 +844,34 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& log_numbers,
     } else {
       reporter.status = &status;
     }
+    // With pipelined recovery, the log is read on a separate thread, whose
+    // reporter records corruptions in a status of its own. They are passed
+    // on to `status` in the order of the records.
+    LogReporter read_reporter = reporter;
+    Status read_status;
+    const bool pipelined = immutable_db_options_.enable_pipelined_wal_recovery;
+    if (pipelined && reporter.status != nullptr) {
+      read_reporter.status = &read_status;
+    }
     // We intentially make log::Reader do checksumming even if
     // paranoid_checks==false so that corruptions cause entire commits
     // to be skipped instead of propagating bad information (like overly
     // large sequence numbers).
     log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
-                       &reporter, true /*checksum*/, log_number);
+                       &read_reporter, true /*checksum*/, log_number);
+    std::unique_ptr<PipelinedLogReader> pipelined_reader;
+    if (pipelined) {
+      pipelined_reader.reset(new PipelinedLogReader(
+          &reader, immutable_db_options_.wal_recovery_mode,
+          read_reporter.status));
+    }
+    auto read_record = [&](Slice* record, std::string* scratch) {
+      if (pipelined_reader) {
+        return pipelined_reader->ReadRecord(record, &status);
+      }
+      return reader.ReadRecord(record, scratch,
+                               immutable_db_options_.wal_recovery_mode);
+    };
 
     // Determine if we should tolerate incomplete records at the tail end of the
     // Read all the records and add to a memtable
@@ -855,9 +881,7 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& log_numbers,
 
     TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
                              /*arg=*/nullptr);
-    while (!stop_replay_by_wal_filter &&
-           reader.ReadRecord(&record, &scratch,
-                             immutable_db_options_.wal_recovery_mode) &&
+    while (!stop_replay_by_wal_filter && read_record(&record, &scratch) &&
            status.ok()) {
       if (record.size() < WriteBatchInternal::kHeader) {
         reporter.Corruption(record.size(),
@@ -1235,12 +1259,17 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
   std::unique_ptr<std::list<uint64_t>::iterator> pending_outputs_inserted_elem(
       new std::list<uint64_t>::iterator(
           CaptureCurrentFileNumberInPendingOutputs()));
-  meta.fd = FileDescriptor(versions_->NewFileNumber(), 0, 0);
+  meta.temperature = Temperature::kHot;
+  meta.fd = FileDescriptor(
+      versions_->NewFileNumber(),
+      GetPathIdForTemperature(cfd->ioptions()->cf_paths, meta.temperature, 0),
+      0);
   ReadOptions ro;
   ro.total_order_seek = true;
   Arena arena;
   Status s;
   TableProperties table_properties;
+  std::vector<BlobFileAddition> blob_file_additions;
   {
     ScopedArenaIterator iter(mem->NewIterator(ro, &arena));
     ROCKS_LOG_DEBUG(immutable_db_options_.info_log,
@@ -1279,9 +1308,10 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
       }
       IOStatus io_s;
       s = BuildTable(
-          dbname_, env_, fs_.get(), *cfd->ioptions(), mutable_cf_options,
-          file_options_for_compaction_, cfd->table_cache(), iter.get(),
-          std::move(range_del_iters), &meta, cfd->internal_comparator(),
+          dbname_, versions_.get(), env_, fs_.get(), *cfd->ioptions(),
+          mutable_cf_options, file_options_for_compaction_, cfd->table_cache(),
+          iter.get(), std::move(range_del_iters), &meta, &blob_file_additions,
+          cfd->internal_comparator(),
           cfd->int_tbl_prop_collector_factories(), cfd->GetID(), cfd->GetName(),
           snapshot_seqs, earliest_write_conflict_snapshot, snapshot_checker,
           GetCompressionFlush(*cfd->ioptions(), mutable_cf_options),
@@ -1311,7 +1341,12 @@ Status DBImpl::WriteLevel0TableForRecovery(int job_id, ColumnFamilyData* cfd,
                   meta.fd.smallest_seqno, meta.fd.largest_seqno,
                   meta.marked_for_compaction, meta.oldest_blob_file_number,
                   meta.oldest_ancester_time, meta.file_creation_time,
-                  meta.file_checksum, meta.file_checksum_func_name);
+                  meta.file_checksum, meta.file_checksum_func_name,
+                  meta.temperature);
+
+    for (const auto& blob_file_addition : blob_file_additions) {
+      edit->AddBlobFile(blob_file_addition);
+    }
   }
 
   InternalStats::CompactionStats stats(CompactionReason::kFlush, 1);
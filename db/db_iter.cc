@@ -19,6 +19,7 @@
 #include "file/filename.h"
 #include "logging/logging.h"
 #include "memory/arena.h"
+#include "monitoring/iostats_context_imp.h"
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/env.h"
 #include "rocksdb/iterator.h"
@@ -36,8 +37,9 @@ namespace ROCKSDB_NAMESPACE {
 DBIter::DBIter(Env* _env, const ReadOptions& read_options,
                const ImmutableCFOptions& cf_options,
                const MutableCFOptions& mutable_cf_options,
-               const Comparator* cmp, InternalIterator* iter, SequenceNumber s,
-               bool arena_mode, uint64_t max_sequential_skip_in_iterations,
+               const Comparator* cmp, InternalIterator* iter,
+               const Version* version, SequenceNumber s, bool arena_mode,
+               uint64_t max_sequential_skip_in_iterations,
                ReadCallback* read_callback, DBImpl* db_impl,
                ColumnFamilyData* cfd, bool allow_blob)
     : prefix_extractor_(mutable_cf_options.prefix_extractor.get()),
@@ -54,6 +56,9 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       num_internal_keys_skipped_(0),
       iterate_lower_bound_(read_options.iterate_lower_bound),
       iterate_upper_bound_(read_options.iterate_upper_bound),
+      iterate_value_filter_(read_options.iterate_value_filter),
+      iterate_value_projection_(read_options.iterate_value_projection),
+      is_value_projected_(false),
       direction_(kForward),
       valid_(false),
       current_entry_is_merged_(false),
@@ -67,6 +72,10 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
                                      read_options.auto_prefix_mode),
       allow_blob_(allow_blob),
       is_blob_(false),
+      version_(version),
+      read_tier_(read_options.read_tier),
+      verify_checksums_(read_options.verify_checksums),
+      is_blob_value_(false),
       arena_mode_(arena_mode),
       range_del_agg_(&cf_options.internal_comparator, s),
       db_impl_(db_impl),
@@ -123,6 +132,7 @@ void DBIter::Next() {
   assert(status_.ok());
 
   PERF_CPU_TIMER_GUARD(iter_next_cpu_nanos, env_);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   // Release temporarily pinned blocks from last operation
   ReleaseTempPinnedData();
   local_stats_.skip_count_ += num_internal_keys_skipped_;
@@ -190,6 +200,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
   assert(status_.ok());
   assert(direction_ == kForward);
   current_entry_is_merged_ = false;
+  is_value_projected_ = false;
 
   // How many times in a row we have skipped an entry with user key less than
   // or equal to saved_key_. We could skip these entries either because
@@ -211,6 +222,7 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
   bool reseek_done = false;
 
   is_blob_ = false;
+  ResetBlobValue();
 
   do {
     // Will update is_key_seqnum_zero_ as soon as we parsed the current key
@@ -329,21 +341,25 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
                 reseek_done = false;
                 PERF_COUNTER_ADD(internal_delete_skipped_count, 1);
               } else if (ikey_.type == kTypeBlobIndex) {
-                if (!allow_blob_) {
-                  ROCKS_LOG_ERROR(logger_, "Encounter unexpected blob index.");
-                  status_ = Status::NotSupported(
-                      "Encounter unexpected blob index. Please open DB with "
-                      "ROCKSDB_NAMESPACE::blob_db::BlobDB instead.");
-                  valid_ = false;
+                if (!SetBlobValueIfNeeded(ikey_.user_key, iter_.value())) {
                   return false;
                 }
-
-                is_blob_ = true;
+                if (AcceptValue(is_blob_value_ ? Slice(blob_value_)
+                                               : iter_.value())) {
+                  valid_ = true;
+                  return true;
+                }
+                // Rejected by the value filter, so skip the older versions of
+                // this key as well.
+                ResetBlobValue();
+                skipping_saved_key = true;
+              } else if (AcceptValue(iter_.value())) {
                 valid_ = true;
                 return true;
               } else {
-                valid_ = true;
-                return true;
+                // Rejected by the value filter, so skip the older versions of
+                // this key as well.
+                skipping_saved_key = true;
               }
             }
             break;
@@ -364,7 +380,18 @@ bool DBIter::FindNextUserEntryInternal(bool skipping_saved_key,
               // value
               current_entry_is_merged_ = true;
               valid_ = true;
-              return MergeValuesNewToOld();  // Go to a different state machine
+              // Go to a different state machine
+              if (!MergeValuesNewToOld() || AcceptValue(value())) {
+                return valid_;
+              }
+              // The merge result was rejected by the value filter. iter_ is
+              // already past the merged entries, and the operands pinned by
+              // MergeValuesNewToOld() are no longer needed.
+              ReleaseTempPinnedData();
+              valid_ = false;
+              current_entry_is_merged_ = false;
+              skipping_saved_key = true;
+              continue;
             }
             break;
           default:
@@ -568,6 +595,7 @@ bool DBIter::MergeValuesNewToOld() {
 }
 
 void DBIter::Prev() {
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   if (timestamp_size_ > 0) {
     valid_ = false;
     status_ = Status::NotSupported(
@@ -673,6 +701,7 @@ bool DBIter::ReverseToBackward() {
 }
 
 void DBIter::PrevInternal(const Slice* prefix) {
+  is_value_projected_ = false;
   while (iter_.Valid()) {
     saved_key_.SetUserKey(
         ExtractUserKey(iter_.key()),
@@ -710,8 +739,11 @@ void DBIter::PrevInternal(const Slice* prefix) {
     }
 
     if (valid_) {
-      // Found the value.
-      return;
+      if (AcceptValue(value())) {
+        // Found the value.
+        return;
+      }
+      valid_ = false;
     }
 
     if (TooManyInternalKeysSkipped(false)) {
@@ -831,6 +863,7 @@ bool DBIter::FindValueForCurrentKey() {
 
   Status s;
   is_blob_ = false;
+  ResetBlobValue();
   switch (last_key_entry_type) {
     case kTypeDeletion:
     case kTypeSingleDeletion:
@@ -870,15 +903,9 @@ bool DBIter::FindValueForCurrentKey() {
       // do nothing - we've already has value in pinned_value_
       break;
     case kTypeBlobIndex:
-      if (!allow_blob_) {
-        ROCKS_LOG_ERROR(logger_, "Encounter unexpected blob index.");
-        status_ = Status::NotSupported(
-            "Encounter unexpected blob index. Please open DB with "
-            "ROCKSDB_NAMESPACE::blob_db::BlobDB instead.");
-        valid_ = false;
+      if (!SetBlobValueIfNeeded(saved_key_.GetUserKey(), pinned_value_)) {
         return false;
       }
-      is_blob_ = true;
       break;
     default:
       assert(false);
@@ -911,6 +938,7 @@ bool DBIter::FindValueForCurrentKeyUsingSeek() {
   // Find the next value that's visible.
   ParsedInternalKey ikey;
   is_blob_ = false;
+  ResetBlobValue();
   while (true) {
     if (!iter_.Valid()) {
       valid_ = false;
@@ -948,14 +976,6 @@ bool DBIter::FindValueForCurrentKeyUsingSeek() {
     valid_ = false;
     return true;
   }
-  if (ikey.type == kTypeBlobIndex && !allow_blob_) {
-    ROCKS_LOG_ERROR(logger_, "Encounter unexpected blob index.");
-    status_ = Status::NotSupported(
-        "Encounter unexpected blob index. Please open DB with "
-        "ROCKSDB_NAMESPACE::blob_db::BlobDB instead.");
-    valid_ = false;
-    return false;
-  }
   if (!iter_.PrepareValue()) {
     valid_ = false;
     return false;
@@ -963,7 +983,10 @@ bool DBIter::FindValueForCurrentKeyUsingSeek() {
   if (ikey.type == kTypeValue || ikey.type == kTypeBlobIndex) {
     assert(iter_.iter()->IsValuePinned());
     pinned_value_ = iter_.value();
-    is_blob_ = (ikey.type == kTypeBlobIndex);
+    if (ikey.type == kTypeBlobIndex &&
+        !SetBlobValueIfNeeded(ikey.user_key, pinned_value_)) {
+      return false;
+    }
     valid_ = true;
     return true;
   }
@@ -1123,6 +1146,58 @@ bool DBIter::FindUserKeyBeforeSavedKey() {
   return true;
 }
 
+bool DBIter::AcceptValue(const Slice& value) {
+  if (is_blob_ || start_seqnum_ > 0) {
+    return true;
+  }
+  Slice user_key = saved_key_.GetUserKey();
+  user_key.remove_suffix(timestamp_size_);
+  if (iterate_value_filter_ && !iterate_value_filter_(user_key, value)) {
+    PERF_COUNTER_ADD(iter_value_filtered_count, 1);
+    return false;
+  }
+  if (iterate_value_projection_) {
+    projected_value_.clear();
+    iterate_value_projection_(user_key, value, &projected_value_);
+    is_value_projected_ = true;
+  }
+  return true;
+}
+
+bool DBIter::SetBlobValueIfNeeded(const Slice& user_key,
+                                  const Slice& blob_index) {
+  assert(!is_blob_value_);
+
+  if (allow_blob_) {
+    is_blob_ = true;
+    return true;
+  }
+
+  if (version_ == nullptr) {
+    ROCKS_LOG_ERROR(logger_, "Encounter unexpected blob index.");
+    status_ = Status::NotSupported(
+        "Encounter unexpected blob index. Please open DB with "
+        "ROCKSDB_NAMESPACE::blob_db::BlobDB instead.");
+    valid_ = false;
+    return false;
+  }
+
+  ReadOptions read_options;
+  read_options.read_tier = read_tier_;
+  read_options.verify_checksums = verify_checksums_;
+
+  const Status s =
+      version_->GetBlob(read_options, user_key, blob_index, &blob_value_);
+  if (!s.ok()) {
+    status_ = s;
+    valid_ = false;
+    return false;
+  }
+
+  is_blob_value_ = true;
+  return true;
+}
+
 bool DBIter::TooManyInternalKeysSkipped(bool increment) {
   if ((max_skippable_internal_keys_ > 0) &&
       (num_internal_keys_skipped_ > max_skippable_internal_keys_)) {
@@ -1190,6 +1265,7 @@ void DBIter::SetSavedKeyToSeekForPrevTarget(const Slice& target) {
 void DBIter::Seek(const Slice& target) {
   PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, env_);
   StopWatch sw(env_, statistics_, DB_SEEK);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
 
 #ifndef ROCKSDB_LITE
   if (db_impl_ != nullptr && cfd_ != nullptr) {
@@ -1251,6 +1327,7 @@ void DBIter::Seek(const Slice& target) {
 void DBIter::SeekForPrev(const Slice& target) {
   PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, env_);
   StopWatch sw(env_, statistics_, DB_SEEK);
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
 
 #ifndef ROCKSDB_LITE
   if (db_impl_ != nullptr && cfd_ != nullptr) {
@@ -1311,6 +1388,7 @@ void DBIter::SeekForPrev(const Slice& target) {
 }
 
 void DBIter::SeekToFirst() {
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   if (iterate_lower_bound_ != nullptr) {
     Seek(*iterate_lower_bound_);
     return;
@@ -1358,6 +1436,7 @@ void DBIter::SeekToFirst() {
 }
 
 void DBIter::SeekToLast() {
+  IOSTATS_IO_ACTIVITY_GUARD(IOActivity::kUserRead);
   if (timestamp_size_ > 0) {
     valid_ = false;
     status_ = Status::NotSupported(
@@ -1419,7 +1498,8 @@ Iterator* NewDBIterator(Env* env, const ReadOptions& read_options,
                         ColumnFamilyData* cfd, bool allow_blob) {
   DBIter* db_iter = new DBIter(
       env, read_options, cf_options, mutable_cf_options, user_key_comparator,
-      internal_iter, sequence, false, max_sequential_skip_in_iterations,
+      internal_iter, nullptr /* version */, sequence, false,
+      max_sequential_skip_in_iterations,
       read_callback, db_impl, cfd, allow_blob);
   return db_iter;
 }
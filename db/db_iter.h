@@ -114,7 +114,8 @@ class DBIter final : public Iterator {
   DBIter(Env* _env, const ReadOptions& read_options,
          const ImmutableCFOptions& cf_options,
          const MutableCFOptions& mutable_cf_options, const Comparator* cmp,
-         InternalIterator* iter, SequenceNumber s, bool arena_mode,
+         InternalIterator* iter, const Version* version, SequenceNumber s,
+         bool arena_mode,
          uint64_t max_sequential_skip_in_iterations,
          ReadCallback* read_callback, DBImpl* db_impl, ColumnFamilyData* cfd,
          bool allow_blob);
@@ -152,7 +153,11 @@ class DBIter final : public Iterator {
   }
   Slice value() const override {
     assert(valid_);
-    if (current_entry_is_merged_) {
+    if (is_value_projected_) {
+      return projected_value_;
+    } else if (is_blob_value_) {
+      return blob_value_;
+    } else if (current_entry_is_merged_) {
       // If pinned_value_ is set then the result of merge operator is one of
       // the merge operands and we should return it.
       return pinned_value_.data() ? pinned_value_ : saved_value_;
@@ -231,6 +236,19 @@ class DBIter final : public Iterator {
   // entry can be found within the prefix.
   void PrevInternal(const Slice* prefix);
   bool TooManyInternalKeysSkipped(bool increment = true);
+  // Evaluates iterate_value_filter_ on the entry at saved_key_ with the given
+  // value. Returns false if the entry is rejected; otherwise applies
+  // iterate_value_projection_, if any, and returns true.
+  bool AcceptValue(const Slice& value);
+  // Handles the blob index `blob_index` of user_key at the current position:
+  // with allow_blob_, marks the entry as a blob; otherwise, reads the value
+  // from the blob file into blob_value_. Returns false and sets status_ on
+  // failure.
+  bool SetBlobValueIfNeeded(const Slice& user_key, const Slice& blob_index);
+  void ResetBlobValue() {
+    is_blob_value_ = false;
+    blob_value_.Reset();
+  }
   bool IsVisible(SequenceNumber sequence, const Slice& ts,
                  bool* more_recent = nullptr);
 
@@ -305,6 +323,13 @@ class DBIter final : public Iterator {
   uint64_t num_internal_keys_skipped_;
   const Slice* iterate_lower_bound_;
   const Slice* iterate_upper_bound_;
+  // Set from ReadOptions. The projected value of the current entry is stored
+  // in projected_value_ when is_value_projected_ is true.
+  const std::function<bool(const Slice&, const Slice&)> iterate_value_filter_;
+  const std::function<void(const Slice&, const Slice&, std::string*)>
+      iterate_value_projection_;
+  std::string projected_value_;
+  bool is_value_projected_;
 
   // The prefix of the seek key. It is only used when prefix_same_as_start_
   // is true and prefix extractor is not null. In Next() or Prev(), current keys
@@ -330,6 +355,15 @@ class DBIter final : public Iterator {
   const bool expect_total_order_inner_iter_;
   bool allow_blob_;
   bool is_blob_;
+  // The version whose blob files the blob indexes written by flush and
+  // compaction are resolved against; null for iterators that cannot resolve
+  // them (e.g. tailing iterators). When is_blob_value_ is set, the value of
+  // the current entry is in blob_value_.
+  const Version* version_;
+  const ReadTier read_tier_;
+  const bool verify_checksums_;
+  PinnableSlice blob_value_;
+  bool is_blob_value_;
   bool arena_mode_;
   // List of operands for merge operator.
   MergeContext merge_context_;
@@ -17,6 +17,7 @@
 #include "rocksdb/iostats_context.h"
 #include "rocksdb/perf_context.h"
 #include "table/block_based/flush_block_policy.h"
+#include "utilities/merge_operators.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -2881,6 +2882,142 @@ TEST_P(DBIteratorTest, IterateWithLowerBoundAcrossFileBoundary) {
   ASSERT_OK(iter->status());
 }
 
+TEST_P(DBIteratorTest, PartitionedIterators) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_OK(Put(Key(i), RandomString(&rnd, 100)));
+    if (i % 250 == 249) {
+      ASSERT_OK(Flush());
+    }
+  }
+  ASSERT_OK(Put(Key(1000), "mem"));
+
+  std::vector<Iterator*> iters;
+  ASSERT_TRUE(db_->NewPartitionedIterators(ReadOptions(),
+                                           db_->DefaultColumnFamily(), 0,
+                                           &iters)
+                  .IsInvalidArgument());
+  ASSERT_OK(db_->NewPartitionedIterators(
+      ReadOptions(), db_->DefaultColumnFamily(), 4, &iters));
+  ASSERT_GT(iters.size(), 1);
+  ASSERT_LE(iters.size(), 4);
+
+  // The partitions share the state of the DB at creation time
+  ASSERT_OK(Put(Key(500), "new"));
+  ASSERT_OK(Put(Key(2000), "new"));
+  ASSERT_OK(Flush());
+
+  int expected = 0;
+  for (auto* iter : iters) {
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+      ASSERT_NE("new", iter->value().ToString());
+      expected++;
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_GT(count, 0);
+    delete iter;
+  }
+  ASSERT_EQ(1001, expected);
+
+  // Partitions stay within the bounds of the ReadOptions
+  std::string lower = Key(100);
+  std::string upper = Key(900);
+  Slice lower_bound(lower);
+  Slice upper_bound(upper);
+  ReadOptions ro;
+  ro.iterate_lower_bound = &lower_bound;
+  ro.iterate_upper_bound = &upper_bound;
+  ro.readahead_size = 64 << 10;
+  ASSERT_OK(db_->NewPartitionedIterators(ro, db_->DefaultColumnFamily(), 3,
+                                         &iters));
+  ASSERT_GT(iters.size(), 1);
+  ASSERT_LE(iters.size(), 3);
+  expected = 100;
+  for (auto* iter : iters) {
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(Key(expected), iter->key().ToString());
+      expected++;
+    }
+    ASSERT_OK(iter->status());
+    delete iter;
+  }
+  ASSERT_EQ(900, expected);
+}
+
+TEST_P(DBIteratorTest, IterateValueFilterAndProjection) {
+  Options options = CurrentOptions();
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_OK(Put(Key(i), (i % 3 == 0 ? "keep-" : "drop-") + ToString(i)));
+  }
+  ASSERT_OK(Flush());
+  // A newer rejected value hides an older accepted one, and a merge result is
+  // filtered on the merged value.
+  ASSERT_OK(Put(Key(3), "drop-3"));
+  ASSERT_OK(Merge(Key(4), "x"));
+  ASSERT_OK(Put(Key(5), "keep"));
+  ASSERT_OK(Merge(Key(5), "y"));
+
+  ReadOptions ro;
+  ro.iterate_value_filter = [](const Slice& /*key*/, const Slice& value) {
+    return value.starts_with("keep");
+  };
+  ro.iterate_value_projection = [](const Slice& key, const Slice& value,
+                                   std::string* projected) {
+    projected->assign(key.data(), key.size());
+    projected->append(":");
+    projected->append(value.data(), 4);
+  };
+
+  get_perf_context()->Reset();
+  SetPerfLevel(kEnableCount);
+  std::unique_ptr<Iterator> iter(NewIterator(ro));
+  std::vector<std::string> forward;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(iter->key().ToString() + ":keep", iter->value().ToString());
+    forward.push_back(iter->key().ToString());
+  }
+  ASSERT_OK(iter->status());
+  std::vector<std::string> expected = {Key(0),  Key(5),  Key(6), Key(9),
+                                       Key(12), Key(15), Key(18)};
+  ASSERT_EQ(expected, forward);
+  ASSERT_EQ(13, get_perf_context()->iter_value_filtered_count);
+
+  std::vector<std::string> backward;
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+    ASSERT_EQ(iter->key().ToString() + ":keep", iter->value().ToString());
+    backward.insert(backward.begin(), iter->key().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(expected, backward);
+
+  iter->Seek(Key(1));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(5), iter->key().ToString());
+  iter->Prev();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(0), iter->key().ToString());
+  iter->SeekForPrev(Key(8));
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(6), iter->key().ToString());
+  iter->Next();
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(Key(9), iter->key().ToString());
+  SetPerfLevel(kDisable);
+}
+
 INSTANTIATE_TEST_CASE_P(DBIteratorTestInstance, DBIteratorTest,
                         testing::Values(true, false));
 
@@ -656,6 +656,43 @@ TEST_F(DBRangeDelTest, GetCoveredKeyFromMutableMemtable) {
   } while (ChangeOptions(kRangeDelSkipConfigs));
 }
 
+TEST_F(DBRangeDelTest, ManyRangeDeletionsInMutableMemtable) {
+  DestroyAndReopen(CurrentOptions());
+  const int kNumKeys = 100;
+  std::vector<const Snapshot*> snapshots;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  // Interleave small range deletions with reads, so the fragmented tombstones
+  // of the memtable are rebuilt between reads.
+  for (int i = 0; i < kNumKeys; i += 2) {
+    snapshots.push_back(db_->GetSnapshot());
+    ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                               Key(i), Key(i + 1)));
+    ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+    ASSERT_EQ("val", Get(Key(i + 1)));
+    ASSERT_EQ("val", Get(Key(i), snapshots.back()));
+  }
+  for (int i = 0; i < kNumKeys; i += 2) {
+    ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+    ASSERT_EQ("val", Get(Key(i + 1)));
+    // Every snapshot sees the keys deleted after it was taken.
+    ASSERT_EQ(i >= kNumKeys / 2 ? "val" : "NOT_FOUND",
+              Get(Key(i), snapshots[kNumKeys / 4]));
+  }
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  int num_keys = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(Key(2 * num_keys + 1), iter->key());
+    ++num_keys;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kNumKeys / 2, num_keys);
+  for (auto* snapshot : snapshots) {
+    db_->ReleaseSnapshot(snapshot);
+  }
+}
+
 TEST_F(DBRangeDelTest, GetCoveredKeyFromImmutableMemtable) {
   do {
     Options opts = CurrentOptions();
@@ -679,6 +716,58 @@ TEST_F(DBRangeDelTest, GetCoveredKeyFromImmutableMemtable) {
   } while (ChangeOptions(kRangeDelSkipConfigs));
 }
 
+TEST_F(DBRangeDelTest, GetCoveredKeysFromImmutableMemtableAtSnapshot) {
+  Options opts = CurrentOptions();
+  opts.max_write_buffer_number = 3;
+  opts.min_write_buffer_number_to_merge = 2;
+  opts.memtable_factory.reset(new SpecialSkipListFactory(3));
+  DestroyAndReopen(opts);
+
+  ASSERT_OK(Put("a", "val"));
+  ASSERT_OK(Put("c", "val"));
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "b",
+                             "d"));
+  // Overflow the memtable so the range tombstone is served from the
+  // immutable memtable.
+  ASSERT_OK(Put("e", "val"));
+  ASSERT_OK(Put("f", "val"));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  uint64_t num_imm = 0;
+  ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kNumImmutableMemTable,
+                                  &num_imm));
+  ASSERT_EQ(1, num_imm);
+
+  ASSERT_EQ("val", Get("a"));
+  ASSERT_EQ("NOT_FOUND", Get("c"));
+  ASSERT_EQ("val", Get("c", snapshot));
+
+  std::vector<Slice> keys = {"a", "c", "e"};
+  std::vector<std::string> values;
+  std::vector<Status> statuses = db_->MultiGet(ReadOptions(), keys, &values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_TRUE(statuses[1].IsNotFound());
+  ASSERT_OK(statuses[2]);
+
+  ReadOptions snapshot_read_opts;
+  snapshot_read_opts.snapshot = snapshot;
+  statuses = db_->MultiGet(snapshot_read_opts, keys, &values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_OK(statuses[1]);
+  ASSERT_EQ("val", values[1]);
+  ASSERT_TRUE(statuses[2].IsNotFound());
+  db_->ReleaseSnapshot(snapshot);
+
+  // A range tombstone in the mutable memtable is fragmented once per batch.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "e",
+                             "g"));
+  keys = {"a", "e", "f"};
+  statuses = db_->MultiGet(ReadOptions(), keys, &values);
+  ASSERT_OK(statuses[0]);
+  ASSERT_TRUE(statuses[1].IsNotFound());
+  ASSERT_TRUE(statuses[2].IsNotFound());
+}
+
 TEST_F(DBRangeDelTest, GetCoveredKeyFromSst) {
   do {
     DestroyAndReopen(CurrentOptions());
@@ -1664,6 +1753,189 @@ TEST_F(DBRangeDelTest, OverlappedKeys) {
   ASSERT_EQ(0, NumTableFilesAtLevel(1));
 }
 
+TEST_F(DBRangeDelTest, DeletionRunConvertedToRangeTombstone) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compaction_deletion_run_threshold = 10;
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 100;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+
+  for (int i = 20; i < 70; ++i) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  ASSERT_OK(Flush());
+  dbfull()->TEST_CompactRange(0, nullptr, nullptr, nullptr,
+                              true /* disallow_trivial_move */);
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+
+  // Deletions of Key(20) to Key(68) are replaced by one range tombstone, and
+  // the deletion of Key(69) is kept.
+  TablePropertiesCollection tables;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&tables));
+  uint64_t num_deletions = 0;
+  uint64_t num_range_deletions = 0;
+  for (const auto& table : tables) {
+    num_deletions += table.second->num_deletions;
+    num_range_deletions += table.second->num_range_deletions;
+  }
+  ASSERT_EQ(1, num_range_deletions);
+  ASSERT_EQ(2, num_deletions);
+
+  for (int i = 0; i < kNumKeys; ++i) {
+    if (i >= 20 && i < 70) {
+      ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+    } else {
+      ASSERT_EQ("val", Get(Key(i)));
+    }
+  }
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  int num_keys = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_keys;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kNumKeys - 50, num_keys);
+}
+
+TEST_F(DBRangeDelTest, DeletionRunNotConvertedOverLiveKey) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compaction_deletion_run_threshold = 10;
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 100;
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+
+  // Key(45) is not deleted, and only lives in L2, so the deletions around it
+  // are adjacent in the output of the L0->L1 compaction.
+  for (int i = 20; i < 70; ++i) {
+    if (i != 45) {
+      ASSERT_OK(Delete(Key(i)));
+    }
+  }
+  ASSERT_OK(Flush());
+  dbfull()->TEST_CompactRange(0, nullptr, nullptr, nullptr,
+                              true /* disallow_trivial_move */);
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+
+  TablePropertiesCollection tables;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&tables));
+  uint64_t num_range_deletions = 0;
+  for (const auto& table : tables) {
+    num_range_deletions += table.second->num_range_deletions;
+  }
+  ASSERT_EQ(0, num_range_deletions);
+  ASSERT_EQ("val", Get(Key(45)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(44)));
+}
+
+TEST_F(DBRangeDelTest, DeletionRunSplitBySnapshot) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compaction_deletion_run_threshold = 10;
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+
+  // The snapshot sees the first half of the deletions but not the second, so
+  // each half is converted on its own.
+  for (int i = 20; i < 45; ++i) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  for (int i = 45; i < 70; ++i) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  ASSERT_OK(Flush());
+  dbfull()->TEST_CompactRange(0, nullptr, nullptr, nullptr,
+                              true /* disallow_trivial_move */);
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+
+  TablePropertiesCollection tables;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&tables));
+  uint64_t num_range_deletions = 0;
+  for (const auto& table : tables) {
+    num_range_deletions += table.second->num_range_deletions;
+  }
+  ASSERT_EQ(2, num_range_deletions);
+
+  ReadOptions read_opts;
+  read_opts.snapshot = snapshot;
+  for (int i = 0; i < 100; ++i) {
+    std::string value;
+    Status s = db_->Get(read_opts, Key(i), &value);
+    if (i >= 20 && i < 45) {
+      ASSERT_TRUE(s.IsNotFound());
+    } else {
+      ASSERT_OK(s);
+    }
+    ASSERT_EQ(i >= 20 && i < 70 ? "NOT_FOUND" : "val", Get(Key(i)));
+  }
+  db_->ReleaseSnapshot(snapshot);
+}
+
+TEST_F(DBRangeDelTest, DeletionRunCutAtMaxRunBytes) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.compaction_deletion_run_threshold = 10;
+  DestroyAndReopen(options);
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+
+  // Runs are cut after 25 deletions, so the run of 50 deletions becomes two
+  // range tombstones, and the last deletion of each is kept.
+  const size_t deletion_size = Key(0).size() + 8;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DeletionRunConverter::DeletionRunConverter", [&](void* arg) {
+        *static_cast<size_t*>(arg) = 25 * deletion_size;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  for (int i = 20; i < 70; ++i) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  ASSERT_OK(Flush());
+  dbfull()->TEST_CompactRange(0, nullptr, nullptr, nullptr,
+                              true /* disallow_trivial_move */);
+  ASSERT_EQ(1, NumTableFilesAtLevel(1));
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  TablePropertiesCollection tables;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&tables));
+  uint64_t num_deletions = 0;
+  uint64_t num_range_deletions = 0;
+  for (const auto& table : tables) {
+    num_deletions += table.second->num_deletions;
+    num_range_deletions += table.second->num_range_deletions;
+  }
+  ASSERT_EQ(2, num_range_deletions);
+  ASSERT_EQ(4, num_deletions);
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(i >= 20 && i < 70 ? "NOT_FOUND" : "val", Get(Key(i)));
+  }
+}
+
 #endif  // ROCKSDB_LITE
 
 }  // namespace ROCKSDB_NAMESPACE
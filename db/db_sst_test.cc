@@ -146,6 +146,55 @@ TEST_F(DBSSTTest, SkipCheckingSSTFileSizesOnDBOpen) {
   ASSERT_EQ("choo", Get("pika"));
 }
 
+// With DBOptions::skip_opening_table_readers_on_db_open = true, DB::Open()
+// doesn't open any sst file even with max_open_files = -1, and each file is
+// opened on its first read.
+TEST_F(DBSSTTest, SkipOpeningTableReadersOnDBOpen) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_open_files = -1;
+  options.skip_stats_update_on_db_open = true;
+  DestroyAndReopen(options);
+
+  const int kNumFiles = 4;
+  for (int i = 0; i < kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "val" + ToString(i)));
+    ASSERT_OK(Flush());
+  }
+
+  std::atomic<int> num_opened(0);
+  SyncPoint::GetInstance()->SetCallBack(
+      "TableCache::GetTableReader:0",
+      [&](void* /*arg*/) { num_opened.fetch_add(1); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  Reopen(options);
+  ASSERT_EQ(kNumFiles, num_opened.load());
+
+  num_opened.store(0);
+  options.skip_opening_table_readers_on_db_open = true;
+  Reopen(options);
+  ASSERT_EQ(0, num_opened.load());
+
+  ASSERT_EQ("val0", Get(Key(0)));
+  ASSERT_EQ(1, num_opened.load());
+  // The file stays open in the table cache.
+  ASSERT_EQ("val0", Get(Key(0)));
+  ASSERT_EQ(1, num_opened.load());
+  for (int i = 0; i < kNumFiles; ++i) {
+    ASSERT_EQ("val" + ToString(i), Get(Key(i)));
+  }
+  ASSERT_EQ(kNumFiles, num_opened.load());
+
+  // Files written after DB::Open() are opened right away.
+  ASSERT_OK(Put(Key(kNumFiles), "val"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(kNumFiles + 1, num_opened.load());
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 #ifndef ROCKSDB_LITE
 TEST_F(DBSSTTest, DontDeleteMovedFile) {
   // This test triggers move compaction and verifies that the file is not
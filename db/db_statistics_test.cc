@@ -140,6 +140,44 @@ TEST_F(DBStatisticsTest, ResetStats) {
   }
 }
 
+TEST_F(DBStatisticsTest, FileReadStatsByIOClass) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  // Read every block from the file.
+  table_options.no_block_cache = true;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Two overlapping files, so that they cannot be trivially moved.
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_OK(Put("key0", "value"));
+    ASSERT_OK(Put("key1", "value"));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  Reopen(options);
+  ASSERT_EQ("value", Get("key0"));
+
+  for (uint32_t type :
+       {FILE_READ_DATA_BLOCK_MICROS, FILE_READ_INDEX_BLOCK_MICROS,
+        FILE_READ_FILTER_BLOCK_MICROS, FILE_READ_METADATA_BLOCK_MICROS,
+        FILE_READ_USER_MICROS, FILE_READ_FLUSH_MICROS,
+        FILE_READ_COMPACTION_MICROS, FILE_READ_RECOVERY_MICROS,
+        FILE_READ_USER_BYTES, FILE_READ_FLUSH_BYTES,
+        FILE_READ_COMPACTION_BYTES, FILE_READ_RECOVERY_BYTES}) {
+    HistogramData histogram_data;
+    options.statistics->histogramData(type, &histogram_data);
+    ASSERT_GT(histogram_data.count, 0) << type;
+  }
+  HistogramData histogram_data;
+  options.statistics->histogramData(FILE_READ_USER_BYTES, &histogram_data);
+  ASSERT_GT(histogram_data.max, 0.0);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
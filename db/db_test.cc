@@ -3726,6 +3726,56 @@ TEST_F(DBTest, FIFOCompactionWithTTLTest) {
               options.compaction_options_fifo.max_table_files_size);
   }
 }
+
+// Files whose table readers were not opened on DB::Open() must not be dropped
+// as expired before their age is known.
+TEST_F(DBTest, FIFOCompactionWithTTLAndLazyTableReaders) {
+  Options options;
+  options.compaction_style = kCompactionStyleFIFO;
+  options.write_buffer_size = 10 << 10;  // 10KB
+  options.arena_block_size = 4096;
+  options.compression = kNoCompression;
+  options.create_if_missing = true;
+  env_->time_elapse_only_sleep_ = false;
+  options.env = env_;
+  env_->addon_time_.store(0);
+  options.compaction_options_fifo.max_table_files_size = 150 << 10;  // 150KB
+  options.compaction_options_fifo.allow_compaction = false;
+  options.ttl = 1 * 60 * 60;  // 1 hour
+  options = CurrentOptions(options);
+  options.max_open_files = -1;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int i = 0; i < 10; i++) {
+    // Generate and flush a file about 10KB.
+    for (int j = 0; j < 10; j++) {
+      ASSERT_OK(Put(ToString(i * 20 + j), RandomString(&rnd, 980)));
+    }
+    Flush();
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), 10);
+
+  options.skip_opening_table_readers_on_db_open = true;
+  Reopen(options);
+
+  // None of the files has expired yet.
+  ASSERT_OK(dbfull()->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumTableFilesAtLevel(0), 10);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      ASSERT_NE("NOT_FOUND", Get(ToString(i * 20 + j)));
+    }
+  }
+
+  // Once they expire, the ages recorded in the MANIFEST are enough to drop
+  // them.
+  Reopen(options);
+  env_->addon_time_.fetch_add(2 * 60 * 60);
+  ASSERT_OK(dbfull()->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+}
 #endif  // ROCKSDB_LITE
 
 #ifndef ROCKSDB_LITE
@@ -6419,6 +6469,94 @@ TEST_F(DBTest, PinnableSliceAndRowCache) {
       1);
 }
 
+TEST_F(DBTest, DBRowCache) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.db_row_cache = NewLRUCache(8192);
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "bar"));
+  ASSERT_OK(Merge("merged", "a"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Merge("merged", "b"));
+  ASSERT_OK(Flush());
+
+  ASSERT_EQ(Get("foo"), "bar");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 0);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 1);
+  ASSERT_EQ(Get("foo"), "bar");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 1);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 1);
+
+  // "Not found" results are cached too.
+  ASSERT_EQ(Get("missing"), "NOT_FOUND");
+  ASSERT_EQ(Get("missing"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 2);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 2);
+
+  // So are the results of merging operands from several files.
+  ASSERT_EQ(Get("merged"), "a,b");
+  ASSERT_EQ(Get("merged"), "a,b");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 3);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 3);
+
+  // Keys found in the memtable do not consult the cache, and reads at a
+  // snapshot bypass it.
+  ASSERT_OK(Put("foo", "baz"));
+  const Snapshot* snapshot = db_->GetSnapshot();
+  ASSERT_OK(Merge("merged", "c"));
+  ASSERT_EQ(Get("foo"), "baz");
+  ASSERT_EQ(Get("merged"), "a,b,c");
+  ASSERT_EQ(Get("missing", snapshot), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 3);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 3);
+  db_->ReleaseSnapshot(snapshot);
+
+  // A flush installs a new SuperVersion, which invalidates cached results.
+  ASSERT_OK(Flush());
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_INVALIDATION), 0);
+  ASSERT_EQ(Get("foo"), "baz");
+  ASSERT_EQ(Get("merged"), "a,b,c");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_INVALIDATION), 2);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 5);
+  ASSERT_EQ(Get("foo"), "baz");
+  ASSERT_EQ(Get("merged"), "a,b,c");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 5);
+
+  // Including "not found" results for keys that now exist.
+  ASSERT_OK(Put("missing", "found"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get("missing"), "found");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_INVALIDATION), 3);
+}
+
+TEST_F(DBTest, DBRowCacheIgnoreRangeDeletions) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.db_row_cache = NewLRUCache(8192);
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "bar"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(), "a",
+                             "z"));
+  ASSERT_OK(Flush());
+
+  // A read that ignores range deletions sees the deleted value, which must
+  // not be cached for the reads that do not.
+  ReadOptions read_options;
+  read_options.ignore_range_deletions = true;
+  std::string value;
+  ASSERT_OK(db_->Get(read_options, "foo", &value));
+  ASSERT_EQ("bar", value);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 0);
+
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(Get("foo"), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_MISS), 1);
+  ASSERT_EQ(TestGetTickerCount(options, DB_ROW_CACHE_HIT), 1);
+}
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBTest, DeletingOldWalAfterDrop) {
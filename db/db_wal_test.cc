@@ -1226,6 +1226,53 @@ TEST_F(DBWALTest, kSkipAnyCorruptedRecords) {
   }
 }
 
+// Test scope:
+// - We expect pipelined WAL recovery to recover the same data and fail in the
+//   same cases as the regular one, for clean and corrupted WALs alike
+TEST_F(DBWALTest, PipelinedWALRecovery) {
+  const int jstart = RecoveryTestHelper::kWALFileOffset;
+  const int jend = jstart + RecoveryTestHelper::kWALFilesCount;
+
+  for (auto mode : {WALRecoveryMode::kTolerateCorruptedTailRecords,
+                    WALRecoveryMode::kAbsoluteConsistency,
+                    WALRecoveryMode::kPointInTimeRecovery,
+                    WALRecoveryMode::kSkipAnyCorruptedRecords}) {
+    for (auto trunc : {true, false}) { /* Corruption style */
+      for (int i = -1; i < 4; i++) {   /* Corruption offset, -1 for none */
+        if (i < 0 && trunc) {
+          continue;
+        }
+        for (int j = jstart; j < jend; j += 3) { /* WAL file */
+          size_t recovered_row_count[2];
+          bool opened[2];
+          for (bool pipelined : {false, true}) {
+            Options options = CurrentOptions();
+            RecoveryTestHelper::FillData(this, &options);
+            if (i >= 0) {
+              RecoveryTestHelper::CorruptWAL(this, options, /*off=*/i * .3,
+                                             /*len%=*/.1, j, trunc);
+            }
+            options.wal_recovery_mode = mode;
+            options.enable_pipelined_wal_recovery = pipelined;
+            options.create_if_missing = false;
+            opened[pipelined] = TryReopen(options).ok();
+            recovered_row_count[pipelined] =
+                opened[pipelined] ? RecoveryTestHelper::GetData(this) : 0;
+          }
+          ASSERT_EQ(opened[false], opened[true]);
+          ASSERT_EQ(recovered_row_count[false], recovered_row_count[true]);
+          if (i < 0) {
+            ASSERT_TRUE(opened[true]);
+            ASSERT_EQ(RecoveryTestHelper::kWALFilesCount *
+                          RecoveryTestHelper::kKeysPerWALFile,
+                      recovered_row_count[true]);
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST_F(DBWALTest, AvoidFlushDuringRecovery) {
   Options options = CurrentOptions();
   options.disable_auto_compactions = true;
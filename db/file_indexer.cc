@@ -73,7 +73,9 @@ void FileIndexer::GetNextLevelIndex(const size_t level, const size_t file_index,
 }
 
 void FileIndexer::UpdateIndex(Arena* arena, const size_t num_levels,
-                              std::vector<FileMetaData*>* const files) {
+                              std::vector<FileMetaData*>* const files,
+                              const FileIndexer* base,
+                              const std::vector<bool>& unchanged_levels) {
   if (files == nullptr) {
     return;
   }
@@ -106,6 +108,15 @@ void FileIndexer::UpdateIndex(Arena* arena, const size_t num_levels,
     mem = arena->AllocateAligned(upper_size * sizeof(IndexUnit));
     index_level.index_units = new (mem) IndexUnit[upper_size];
 
+    if (base != nullptr && level + 1 < unchanged_levels.size() &&
+        unchanged_levels[level] && unchanged_levels[level + 1] &&
+        base->LevelIndexSize(level) == index_level.num_index) {
+      std::copy(base->next_level_index_[level].index_units,
+                base->next_level_index_[level].index_units + upper_size,
+                index_level.index_units);
+      continue;
+    }
+
     CalculateLB(
         upper_files, lower_files, &index_level,
         [this](const FileMetaData* a, const FileMetaData* b) -> int {
@@ -55,8 +55,13 @@ class FileIndexer {
                          const int cmp_smallest, const int cmp_largest,
                          int32_t* left_bound, int32_t* right_bound) const;
 
+  // If `base` is set, the index of a level whose files, and those of the next
+  // level, are flagged in `unchanged_levels` as the same as when `base` was
+  // built is copied from `base` instead of being recomputed.
   void UpdateIndex(Arena* arena, const size_t num_levels,
-                   std::vector<FileMetaData*>* const files);
+                   std::vector<FileMetaData*>* const files,
+                   const FileIndexer* base = nullptr,
+                   const std::vector<bool>& unchanged_levels = {});
 
   enum {
     // MSVC version 1800 still does not have constexpr for ::max()
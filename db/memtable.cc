@@ -84,6 +84,8 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
           comparator_, &arena_, nullptr /* transform */, ioptions.info_log,
           column_family_id)),
       is_range_del_table_empty_(true),
+      num_range_deletes_(0),
+      fragmented_range_tombstones_ready_(false),
       data_size_(0),
       num_entries_(0),
       num_deletes_(0),
@@ -428,19 +430,69 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIterator(
       is_range_del_table_empty_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
-  auto* unfragmented_iter = new MemTableIterator(
-      *this, read_options, nullptr /* arena */, true /* use_range_del_table */);
-  if (unfragmented_iter == nullptr) {
-    return nullptr;
+  const FragmentedRangeTombstoneList* fragmented_tombstones =
+      GetFragmentedRangeTombstones();
+  if (fragmented_tombstones != nullptr) {
+    return new FragmentedRangeTombstoneIterator(
+        fragmented_tombstones, comparator_.comparator, read_seq);
+  }
+  return new FragmentedRangeTombstoneIterator(
+      GetMutableFragmentedRangeTombstones(), comparator_.comparator, read_seq);
+}
+
+SequenceNumber MemTable::MaxCoveringTombstoneSeqnum(
+    const ReadOptions& read_options, const Slice& user_key,
+    SequenceNumber read_seq) {
+  if (read_options.ignore_range_deletions ||
+      is_range_del_table_empty_.load(std::memory_order_relaxed)) {
+    return 0;
+  }
+  const Comparator* ucmp = comparator_.comparator.user_comparator();
+  const FragmentedRangeTombstoneList* fragmented_tombstones =
+      GetFragmentedRangeTombstones();
+  if (fragmented_tombstones != nullptr) {
+    return fragmented_tombstones->MaxCoveringTombstoneSeqnum(user_key, ucmp,
+                                                             read_seq);
+  }
+  return GetMutableFragmentedRangeTombstones()->MaxCoveringTombstoneSeqnum(
+      user_key, ucmp, read_seq);
+}
+
+std::shared_ptr<const FragmentedRangeTombstoneList>
+MemTable::GetMutableFragmentedRangeTombstones() {
+  assert(!is_range_del_table_empty_.load(std::memory_order_relaxed));
+  uint64_t num_range_deletes =
+      num_range_deletes_.load(std::memory_order_acquire);
+  std::shared_ptr<RangeTombstoneCache> cache =
+      std::atomic_load(&range_tombstone_cache_);
+  if (cache == nullptr || cache->num_range_deletes < num_range_deletes) {
+    MutexLock l(&range_tombstone_cache_mutex_);
+    cache = std::atomic_load(&range_tombstone_cache_);
+    if (cache == nullptr || cache->num_range_deletes < num_range_deletes) {
+      // Load the count before iterating, so that every range deletion it
+      // accounts for is already visible in range_del_table_.
+      uint64_t num_fragmented =
+          num_range_deletes_.load(std::memory_order_acquire);
+      cache = std::make_shared<RangeTombstoneCache>(
+          std::unique_ptr<InternalIterator>(
+              new MemTableIterator(*this, ReadOptions(), nullptr /* arena */,
+                                   true /* use_range_del_table */)),
+          comparator_.comparator, num_fragmented);
+      std::atomic_store(&range_tombstone_cache_, cache);
+    }
   }
-  auto fragmented_tombstone_list =
-      std::make_shared<FragmentedRangeTombstoneList>(
-          std::unique_ptr<InternalIterator>(unfragmented_iter),
-          comparator_.comparator);
-
-  auto* fragmented_iter = new FragmentedRangeTombstoneIterator(
-      fragmented_tombstone_list, comparator_.comparator, read_seq);
-  return fragmented_iter;
+  return std::shared_ptr<const FragmentedRangeTombstoneList>(
+      cache, &cache->tombstones);
+}
+
+void MemTable::ConstructFragmentedRangeTombstones() {
+  assert(!fragmented_range_tombstones_ready_.load(std::memory_order_relaxed));
+  if (is_range_del_table_empty_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // No more range deletions can be added, so the cache is final.
+  fragmented_range_tombstones_ = GetMutableFragmentedRangeTombstones();
+  fragmented_range_tombstones_ready_.store(true, std::memory_order_release);
 }
 
 port::RWMutex* MemTable::GetLock(const Slice& key) {
@@ -584,6 +636,7 @@ bool MemTable::Add(SequenceNumber s, ValueType type,
     }
   }
   if (type == kTypeRangeDeletion) {
+    num_range_deletes_.fetch_add(1, std::memory_order_release);
     is_range_del_table_empty_.store(false, std::memory_order_relaxed);
   }
   UpdateOldestKeyTime();
@@ -789,14 +842,10 @@ bool MemTable::Get(const LookupKey& key, std::string* value,
   }
   PERF_TIMER_GUARD(get_from_memtable_time);
 
-  std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
-      NewRangeTombstoneIterator(read_opts,
-                                GetInternalKeySeqno(key.internal_key())));
-  if (range_del_iter != nullptr) {
-    *max_covering_tombstone_seq =
-        std::max(*max_covering_tombstone_seq,
-                 range_del_iter->MaxCoveringTombstoneSeqnum(key.user_key()));
-  }
+  *max_covering_tombstone_seq = std::max(
+      *max_covering_tombstone_seq,
+      MaxCoveringTombstoneSeqnum(read_opts, key.user_key(),
+                                 GetInternalKeySeqno(key.internal_key())));
 
   Slice user_key = key.user_key();
   bool found_final_value = false;
@@ -907,17 +956,28 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       idx++;
     }
   }
+  // Look up the fragmented range tombstones of a mutable memtable once for
+  // the whole batch rather than once per key.
+  const FragmentedRangeTombstoneList* fragmented_tombstones = nullptr;
+  std::shared_ptr<const FragmentedRangeTombstoneList> mutable_tombstones;
+  if (!read_options.ignore_range_deletions &&
+      !is_range_del_table_empty_.load(std::memory_order_relaxed)) {
+    fragmented_tombstones = GetFragmentedRangeTombstones();
+    if (fragmented_tombstones == nullptr) {
+      mutable_tombstones = GetMutableFragmentedRangeTombstones();
+      fragmented_tombstones = mutable_tombstones.get();
+    }
+  }
   for (auto iter = temp_range.begin(); iter != temp_range.end(); ++iter) {
     SequenceNumber seq = kMaxSequenceNumber;
     bool found_final_value{false};
     bool merge_in_progress = iter->s->IsMergeInProgress();
-    std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
-        NewRangeTombstoneIterator(
-            read_options, GetInternalKeySeqno(iter->lkey->internal_key())));
-    if (range_del_iter != nullptr) {
+    if (fragmented_tombstones != nullptr) {
       iter->max_covering_tombstone_seq = std::max(
           iter->max_covering_tombstone_seq,
-          range_del_iter->MaxCoveringTombstoneSeqnum(iter->lkey->user_key()));
+          fragmented_tombstones->MaxCoveringTombstoneSeqnum(
+              iter->lkey->user_key(), comparator_.comparator.user_comparator(),
+              GetInternalKeySeqno(iter->lkey->internal_key())));
     }
     GetFromTable(*(iter->lkey), iter->max_covering_tombstone_seq, true,
                  callback, is_blob, iter->value->GetSelf(), iter->timestamp,
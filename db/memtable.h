@@ -174,6 +174,14 @@ class MemTable {
   FragmentedRangeTombstoneIterator* NewRangeTombstoneIterator(
       const ReadOptions& read_options, SequenceNumber read_seq);
 
+  // Returns the largest sequence number, no larger than read_seq, of the range
+  // tombstones in this memtable that cover user_key, or 0 if there is none.
+  // This is a binary search over the fragmented tombstones, which are only
+  // rebuilt when range deletions were added since the last read.
+  SequenceNumber MaxCoveringTombstoneSeqnum(const ReadOptions& read_options,
+                                            const Slice& user_key,
+                                            SequenceNumber read_seq);
+
   // Add an entry into memtable that maps key to value at the
   // specified sequence number and with the specified type.
   // Typically value will be empty if type==kTypeDeletion.
@@ -376,6 +384,7 @@ class MemTable {
   void MarkImmutable() {
     table_->MarkReadOnly();
     mem_tracker_.DoneAllocating();
+    ConstructFragmentedRangeTombstones();
   }
 
   // Notify the underlying storage that all data it contained has been
@@ -461,6 +470,32 @@ class MemTable {
   std::unique_ptr<MemTableRep> table_;
   std::unique_ptr<MemTableRep> range_del_table_;
   std::atomic_bool is_range_del_table_empty_;
+  // Number of range deletions inserted into range_del_table_.
+  std::atomic<uint64_t> num_range_deletes_;
+  // The range tombstones of an immutable memtable, fragmented once by
+  // MarkImmutable() and shared by all subsequent reads. Only valid once
+  // fragmented_range_tombstones_ready_ is set.
+  std::shared_ptr<const FragmentedRangeTombstoneList>
+      fragmented_range_tombstones_;
+  std::atomic_bool fragmented_range_tombstones_ready_;
+
+  // The range tombstones of the mutable memtable, fragmented by the first read
+  // after a range deletion is added and shared by reads until the next one.
+  // Accessed with std::atomic_load()/std::atomic_store(); rebuilt under
+  // range_tombstone_cache_mutex_.
+  struct RangeTombstoneCache {
+    RangeTombstoneCache(std::unique_ptr<InternalIterator> unfragmented,
+                        const InternalKeyComparator& icmp,
+                        uint64_t _num_range_deletes)
+        : tombstones(std::move(unfragmented), icmp),
+          num_range_deletes(_num_range_deletes) {}
+
+    FragmentedRangeTombstoneList tombstones;
+    // At least this many range deletions are included in tombstones.
+    uint64_t num_range_deletes;
+  };
+  std::shared_ptr<RangeTombstoneCache> range_tombstone_cache_;
+  port::Mutex range_tombstone_cache_mutex_;
 
   // Total data size of all data inserted
   std::atomic<uint64_t> data_size_;
@@ -540,6 +575,24 @@ class MemTable {
 
   void UpdateOldestKeyTime();
 
+  // Fragments the range tombstones of this memtable so that reads of the
+  // immutable memtable can share them. Called by MarkImmutable().
+  void ConstructFragmentedRangeTombstones();
+
+  // Returns the fragmented range tombstones of the memtable, including at
+  // least every range deletion whose insertion completed before the call.
+  // REQUIRES: the range deletion table is not empty.
+  std::shared_ptr<const FragmentedRangeTombstoneList>
+  GetMutableFragmentedRangeTombstones();
+
+  // Returns the range tombstones fragmented by MarkImmutable(), or nullptr if
+  // the memtable is still mutable or has no range tombstones.
+  const FragmentedRangeTombstoneList* GetFragmentedRangeTombstones() const {
+    return fragmented_range_tombstones_ready_.load(std::memory_order_acquire)
+               ? fragmented_range_tombstones_.get()
+               : nullptr;
+  }
+
   void GetFromTable(const LookupKey& key,
                     SequenceNumber max_covering_tombstone_seq, bool do_merge,
                     ReadCallback* callback, bool* is_blob_index,
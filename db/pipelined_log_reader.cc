@@ -0,0 +1,116 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/pipelined_log_reader.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// The reading thread stays at most kNumBatches - 1 batches of about
+// kBatchBytes each ahead of the consumer, which holds on to the other one.
+constexpr size_t kNumBatches = 4;
+constexpr size_t kBatchBytes = 256 << 10;
+}  // namespace
+
+PipelinedLogReader::PipelinedLogReader(log::Reader* reader,
+                                       WALRecoveryMode wal_recovery_mode,
+                                       const Status* reported_status)
+    : reader_(reader),
+      wal_recovery_mode_(wal_recovery_mode),
+      reported_status_(reported_status) {
+  assert(reader_);
+  for (size_t i = 0; i < kNumBatches; ++i) {
+    batches_.emplace_back(new Batch);
+    free_batches_.push(batches_.back().get());
+  }
+  read_thread_.reset(new port::Thread([this] { BGWorkReadLog(); }));
+}
+
+PipelinedLogReader::~PipelinedLogReader() { Stop(); }
+
+bool PipelinedLogReader::ReadRecord(Slice* record, Status* status) {
+  while (!done_) {
+    if (current_ != nullptr && index_ < current_->records.size()) {
+      const auto& r = current_->records[index_++];
+      *record = Slice(current_->data.data() + r.first, r.second);
+      return true;
+    }
+    if (current_ != nullptr && current_->last) {
+      if (status->ok()) {
+        *status = current_->status;
+      }
+      done_ = true;
+      break;
+    }
+    if (current_ != nullptr) {
+      free_batches_.push(current_);
+      current_ = nullptr;
+    }
+    Batch* batch = nullptr;
+    if (!full_batches_.pop(batch)) {
+      // The reading thread only ends without handing over a last batch if it
+      // was stopped.
+      done_ = true;
+      break;
+    }
+    current_ = batch;
+    index_ = 0;
+  }
+  return false;
+}
+
+void PipelinedLogReader::Stop() {
+  if (read_thread_) {
+    stop_.store(true, std::memory_order_relaxed);
+    free_batches_.finish();
+    read_thread_->join();
+    read_thread_.reset();
+  }
+  done_ = true;
+}
+
+void PipelinedLogReader::BGWorkReadLog() {
+  Batch* batch = nullptr;
+  while (!stop_.load(std::memory_order_relaxed) &&
+         free_batches_.pop(batch)) {
+    if (batch->data.capacity() > 4 * kBatchBytes) {
+      // Don't hold on to the memory of a batch with a huge record.
+      std::string().swap(batch->data);
+    }
+    batch->Clear();
+    const bool last = FillBatch(batch);
+    full_batches_.push(batch);
+    if (last) {
+      break;
+    }
+  }
+  full_batches_.finish();
+}
+
+bool PipelinedLogReader::FillBatch(Batch* batch) {
+  std::string scratch;
+  Slice record;
+  while (!stop_.load(std::memory_order_relaxed)) {
+    const bool found =
+        reader_->ReadRecord(&record, &scratch, wal_recovery_mode_);
+    if (reported_status_ != nullptr && !reported_status_->ok()) {
+      batch->status = *reported_status_;
+      batch->last = true;
+      return true;
+    }
+    if (!found) {
+      batch->last = true;
+      return true;
+    }
+    batch->records.emplace_back(batch->data.size(), record.size());
+    batch->data.append(record.data(), record.size());
+    if (batch->data.size() >= kBatchBytes) {
+      return false;
+    }
+  }
+  return false;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,83 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "db/log_reader.h"
+#include "port/port.h"
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
+#include "util/work_queue.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Reads the records of a log::Reader on a separate thread, a bounded number
+// of bytes ahead of the consumer, so that reading a WAL from the device and
+// verifying its checksums overlap with applying its records during recovery.
+//
+// The reporter of `reader` is called on the reading thread. If it records the
+// first corruption it reports in `*reported_status`, reading stops at the
+// first record read after that status became non-ok, as a caller of
+// log::Reader::ReadRecord() checking that status after each record would.
+// `reader` and `*reported_status` must not be used by anyone else while this
+// is alive.
+class PipelinedLogReader {
+ public:
+  PipelinedLogReader(log::Reader* reader, WALRecoveryMode wal_recovery_mode,
+                     const Status* reported_status);
+  ~PipelinedLogReader();
+
+  // Like log::Reader::ReadRecord(), the record stays valid until the next
+  // call. Returns false at the end of the log, and also if the reporter
+  // reported a corruption, which is then stored in `*status` unless that
+  // already holds an error.
+  bool ReadRecord(Slice* record, Status* status);
+
+  // Stops the reading thread. ReadRecord() returns false afterwards.
+  void Stop();
+
+ private:
+  struct Batch {
+    void Clear() {
+      data.clear();
+      records.clear();
+      last = false;
+      status = Status::OK();
+    }
+
+    std::string data;
+    // Offset and size of each record in `data`.
+    std::vector<std::pair<size_t, size_t>> records;
+    // Whether the log is exhausted (or a corruption was reported) after this
+    // batch.
+    bool last = false;
+    Status status;
+  };
+
+  void BGWorkReadLog();
+  bool FillBatch(Batch* batch);
+
+  log::Reader* reader_;
+  const WALRecoveryMode wal_recovery_mode_;
+  const Status* reported_status_;
+
+  std::vector<std::unique_ptr<Batch>> batches_;
+  WorkQueue<Batch*> free_batches_;
+  WorkQueue<Batch*> full_batches_;
+  std::unique_ptr<port::Thread> read_thread_;
+  std::atomic<bool> stop_{false};
+
+  Batch* current_ = nullptr;
+  size_t index_ = 0;
+  bool done_ = false;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
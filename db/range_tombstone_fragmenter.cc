@@ -214,6 +214,27 @@ bool FragmentedRangeTombstoneList::ContainsRange(SequenceNumber lower,
   return seq_it != seq_set_.end() && *seq_it <= upper;
 }
 
+SequenceNumber FragmentedRangeTombstoneList::MaxCoveringTombstoneSeqnum(
+    const Slice& user_key, const Comparator* ucmp,
+    SequenceNumber upper_bound) const {
+  // The fragments are non-overlapping and sorted, so the only one that can
+  // cover user_key is the first one ending after it.
+  auto pos = std::upper_bound(
+      tombstones_.begin(), tombstones_.end(), user_key,
+      [ucmp](const Slice& key, const RangeTombstoneStack& tombstone) {
+        return ucmp->Compare(key, tombstone.end_key) < 0;
+      });
+  if (pos == tombstones_.end() ||
+      ucmp->Compare(pos->start_key, user_key) > 0) {
+    return 0;
+  }
+  // Sequence numbers within a stack are sorted in descending order.
+  auto seq_pos = std::lower_bound(seq_iter(pos->seq_start_idx),
+                                  seq_iter(pos->seq_end_idx), upper_bound,
+                                  std::greater<SequenceNumber>());
+  return seq_pos == seq_iter(pos->seq_end_idx) ? 0 : *seq_pos;
+}
+
 FragmentedRangeTombstoneIterator::FragmentedRangeTombstoneIterator(
     const FragmentedRangeTombstoneList* tombstones,
     const InternalKeyComparator& icmp, SequenceNumber _upper_bound,
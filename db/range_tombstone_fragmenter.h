@@ -68,6 +68,15 @@ struct FragmentedRangeTombstoneList {
   // number in [lower, upper].
   bool ContainsRange(SequenceNumber lower, SequenceNumber upper) const;
 
+  // Returns the largest sequence number no larger than upper_bound of the
+  // tombstones covering user_key, or 0 if there is none. This gives the same
+  // answer as FragmentedRangeTombstoneIterator::MaxCoveringTombstoneSeqnum()
+  // for an iterator with the same upper bound, but does not need an iterator,
+  // so point lookups can query a shared list without allocating.
+  SequenceNumber MaxCoveringTombstoneSeqnum(const Slice& user_key,
+                                            const Comparator* ucmp,
+                                            SequenceNumber upper_bound) const;
+
  private:
   // Given an ordered range tombstone iterator unfragmented_tombstones,
   // "fragment" the tombstones into non-overlapping pieces, and store them in
@@ -295,6 +295,37 @@ TEST_F(RangeTombstoneFragmenterTest, OverlapAndRepeatedStartKey) {
       &iter5, {{"a", 0}, {"c", 0}, {"e", 0}, {"i", 0}, {"j", 2}, {"m", 0}});
 }
 
+TEST_F(RangeTombstoneFragmenterTest, ListMaxCoveringTombstoneSeqnum) {
+  auto range_del_iter = MakeRangeDelIter({{"a", "e", 10},
+                                          {"c", "g", 8},
+                                          {"c", "i", 6},
+                                          {"j", "n", 4},
+                                          {"j", "l", 2}});
+
+  FragmentedRangeTombstoneList fragment_list(std::move(range_del_iter),
+                                             bytewise_icmp);
+  const Comparator* ucmp = bytewise_icmp.user_comparator();
+  for (SequenceNumber upper_bound : {kMaxSequenceNumber, SequenceNumber{9},
+                                     SequenceNumber{7}, SequenceNumber{5},
+                                     SequenceNumber{3}}) {
+    FragmentedRangeTombstoneIterator iter(&fragment_list, bytewise_icmp,
+                                          upper_bound);
+    for (const char* key : {"0", "a", "b", "c", "d", "e", "f", "g", "h", "i",
+                            "j", "k", "l", "m", "n", "z"}) {
+      EXPECT_EQ(iter.MaxCoveringTombstoneSeqnum(key),
+                fragment_list.MaxCoveringTombstoneSeqnum(key, ucmp,
+                                                         upper_bound))
+          << "key=" << key << " upper_bound=" << upper_bound;
+    }
+  }
+  EXPECT_EQ(10, fragment_list.MaxCoveringTombstoneSeqnum("c", ucmp,
+                                                         kMaxSequenceNumber));
+  EXPECT_EQ(6, fragment_list.MaxCoveringTombstoneSeqnum("e", ucmp, 7));
+  EXPECT_EQ(0, fragment_list.MaxCoveringTombstoneSeqnum("i", ucmp,
+                                                        kMaxSequenceNumber));
+  EXPECT_EQ(2, fragment_list.MaxCoveringTombstoneSeqnum("k", ucmp, 3));
+}
+
 TEST_F(RangeTombstoneFragmenterTest, OverlapAndRepeatedStartKeyUnordered) {
   auto range_del_iter = MakeRangeDelIter({{"a", "e", 10},
                                           {"j", "n", 4},
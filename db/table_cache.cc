@@ -295,7 +295,15 @@ Status TableCache::GetRangeTombstoneIterator(
   }
   if (s.ok()) {
     out_iter->reset(t->NewRangeTombstoneIterator(options));
-    assert(out_iter);
+  }
+  if (handle != nullptr) {
+    // The table reader owns what the iterator points to, so keep it cached
+    // until the iterator is gone.
+    if (*out_iter != nullptr) {
+      (*out_iter)->RegisterCleanup(&UnrefEntry, cache_, handle);
+    } else {
+      ReleaseHandle(handle);
+    }
   }
   return s;
 }
@@ -417,13 +425,9 @@ Status TableCache::Get(const ReadOptions& options,
         get_context->max_covering_tombstone_seq();
     if (s.ok() && max_covering_tombstone_seq != nullptr &&
         !options.ignore_range_deletions) {
-      std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
-          t->NewRangeTombstoneIterator(options));
-      if (range_del_iter != nullptr) {
-        *max_covering_tombstone_seq = std::max(
-            *max_covering_tombstone_seq,
-            range_del_iter->MaxCoveringTombstoneSeqnum(ExtractUserKey(k)));
-      }
+      *max_covering_tombstone_seq =
+          std::max(*max_covering_tombstone_seq,
+                   t->MaxCoveringTombstoneSeqnum(options, ExtractUserKey(k)));
     }
     if (s.ok()) {
       get_context->SetReplayLog(row_cache_entry);  // nullptr if no cache.
@@ -516,17 +520,13 @@ Status TableCache::MultiGet(const ReadOptions& options,
       }
     }
     if (s.ok() && !options.ignore_range_deletions) {
-      std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
-          t->NewRangeTombstoneIterator(options));
-      if (range_del_iter != nullptr) {
-        for (auto iter = table_range.begin(); iter != table_range.end();
-             ++iter) {
-          SequenceNumber* max_covering_tombstone_seq =
-              iter->get_context->max_covering_tombstone_seq();
-          *max_covering_tombstone_seq =
-              std::max(*max_covering_tombstone_seq,
-                       range_del_iter->MaxCoveringTombstoneSeqnum(iter->ukey));
-        }
+      for (auto iter = table_range.begin(); iter != table_range.end();
+           ++iter) {
+        SequenceNumber* max_covering_tombstone_seq =
+            iter->get_context->max_covering_tombstone_seq();
+        *max_covering_tombstone_seq =
+            std::max(*max_covering_tombstone_seq,
+                     t->MaxCoveringTombstoneSeqnum(options, iter->ukey));
       }
     }
     if (s.ok()) {
@@ -576,6 +576,36 @@ Status TableCache::MultiGet(const ReadOptions& options,
   return s;
 }
 
+void TableCache::MultiGetPrefetch(
+    const ReadOptions& options,
+    const InternalKeyComparator& internal_comparator,
+    const FileMetaData& file_meta, const MultiGetContext::Range* mget_range,
+    const SliceTransform* prefix_extractor, HistogramImpl* file_read_hist,
+    bool skip_filters, int level) {
+  if (options.read_tier == kBlockCacheTier || mget_range->empty()) {
+    return;
+  }
+  auto& fd = file_meta.fd;
+  TableReader* t = fd.table_reader;
+  Cache::Handle* handle = nullptr;
+  if (t == nullptr) {
+    Status s = FindTable(file_options_, internal_comparator, fd, &handle,
+                         prefix_extractor, false /* no_io */,
+                         true /* record_read_stats */, file_read_hist,
+                         skip_filters, level);
+    if (!s.ok()) {
+      // MultiGet() will run into the same error and report it
+      return;
+    }
+    t = GetTableReaderFromHandle(handle);
+    assert(t);
+  }
+  t->MultiGetPrefetch(options, mget_range, prefix_extractor, skip_filters);
+  if (handle != nullptr) {
+    ReleaseHandle(handle);
+  }
+}
+
 Status TableCache::GetTableProperties(
     const FileOptions& file_options,
     const InternalKeyComparator& internal_comparator, const FileDescriptor& fd,
@@ -684,4 +714,29 @@ uint64_t TableCache::ApproximateSize(
 
   return result;
 }
+
+Status TableCache::ApproximateKeyAnchors(
+    const ReadOptions& read_options,
+    const InternalKeyComparator& internal_comparator, const FileDescriptor& fd,
+    std::vector<TableReader::Anchor>* anchors,
+    const SliceTransform* prefix_extractor) {
+  Status s;
+  TableReader* table_reader = fd.table_reader;
+  Cache::Handle* table_handle = nullptr;
+  if (table_reader == nullptr) {
+    s = FindTable(file_options_, internal_comparator, fd, &table_handle,
+                  prefix_extractor,
+                  read_options.read_tier == kBlockCacheTier /* no_io */);
+    if (s.ok()) {
+      table_reader = GetTableReaderFromHandle(table_handle);
+    }
+  }
+  if (s.ok()) {
+    s = table_reader->ApproximateKeyAnchors(read_options, anchors);
+  }
+  if (table_handle != nullptr) {
+    ReleaseHandle(table_handle);
+  }
+  return s;
+}
 }  // namespace ROCKSDB_NAMESPACE
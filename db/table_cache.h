@@ -119,6 +119,19 @@ class TableCache {
                   HistogramImpl* file_read_hist = nullptr,
                   bool skip_filters = false, int level = -1);
 
+  // Issue read-ahead for the blocks that MultiGet() would read from the
+  // specified file for the keys in mget_range. It opens the table reader if
+  // needed, but does not look up the keys or modify their GetContext.
+  // @param skip_filters Disables loading/accessing the filter block
+  // @param level The level this table is at, -1 for "not set / don't know"
+  void MultiGetPrefetch(const ReadOptions& options,
+                        const InternalKeyComparator& internal_comparator,
+                        const FileMetaData& file_meta,
+                        const MultiGetContext::Range* mget_range,
+                        const SliceTransform* prefix_extractor = nullptr,
+                        HistogramImpl* file_read_hist = nullptr,
+                        bool skip_filters = false, int level = -1);
+
   // Evict any entry for the specified file number
   static void Evict(Cache* cache, uint64_t file_number);
 
@@ -176,6 +189,14 @@ class TableCache {
                            const InternalKeyComparator& internal_comparator,
                            const SliceTransform* prefix_extractor = nullptr);
 
+  // Appends to *anchors the user keys that split the file represented by fd
+  // into ranges of similar size. See TableReader::ApproximateKeyAnchors().
+  Status ApproximateKeyAnchors(
+      const ReadOptions& read_options,
+      const InternalKeyComparator& internal_comparator,
+      const FileDescriptor& fd, std::vector<TableReader::Anchor>* anchors,
+      const SliceTransform* prefix_extractor = nullptr);
+
   // Release the handle from a cache
   void ReleaseHandle(Cache::Handle* handle);
 
@@ -28,6 +28,7 @@
 #include "db/internal_stats.h"
 #include "db/table_cache.h"
 #include "db/version_set.h"
+#include "monitoring/iostats_context_imp.h"
 #include "port/port.h"
 #include "table/table_reader.h"
 #include "util/string_util.h"
@@ -814,6 +815,7 @@ class VersionBuilder::Rep {
       return s;
     }
 
+    std::vector<bool> unchanged_levels(num_levels_, false);
     for (int level = 0; level < num_levels_; level++) {
       const auto& cmp = (level == 0) ? level_zero_cmp_ : level_nonzero_cmp_;
       // Merge the set of added files with the set of pre-existing files.
@@ -823,6 +825,16 @@ class VersionBuilder::Rep {
       vstorage->Reserve(level,
                         base_files.size() + unordered_added_files.size());
 
+      // Most edits only touch a few levels; the others keep the base files.
+      if (unordered_added_files.empty() &&
+          levels_[level].deleted_files.empty()) {
+        for (auto* f : base_files) {
+          vstorage->AddFile(level, f, ioptions_->info_log);
+        }
+        unchanged_levels[level] = true;
+        continue;
+      }
+
       // Sort added files for the level.
       std::vector<FileMetaData*> added_files;
       added_files.reserve(unordered_added_files.size());
@@ -857,6 +869,7 @@ class VersionBuilder::Rep {
     }
 
     SaveBlobFilesTo(vstorage);
+    vstorage->SetUnchangedLevels(base_vstorage_, std::move(unchanged_levels));
 
     s = CheckConsistency(vstorage);
     return s;
@@ -921,7 +934,10 @@ class VersionBuilder::Rep {
     }
 
     std::atomic<size_t> next_file_meta_idx(0);
+    // The loading threads issue their reads on behalf of this one.
+    const IOActivity io_activity = IOSTATS_IO_ACTIVITY();
     std::function<void()> load_handlers_func([&]() {
+      IOSTATS_IO_ACTIVITY_GUARD(io_activity);
       while (true) {
         size_t file_idx = next_file_meta_idx.fetch_add(1);
         if (file_idx >= files_meta.size()) {
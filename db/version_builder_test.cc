@@ -174,6 +174,91 @@ TEST_F(VersionBuilderTest, ApplyAndSaveTo) {
   UnrefFilesInVersion(&new_vstorage);
 }
 
+TEST_F(VersionBuilderTest, SaveToReusesStateOfUnchangedLevels) {
+  ioptions_.compaction_pri = kMinOverlappingRatio;
+
+  Add(1, 66U, "150", "200", 100U);
+  Add(1, 88U, "201", "300", 100U);
+
+  Add(2, 6U, "150", "179", 100U);
+  Add(2, 7U, "180", "220", 100U);
+  Add(2, 8U, "221", "300", 100U);
+
+  Add(3, 26U, "150", "179", 1000U);
+  Add(3, 27U, "221", "300", 50U);
+  UpdateVersionStorageInfo();
+  ASSERT_EQ(std::vector<int>({1, 2, 0}), vstorage_.FilesByCompactionPri(2));
+
+  // Level 3 changes, which changes the order of the files of level 2 as well,
+  // while level 1 keeps the order of the base version.
+  VersionEdit version_edit;
+  version_edit.AddFile(3, 666, 0, 5000U, GetInternalKey("180"),
+                       GetInternalKey("220"), 200, 200, false,
+                       kInvalidBlobFileNumber, kUnknownOldestAncesterTime,
+                       kUnknownFileCreationTime, kUnknownFileChecksum,
+                       kUnknownFileChecksumFuncName);
+
+  EnvOptions env_options;
+  constexpr TableCache* table_cache = nullptr;
+  constexpr VersionSet* version_set = nullptr;
+
+  VersionBuilder version_builder(env_options, &ioptions_, table_cache,
+                                 &vstorage_, version_set);
+  ASSERT_OK(version_builder.Apply(&version_edit));
+
+  VersionStorageInfo new_vstorage(&icmp_, ucmp_, options_.num_levels,
+                                  kCompactionStyleLevel, nullptr, false);
+  ASSERT_OK(version_builder.SaveTo(&new_vstorage));
+  VersionStorageInfo expected_vstorage(&icmp_, ucmp_, options_.num_levels,
+                                       kCompactionStyleLevel, nullptr, false);
+  ASSERT_OK(version_builder.SaveTo(&expected_vstorage));
+  expected_vstorage.ClearUnchangedLevels();
+
+  for (auto* vstorage : {&new_vstorage, &expected_vstorage}) {
+    vstorage->ComputeCompensatedSizes();
+    vstorage->UpdateNumNonEmptyLevels();
+    vstorage->UpdateFilesByCompactionPri(ioptions_.compaction_pri);
+    vstorage->GenerateFileIndexer();
+    vstorage->GenerateLevelFilesBrief();
+    vstorage->CalculateBaseBytes(ioptions_, mutable_cf_options_);
+    vstorage->GenerateLevel0NonOverlapping();
+    vstorage->SetFinalized();
+  }
+  new_vstorage.ClearUnchangedLevels();
+
+  ASSERT_EQ(std::vector<int>({2, 0, 1}), new_vstorage.FilesByCompactionPri(2));
+  for (int level = 0; level < new_vstorage.num_levels() - 1; ++level) {
+    ASSERT_EQ(expected_vstorage.FilesByCompactionPri(level),
+              new_vstorage.FilesByCompactionPri(level));
+  }
+  for (int level = 1; level < new_vstorage.num_non_empty_levels() - 1;
+       ++level) {
+    for (size_t i = 0; i < new_vstorage.LevelFiles(level).size(); ++i) {
+      for (int cmp_smallest : {-1, 0, 1}) {
+        for (int cmp_largest : {-1, 0, 1}) {
+          if (cmp_smallest < cmp_largest) {
+            continue;
+          }
+          int32_t left = 0;
+          int32_t right = 0;
+          int32_t expected_left = 0;
+          int32_t expected_right = 0;
+          new_vstorage.file_indexer().GetNextLevelIndex(
+              level, i, cmp_smallest, cmp_largest, &left, &right);
+          expected_vstorage.file_indexer().GetNextLevelIndex(
+              level, i, cmp_smallest, cmp_largest, &expected_left,
+              &expected_right);
+          ASSERT_EQ(expected_left, left);
+          ASSERT_EQ(expected_right, right);
+        }
+      }
+    }
+  }
+
+  UnrefFilesInVersion(&new_vstorage);
+  UnrefFilesInVersion(&expected_vstorage);
+}
+
 TEST_F(VersionBuilderTest, ApplyAndSaveToDynamic) {
   ioptions_.level_compaction_dynamic_level_bytes = true;
 
@@ -17,6 +17,7 @@
 #include "db/blob/blob_file_garbage.h"
 #include "db/dbformat.h"
 #include "memory/arena.h"
+#include "rocksdb/advanced_options.h"
 #include "rocksdb/cache.h"
 #include "table/table_reader.h"
 #include "util/autovector.h"
@@ -141,6 +142,9 @@ struct FileMetaData {
   // File checksum function name
   std::string file_checksum_func_name = kUnknownFileChecksumFuncName;
 
+  // The temperature the file was written with.
+  Temperature temperature = Temperature::kUnknown;
+
   FileMetaData() = default;
 
   FileMetaData(uint64_t file, uint32_t file_path_id, uint64_t file_size,
@@ -149,7 +153,8 @@ struct FileMetaData {
                const SequenceNumber& largest_seq, bool marked_for_compact,
                uint64_t oldest_blob_file, uint64_t _oldest_ancester_time,
                uint64_t _file_creation_time, const std::string& _file_checksum,
-               const std::string& _file_checksum_func_name)
+               const std::string& _file_checksum_func_name,
+               Temperature _temperature = Temperature::kUnknown)
       : fd(file, file_path_id, file_size, smallest_seq, largest_seq),
         smallest(smallest_key),
         largest(largest_key),
@@ -158,7 +163,8 @@ struct FileMetaData {
         oldest_ancester_time(_oldest_ancester_time),
         file_creation_time(_file_creation_time),
         file_checksum(_file_checksum),
-        file_checksum_func_name(_file_checksum_func_name) {
+        file_checksum_func_name(_file_checksum_func_name),
+        temperature(_temperature) {
     TEST_SYNC_POINT_CALLBACK("FileMetaData::FileMetaData", this);
   }
 
@@ -204,6 +210,19 @@ struct FileMetaData {
     }
     return kUnknownFileCreationTime;
   }
+
+  // Estimate of the read amplification caused by this file: the sampled
+  // number of reads that probed it, weighted up by the fraction of its
+  // entries that are point tombstones readers have to skip over.
+  double ReadAmpScore() const {
+    double score = static_cast<double>(
+        stats.num_reads_sampled.load(std::memory_order_relaxed));
+    if (num_entries > 0) {
+      score *= 1.0 + static_cast<double>(num_deletions) /
+                         static_cast<double>(num_entries);
+    }
+    return score;
+  }
 };
 
 // A compressed copy of file meta data that just contain minimum data needed
@@ -235,9 +254,14 @@ struct FdWithKeyRange {
 struct LevelFilesBrief {
   size_t num_files;
   FdWithKeyRange* files;
+  // The first 8 bytes of the user key of the largest key of each file, packed
+  // into integers, which lets FindFile() narrow down its search without
+  // touching the keys themselves. nullptr if not generated.
+  uint64_t* largest_key_prefixes;
   LevelFilesBrief() {
     num_files = 0;
     files = nullptr;
+    largest_key_prefixes = nullptr;
   }
 };
 
@@ -325,14 +349,16 @@ class VersionEdit {
                const SequenceNumber& largest_seqno, bool marked_for_compaction,
                uint64_t oldest_blob_file_number, uint64_t oldest_ancester_time,
                uint64_t file_creation_time, const std::string& file_checksum,
-               const std::string& file_checksum_func_name) {
+               const std::string& file_checksum_func_name,
+               Temperature temperature = Temperature::kUnknown) {
     assert(smallest_seqno <= largest_seqno);
     new_files_.emplace_back(
         level, FileMetaData(file, file_path_id, file_size, smallest, largest,
                             smallest_seqno, largest_seqno,
                             marked_for_compaction, oldest_blob_file_number,
                             oldest_ancester_time, file_creation_time,
-                            file_checksum, file_checksum_func_name));
+                            file_checksum, file_checksum_func_name,
+                            temperature));
   }
 
   void AddFile(int level, const FileMetaData& f) {
@@ -353,6 +379,10 @@ class VersionEdit {
         std::move(checksum_method), std::move(checksum_value));
   }
 
+  void AddBlobFile(BlobFileAddition blob_file_addition) {
+    blob_file_additions_.emplace_back(std::move(blob_file_addition));
+  }
+
   // Retrieve all the blob files added.
   using BlobFileAdditions = std::vector<BlobFileAddition>;
   const BlobFileAdditions& GetBlobFileAdditions() const {
@@ -414,6 +414,10 @@ Status VersionEditHandler::LoadTables(ColumnFamilyData* cfd,
   auto builder_iter = builders_.find(cfd->GetID());
   assert(builder_iter != builders_.end());
   assert(builder_iter->second != nullptr);
+  if (is_initial_load &&
+      version_set_->db_options_->skip_opening_table_readers_on_db_open) {
+    return Status::OK();
+  }
   VersionBuilder* builder = builder_iter->second->version_builder();
   assert(builder);
   Status s = builder->LoadTableHandlers(
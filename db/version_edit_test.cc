@@ -71,7 +71,7 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
                InternalKey("zoo", kBig + 603, kTypeBlobIndex), kBig + 503,
                kBig + 603, true, 1001, kUnknownOldestAncesterTime,
                kUnknownFileCreationTime, kUnknownFileChecksum,
-               kUnknownFileChecksumFuncName);
+               kUnknownFileChecksumFuncName, Temperature::kCold);
   ;
 
   edit.DeleteFile(4, 700);
@@ -103,6 +103,8 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
   ASSERT_EQ(kInvalidBlobFileNumber,
             new_files[2].second.oldest_blob_file_number);
   ASSERT_EQ(1001, new_files[3].second.oldest_blob_file_number);
+  ASSERT_EQ(Temperature::kUnknown, new_files[0].second.temperature);
+  ASSERT_EQ(Temperature::kCold, new_files[3].second.temperature);
 }
 
 TEST_F(VersionEditTest, ForwardCompatibleNewFile4) {
@@ -22,6 +22,9 @@
 #include <vector>
 
 #include "compaction/compaction.h"
+#include "db/blob/blob_file_cache.h"
+#include "db/blob/blob_file_reader.h"
+#include "db/blob/blob_index.h"
 #include "db/internal_stats.h"
 #include "db/log_reader.h"
 #include "db/log_writer.h"
@@ -62,6 +65,20 @@ namespace ROCKSDB_NAMESPACE {
 
 namespace {
 
+// The first 8 bytes of a user key, padded with zeros, as a big-endian
+// integer. For the bytewise comparator, a key with a smaller prefix is
+// smaller and a key with a larger prefix is larger.
+uint64_t KeyPrefixForSearch(const Slice& user_key) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < sizeof(prefix); ++i) {
+    prefix <<= 8;
+    if (i < user_key.size()) {
+      prefix |= static_cast<unsigned char>(user_key[i]);
+    }
+  }
+  return prefix;
+}
+
 // Find File in LevelFilesBrief data structure
 // Within an index range defined by left and right
 int FindFileInRange(const InternalKeyComparator& icmp,
@@ -69,6 +86,20 @@ int FindFileInRange(const InternalKeyComparator& icmp,
     const Slice& key,
     uint32_t left,
     uint32_t right) {
+  if (file_level.largest_key_prefixes != nullptr && left < right &&
+      icmp.user_comparator() == BytewiseComparator()) {
+    // Narrow the range down to the files whose largest key has the same
+    // prefix as the key by searching the packed prefixes first, which are
+    // contiguous in memory, unlike the keys.
+    const uint64_t prefix = KeyPrefixForSearch(ExtractUserKey(key));
+    const uint64_t* prefixes = file_level.largest_key_prefixes;
+    left = static_cast<uint32_t>(
+        std::lower_bound(prefixes + left, prefixes + right, prefix) -
+        prefixes);
+    right = static_cast<uint32_t>(
+        std::upper_bound(prefixes + left, prefixes + right, prefix) -
+        prefixes);
+  }
   auto cmp = [&](const FdWithKeyRange& f, const Slice& k) -> bool {
     return icmp.InternalKeyComparator::Compare(f.largest_key, k) < 0;
   };
@@ -798,6 +829,8 @@ void DoGenerateLevelFilesBrief(LevelFilesBrief* file_level,
   file_level->num_files = num;
   char* mem = arena->AllocateAligned(num * sizeof(FdWithKeyRange));
   file_level->files = new (mem)FdWithKeyRange[num];
+  mem = arena->AllocateAligned(num * sizeof(uint64_t));
+  file_level->largest_key_prefixes = reinterpret_cast<uint64_t*>(mem);
 
   for (size_t i = 0; i < num; i++) {
     Slice smallest_key = files[i]->smallest.Encode();
@@ -815,6 +848,8 @@ void DoGenerateLevelFilesBrief(LevelFilesBrief* file_level,
     f.file_metadata = files[i];
     f.smallest_key = Slice(mem, smallest_size);
     f.largest_key = Slice(mem + smallest_size, largest_size);
+    file_level->largest_key_prefixes[i] =
+        KeyPrefixForSearch(files[i]->largest.user_key());
   }
 }
 
@@ -1442,6 +1477,81 @@ size_t Version::GetMemoryUsageByTableReaders() {
   return total_usage;
 }
 
+Status Version::GetRangePartitions(const ReadOptions& read_options,
+                                  const Slice* begin, const Slice* end,
+                                  size_t num_partitions,
+                                  std::vector<std::string>* boundaries,
+                                  std::vector<uint64_t>* partition_sizes) {
+  assert(num_partitions > 0);
+  boundaries->clear();
+  partition_sizes->clear();
+  const Comparator* ucmp = user_comparator();
+
+  std::vector<TableReader::Anchor> anchors;
+  for (int level = 0; level < storage_info_.num_non_empty_levels(); ++level) {
+    for (const auto* file : storage_info_.LevelFiles(level)) {
+      const Slice smallest = file->smallest.user_key();
+      const Slice largest = file->largest.user_key();
+      if ((begin != nullptr && ucmp->Compare(largest, *begin) < 0) ||
+          (end != nullptr && ucmp->Compare(smallest, *end) >= 0)) {
+        continue;
+      }
+      size_t num_anchors = anchors.size();
+      Status s = table_cache_->ApproximateKeyAnchors(
+          read_options, *internal_comparator(), file->fd, &anchors,
+          mutable_cf_options_.prefix_extractor.get());
+      if (s.IsNotSupported() || s.IsIncomplete()) {
+        anchors.erase(anchors.begin() + num_anchors, anchors.end());
+        anchors.emplace_back(largest, file->fd.GetFileSize());
+      } else if (!s.ok()) {
+        return s;
+      }
+    }
+  }
+
+  // Only anchors strictly inside the range can become boundaries
+  uint64_t total_size = 0;
+  size_t num_kept = 0;
+  for (auto& anchor : anchors) {
+    if ((begin != nullptr && ucmp->Compare(anchor.user_key, *begin) <= 0) ||
+        (end != nullptr && ucmp->Compare(anchor.user_key, *end) >= 0)) {
+      continue;
+    }
+    total_size += anchor.range_size;
+    if (&anchors[num_kept] != &anchor) {
+      anchors[num_kept] = std::move(anchor);
+    }
+    num_kept++;
+  }
+  anchors.erase(anchors.begin() + num_kept, anchors.end());
+  std::sort(anchors.begin(), anchors.end(),
+            [ucmp](const TableReader::Anchor& a, const TableReader::Anchor& b) {
+              return ucmp->Compare(a.user_key, b.user_key) < 0;
+            });
+
+  uint64_t target_size = total_size / num_partitions;
+  uint64_t accumulated = 0;
+  uint64_t partition_start = 0;
+  for (const auto& anchor : anchors) {
+    accumulated += anchor.range_size;
+    if (boundaries->size() + 1 >= num_partitions) {
+      break;
+    }
+    if (accumulated < target_size * (boundaries->size() + 1)) {
+      continue;
+    }
+    if (!boundaries->empty() &&
+        ucmp->Compare(boundaries->back(), anchor.user_key) == 0) {
+      continue;
+    }
+    boundaries->push_back(anchor.user_key);
+    partition_sizes->push_back(accumulated - partition_start);
+    partition_start = accumulated;
+  }
+  partition_sizes->push_back(total_size - partition_start);
+  return Status::OK();
+}
+
 void Version::GetColumnFamilyMetaData(ColumnFamilyMetaData* cf_meta) {
   assert(cf_meta);
   assert(cfd_);
@@ -1479,6 +1589,7 @@ void Version::GetColumnFamilyMetaData(ColumnFamilyMetaData* cf_meta) {
           file->file_checksum, file->file_checksum_func_name});
       files.back().num_entries = file->num_entries;
       files.back().num_deletions = file->num_deletions;
+      files.back().read_amp_score = file->ReadAmpScore();
       level_size += file->fd.GetFileSize();
     }
     cf_meta->levels.emplace_back(
@@ -1501,7 +1612,6 @@ void Version::GetCreationTimeOfOldestFile(uint64_t* creation_time) {
   uint64_t oldest_time = port::kMaxUint64;
   for (int level = 0; level < storage_info_.num_non_empty_levels_; level++) {
     for (FileMetaData* meta : storage_info_.LevelFiles(level)) {
-      assert(meta->fd.table_reader != nullptr);
       uint64_t file_creation_time = meta->TryGetFileCreationTime();
       if (file_creation_time == kUnknownFileCreationTime) {
         *creation_time = 0;
@@ -1703,6 +1813,7 @@ VersionStorageInfo::VersionStorageInfo(
       num_levels_(levels),
       num_non_empty_levels_(0),
       file_indexer_(user_comparator),
+      base_vstorage_(nullptr),
       compaction_style_(compaction_style),
       files_(new std::vector<FileMetaData*>[num_levels_]),
       base_level_(num_levels_ == 1 ? -1 : 1),
@@ -1770,6 +1881,81 @@ Version::Version(ColumnFamilyData* column_family_data, VersionSet* vset,
           MaxFileSizeForL0MetaPin(mutable_cf_options_)),
       version_number_(version_number) {}
 
+Status Version::GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                        const Slice& blob_index_slice,
+                        PinnableSlice* value) const {
+  assert(value);
+
+  // Blob indexes written by the stackable BlobDB (inlined, TTL, or pointing
+  // to blob files unknown to the version) cannot be resolved here.
+  auto unexpected_blob_index = [this]() {
+    ROCKS_LOG_ERROR(info_log_, "Encounter unexpected blob index.");
+    return Status::NotSupported(
+        "Encounter unexpected blob index. Please open DB with "
+        "ROCKSDB_NAMESPACE::blob_db::BlobDB instead.");
+  };
+
+  const auto& blob_files = storage_info_.GetBlobFiles();
+  if (blob_files.empty()) {
+    return unexpected_blob_index();
+  }
+
+  BlobIndex blob_index;
+
+  {
+    Status s = blob_index.DecodeFrom(blob_index_slice);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  if (blob_index.HasTTL() || blob_index.IsInlined() ||
+      blob_files.find(blob_index.file_number()) == blob_files.end()) {
+    return unexpected_blob_index();
+  }
+
+  if (read_options.read_tier == kBlockCacheTier) {
+    return Status::Incomplete("Cannot read blob: no disk I/O allowed");
+  }
+
+#ifndef ROCKSDB_LITE
+  // Copy out the fields before `value` (which may hold the blob index) is
+  // overwritten.
+  const uint64_t blob_file_number = blob_index.file_number();
+  const uint64_t offset = blob_index.offset();
+  const uint64_t size = blob_index.size();
+  const CompressionType compression = blob_index.compression();
+
+  BlobFileCache* const blob_file_cache = cfd_->blob_file_cache();
+  assert(blob_file_cache);
+
+  Cache::Handle* handle = nullptr;
+  Status s = blob_file_cache->GetBlobFileReader(blob_file_number, &handle);
+  if (!s.ok()) {
+    return s;
+  }
+
+  const BlobFileReader* const reader =
+      blob_file_cache->GetReaderFromHandle(handle);
+  assert(reader);
+
+  PinnableSlice blob_value;
+  s = reader->GetBlob(read_options, user_key, offset, size, compression,
+                      &blob_value);
+  blob_file_cache->ReleaseHandle(handle);
+
+  if (s.ok()) {
+    value->Reset();
+    value->PinSelf(blob_value);
+  }
+
+  return s;
+#else
+  (void)user_key;
+  return Status::NotSupported("Blob files are not supported in LITE mode");
+#endif  // ROCKSDB_LITE
+}
+
 void Version::Get(const ReadOptions& read_options, const LookupKey& k,
                   PinnableSlice* value, std::string* timestamp, Status* status,
                   MergeContext* merge_context,
@@ -1792,13 +1978,19 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
       vset_->block_cache_tracer_->is_tracing_enabled()) {
     tracing_get_id = vset_->block_cache_tracer_->NextGetId();
   }
+
+  // Blob indexes written by flush or compaction into blob files are resolved
+  // here, unless the caller (e.g. the stackable BlobDB) asks for them.
+  bool is_blob_index = false;
+  bool* const is_blob_to_use = is_blob ? is_blob : &is_blob_index;
+
   GetContext get_context(
       user_comparator(), merge_operator_, info_log_, db_statistics_,
       status->ok() ? GetContext::kNotFound : GetContext::kMerge, user_key,
       do_merge ? value : nullptr, do_merge ? timestamp : nullptr, value_found,
       merge_context, do_merge, max_covering_tombstone_seq, this->env_, seq,
-      merge_operator_ ? &pinned_iters_mgr : nullptr, callback, is_blob,
-      tracing_get_id);
+      merge_operator_ ? &pinned_iters_mgr : nullptr, callback,
+      is_blob_to_use, tracing_get_id);
 
   // Pin blocks that we read to hold merge operands
   if (merge_operator_) {
@@ -1864,6 +2056,18 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
         }
         PERF_COUNTER_BY_LEVEL_ADD(user_key_return_count, 1,
                                   fp.GetHitFileLevel());
+
+        if (is_blob_index) {
+          if (!do_merge) {
+            *status = Status::NotSupported(
+                "GetMergeOperands not supported for values in blob files");
+          } else if (value) {
+            *status = GetBlob(read_options, user_key, *value, value);
+            if (status->IsIncomplete()) {
+              get_context.MarkKeyMayExist();
+            }
+          }
+        }
         return;
       case GetContext::kDeleted:
         // Use empty error message for speed
@@ -1937,8 +2141,8 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
         iter->s->ok() ? GetContext::kNotFound : GetContext::kMerge, iter->ukey,
         iter->value, iter->timestamp, nullptr, &(iter->merge_context), true,
         &iter->max_covering_tombstone_seq, this->env_, nullptr,
-        merge_operator_ ? &pinned_iters_mgr : nullptr, callback, is_blob,
-        tracing_mget_id);
+        merge_operator_ ? &pinned_iters_mgr : nullptr, callback,
+        is_blob ? is_blob : &iter->is_blob_index, tracing_mget_id);
     // MergeInProgress status, if set, has been transferred to the get_context
     // state, so we set status to ok here. From now on, the iter status will
     // be used for IO errors, and get_context state will be used for any
@@ -1958,9 +2162,16 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
       &storage_info_.file_indexer_, user_comparator(), internal_comparator());
   FdWithKeyRange* f = fp.GetNextFile();
   Status s;
+  int prefetched_level = -1;
 
   while (f != nullptr) {
     MultiGetRange file_range = fp.CurrentFileRange();
+    if (read_options.async_io &&
+        static_cast<int>(fp.GetHitFileLevel()) != prefetched_level) {
+      prefetched_level = static_cast<int>(fp.GetHitFileLevel());
+      MultiGetPrefetchLevel(read_options, prefetched_level,
+                            file_picker_range);
+    }
     bool timer_enabled =
         GetPerfLevel() >= PerfLevel::kEnableTimeExceptForMutex &&
         get_perf_context()->per_level_perf_context_enabled;
@@ -2033,6 +2244,16 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
           }
           PERF_COUNTER_BY_LEVEL_ADD(user_key_return_count, 1,
                                     fp.GetHitFileLevel());
+
+          if (iter->is_blob_index && iter->value) {
+            *status = GetBlob(read_options, iter->ukey, *iter->value,
+                              iter->value);
+            if (!status->ok()) {
+              file_range.MarkKeyDone(iter);
+              continue;
+            }
+          }
+
           file_range.AddValueSize(iter->value->size());
           file_range.MarkKeyDone(iter);
           if (file_range.GetValueSize() > read_options.value_size_soft_limit) {
@@ -2111,6 +2332,71 @@ void Version::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
   }
 }
 
+void Version::MultiGetPrefetchLevel(const ReadOptions& read_options,
+                                    int level, const MultiGetRange& range) {
+  const LevelFilesBrief& level_files = storage_info_.LevelFilesBrief(level);
+  const Comparator* ucmp = user_comparator();
+  autovector<std::pair<size_t, MultiGetRange>, 8> file_ranges;
+
+  if (level == 0) {
+    // L0 files may overlap, so every file covering a key is a candidate
+    for (size_t i = 0; i < level_files.num_files; ++i) {
+      const FdWithKeyRange& f = level_files.files[i];
+      MultiGetRange file_range(range, range.begin(), range.end());
+      for (auto iter = file_range.begin(); iter != file_range.end(); ++iter) {
+        if (ucmp->Compare(iter->ukey, ExtractUserKey(f.smallest_key)) < 0 ||
+            ucmp->Compare(iter->ukey, ExtractUserKey(f.largest_key)) > 0) {
+          file_range.SkipKey(iter);
+        }
+      }
+      if (!file_range.empty()) {
+        file_ranges.emplace_back(i, file_range);
+      }
+    }
+  } else {
+    // Keys are sorted, so each file gets a contiguous run of them
+    auto iter = range.begin();
+    while (iter != range.end()) {
+      size_t idx = FindFile(*internal_comparator(), level_files, iter->ikey);
+      if (idx >= level_files.num_files) {
+        break;
+      }
+      const FdWithKeyRange& f = level_files.files[idx];
+      auto first = iter;
+      do {
+        ++iter;
+      } while (iter != range.end() &&
+               ucmp->Compare(iter->ukey, ExtractUserKey(f.largest_key)) <= 0);
+      MultiGetRange file_range(range, first, iter);
+      for (auto fiter = file_range.begin(); fiter != file_range.end();
+           ++fiter) {
+        if (ucmp->Compare(fiter->ukey, ExtractUserKey(f.smallest_key)) >= 0) {
+          break;
+        }
+        file_range.SkipKey(fiter);
+      }
+      if (!file_range.empty()) {
+        file_ranges.emplace_back(idx, file_range);
+      }
+    }
+  }
+
+  // The reads for a single file are already batched by its MultiGet()
+  if (file_ranges.size() < 2) {
+    return;
+  }
+  for (auto& file_range : file_ranges) {
+    const FdWithKeyRange& f = level_files.files[file_range.first];
+    table_cache_->MultiGetPrefetch(
+        read_options, *internal_comparator(), *f.file_metadata,
+        &file_range.second, mutable_cf_options_.prefix_extractor.get(),
+        cfd_->internal_stats()->GetFileReadHist(level),
+        IsFilterSkipped(level,
+                        file_range.first + 1 == level_files.num_files),
+        level);
+  }
+}
+
 bool Version::IsFilterSkipped(int level, bool is_file_last_in_level) {
   // Reaching the bottom level implies misses at all upper levels, so we'll
   // skip checking the filters when we predict a hit.
@@ -2141,6 +2427,7 @@ void Version::PrepareApply(
   storage_info_.GenerateLevelFilesBrief();
   storage_info_.GenerateLevel0NonOverlapping();
   storage_info_.GenerateBottommostFiles();
+  storage_info_.ClearUnchangedLevels();
 }
 
 bool Version::MaybeInitializeFileMetaData(FileMetaData* file_meta) {
@@ -2407,9 +2694,18 @@ uint32_t GetExpiredTtlFilesCount(const ImmutableCFOptions& ioptions,
 void VersionStorageInfo::ComputeCompactionScore(
     const ImmutableCFOptions& immutable_cf_options,
     const MutableCFOptions& mutable_cf_options) {
+  // With tiered upper levels, L0 to L(num_tiered_levels - 1) form a single
+  // size-tiered part scored like universal compaction by the L0 score, and
+  // only its last level is scored like the levels below it.
+  const int num_tiered_levels =
+      compaction_style_ == kCompactionStyleLevel
+          ? immutable_cf_options.level_compaction_num_tiered_levels
+          : 0;
   for (int level = 0; level <= MaxInputLevel(); level++) {
     double score;
-    if (level == 0) {
+    if (level > 0 && level < num_tiered_levels - 1) {
+      score = 0;
+    } else if (level == 0) {
       // We treat level-0 specially by bounding the number of files
       // instead of number of bytes for two reasons:
       //
@@ -2429,11 +2725,16 @@ void VersionStorageInfo::ComputeCompactionScore(
           num_sorted_runs++;
         }
       }
-      if (compaction_style_ == kCompactionStyleUniversal) {
+      if (compaction_style_ == kCompactionStyleUniversal ||
+          num_tiered_levels > 1) {
         // For universal compaction, we use level0 score to indicate
         // compaction score for the whole DB. Adding other levels as if
         // they are L0 files.
-        for (int i = 1; i < num_levels(); i++) {
+        const int last_run_level =
+            compaction_style_ == kCompactionStyleUniversal
+                ? num_levels() - 1
+                : num_tiered_levels - 1;
+        for (int i = 1; i <= last_run_level; i++) {
           // Its possible that a subset of the files in a level may be in a
           // compaction, due to delete triggered compaction or trivial move.
           // In that case, the below check may not catch a level being
@@ -2464,7 +2765,8 @@ void VersionStorageInfo::ComputeCompactionScore(
       } else {
         score = static_cast<double>(num_sorted_runs) /
                 mutable_cf_options.level0_file_num_compaction_trigger;
-        if (compaction_style_ == kCompactionStyleLevel && num_levels() > 1) {
+        if (compaction_style_ == kCompactionStyleLevel && num_levels() > 1 &&
+            num_tiered_levels <= 1) {
           // Level-based involves L0->L0 compactions that can lead to oversized
           // L0 files. Take into account size as well to avoid later giant
           // compactions to the base level.
@@ -2511,6 +2813,10 @@ void VersionStorageInfo::ComputeCompactionScore(
     ComputeFilesMarkedForPeriodicCompaction(
         immutable_cf_options, mutable_cf_options.periodic_compaction_seconds);
   }
+  if (mutable_cf_options.cold_file_age_seconds > 0) {
+    ComputeFilesMarkedForTemperatureChange(
+        immutable_cf_options, mutable_cf_options.cold_file_age_seconds);
+  }
   EstimateCompactionBytesNeeded(mutable_cf_options);
 }
 
@@ -2620,6 +2926,40 @@ void VersionStorageInfo::ComputeFilesMarkedForPeriodicCompaction(
   }
 }
 
+void VersionStorageInfo::ComputeFilesMarkedForTemperatureChange(
+    const ImmutableCFOptions& ioptions, const uint64_t cold_file_age_seconds) {
+  assert(cold_file_age_seconds > 0);
+
+  files_marked_for_temperature_change_.clear();
+
+  int64_t temp_current_time;
+  auto status = ioptions.env->GetCurrentTime(&temp_current_time);
+  if (!status.ok()) {
+    return;
+  }
+  const uint64_t current_time = static_cast<uint64_t>(temp_current_time);
+  if (cold_file_age_seconds > current_time) {
+    return;
+  }
+  const uint64_t allowed_time_limit = current_time - cold_file_age_seconds;
+
+  // L0 files are compacted down soon anyway. A file qualifies if its data is
+  // old and no read was sampled on it since the DB was opened.
+  for (int level = 1; level < num_levels(); level++) {
+    for (auto f : files_[level]) {
+      if (f->being_compacted || f->temperature == Temperature::kCold ||
+          f->stats.num_reads_sampled.load(std::memory_order_relaxed) > 0) {
+        continue;
+      }
+      uint64_t oldest_ancester_time = f->TryGetOldestAncesterTime();
+      if (oldest_ancester_time != kUnknownOldestAncesterTime &&
+          oldest_ancester_time < allowed_time_limit) {
+        files_marked_for_temperature_change_.emplace_back(level, f);
+      }
+    }
+  }
+}
+
 namespace {
 
 // used to sort files by size
@@ -2669,6 +3009,21 @@ void VersionStorageInfo::AddFile(int level, FileMetaData* f, Logger* info_log) {
                           FileLocation(level, level_files->size() - 1));
 }
 
+void VersionStorageInfo::SetUnchangedLevels(
+    const VersionStorageInfo* base, std::vector<bool> unchanged_levels) {
+  assert(!finalized_);
+  assert(base != nullptr);
+  assert(base->num_levels() == num_levels_);
+  assert(unchanged_levels.size() == static_cast<size_t>(num_levels_));
+  base_vstorage_ = base;
+  unchanged_levels_ = std::move(unchanged_levels);
+}
+
+void VersionStorageInfo::ClearUnchangedLevels() {
+  base_vstorage_ = nullptr;
+  unchanged_levels_.clear();
+}
+
 void VersionStorageInfo::AddBlobFile(
     std::shared_ptr<BlobFileMetaData> blob_file_meta) {
   assert(blob_file_meta);
@@ -2740,12 +3095,13 @@ void VersionStorageInfo::UpdateNumNonEmptyLevels() {
 }
 
 namespace {
-// Sort `temp` based on ratio of overlapping size over file size
-void SortFileByOverlappingRatio(
+// Calls fn(file, overlapping_bytes) for every file in `files`, where
+// overlapping_bytes is the total size of the files in `next_level_files`
+// whose ranges overlap with it.
+template <typename Fn>
+void ForEachFileOverlappingBytes(
     const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
-    const std::vector<FileMetaData*>& next_level_files,
-    std::vector<Fsize>* temp) {
-  std::unordered_map<uint64_t, uint64_t> file_to_order;
+    const std::vector<FileMetaData*>& next_level_files, Fn fn) {
   auto next_level_it = next_level_files.begin();
 
   for (auto& file : files) {
@@ -2767,10 +3123,24 @@ void SortFileByOverlappingRatio(
       next_level_it++;
     }
 
-    assert(file->compensated_file_size != 0);
-    file_to_order[file->fd.GetNumber()] =
-        overlapping_bytes * 1024u / file->compensated_file_size;
+    fn(file, overlapping_bytes);
   }
+}
+
+// Sort `temp` based on ratio of overlapping size over file size
+void SortFileByOverlappingRatio(
+    const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
+    const std::vector<FileMetaData*>& next_level_files,
+    std::vector<Fsize>* temp) {
+  std::unordered_map<uint64_t, uint64_t> file_to_order;
+
+  ForEachFileOverlappingBytes(
+      icmp, files, next_level_files,
+      [&](FileMetaData* file, uint64_t overlapping_bytes) {
+        assert(file->compensated_file_size != 0);
+        file_to_order[file->fd.GetNumber()] =
+            overlapping_bytes * 1024u / file->compensated_file_size;
+      });
 
   std::sort(temp->begin(), temp->end(),
             [&](const Fsize& f1, const Fsize& f2) -> bool {
@@ -2778,6 +3148,44 @@ void SortFileByOverlappingRatio(
                      file_to_order[f2.file->fd.GetNumber()];
             });
 }
+
+// Sort `temp` based on ratio of read amplification score over the bytes a
+// compaction of the file would rewrite, in descending order. Ties, notably
+// among files that have not been read, are broken by the ratio of
+// overlapping size over file size, in ascending order.
+void SortFileByReadAmpRatio(const InternalKeyComparator& icmp,
+                            const std::vector<FileMetaData*>& files,
+                            const std::vector<FileMetaData*>& next_level_files,
+                            std::vector<Fsize>* temp) {
+  struct Order {
+    double read_amp_ratio;
+    uint64_t overlapping_ratio;
+  };
+  std::unordered_map<uint64_t, Order> file_to_order;
+
+  ForEachFileOverlappingBytes(
+      icmp, files, next_level_files,
+      [&](FileMetaData* file, uint64_t overlapping_bytes) {
+        assert(file->compensated_file_size != 0);
+        Order& order = file_to_order[file->fd.GetNumber()];
+        order.read_amp_ratio =
+            file->ReadAmpScore() * 1024u /
+            static_cast<double>(file->compensated_file_size +
+                                overlapping_bytes);
+        order.overlapping_ratio =
+            overlapping_bytes * 1024u / file->compensated_file_size;
+      });
+
+  std::sort(temp->begin(), temp->end(),
+            [&](const Fsize& f1, const Fsize& f2) -> bool {
+              const Order& o1 = file_to_order[f1.file->fd.GetNumber()];
+              const Order& o2 = file_to_order[f2.file->fd.GetNumber()];
+              if (o1.read_amp_ratio != o2.read_amp_ratio) {
+                return o1.read_amp_ratio > o2.read_amp_ratio;
+              }
+              return o1.overlapping_ratio < o2.overlapping_ratio;
+            });
+}
 }  // namespace
 
 void VersionStorageInfo::UpdateFilesByCompactionPri(
@@ -2794,6 +3202,20 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
     auto& files_by_compaction_pri = files_by_compaction_pri_[level];
     assert(files_by_compaction_pri.size() == 0);
 
+    // The order of the files of an unchanged level only depends on the level
+    // itself, and for kMinOverlappingRatio on the next level. The read
+    // statistics kMaxReadAmpRatio orders by change over time.
+    if (base_vstorage_ != nullptr && unchanged_levels_[level] &&
+        (compaction_pri != kMinOverlappingRatio ||
+         unchanged_levels_[level + 1]) &&
+        compaction_pri != kMaxReadAmpRatio &&
+        base_vstorage_->files_by_compaction_pri_[level].size() ==
+            files.size()) {
+      files_by_compaction_pri = base_vstorage_->files_by_compaction_pri_[level];
+      next_file_to_compact_by_size_[level] = 0;
+      continue;
+    }
+
     // populate a temp vector for sorting based on size
     std::vector<Fsize> temp(files.size());
     for (size_t i = 0; i < files.size(); i++) {
@@ -2829,6 +3251,10 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
         SortFileByOverlappingRatio(*internal_comparator_, files_[level],
                                    files_[level + 1], &temp);
         break;
+      case kMaxReadAmpRatio:
+        SortFileByReadAmpRatio(*internal_comparator_, files_[level],
+                               files_[level + 1], &temp);
+        break;
       default:
         assert(false);
     }
@@ -3263,11 +3689,20 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
   int num_l0_count = static_cast<int>(files_[0].size());
-  if (compaction_style_ == kCompactionStyleUniversal) {
+  const int num_tiered_levels =
+      ioptions.compaction_style == kCompactionStyleLevel
+          ? ioptions.level_compaction_num_tiered_levels
+          : 0;
+  if (compaction_style_ == kCompactionStyleUniversal ||
+      num_tiered_levels > 1) {
     // For universal compaction, we use level0 score to indicate
     // compaction score for the whole DB. Adding other levels as if
-    // they are L0 files.
-    for (int i = 1; i < num_levels(); i++) {
+    // they are L0 files. The same goes for the tiered levels of leveled
+    // compaction.
+    const int last_run_level = compaction_style_ == kCompactionStyleUniversal
+                                   ? num_levels() - 1
+                                   : num_tiered_levels - 1;
+    for (int i = 1; i <= last_run_level; i++) {
       if (!files_[i].empty()) {
         num_l0_count++;
       }
@@ -3279,11 +3714,17 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   if (!ioptions.level_compaction_dynamic_level_bytes) {
     base_level_ = (ioptions.compaction_style == kCompactionStyleLevel) ? 1 : -1;
 
+    // The target of L1, or of the last tiered level with tiered upper
+    // levels, is max_bytes_for_level_base, and that of each following level
+    // is larger by the multiplier. (The tiered levels above it are not
+    // scored by size.)
+    const int first_target_level = std::max(num_tiered_levels - 1, 1);
+
     // Calculate for static bytes base case
     for (int i = 0; i < ioptions.num_levels; ++i) {
       if (i == 0 && ioptions.compaction_style == kCompactionStyleUniversal) {
         level_max_bytes_[i] = options.max_bytes_for_level_base;
-      } else if (i > 1) {
+      } else if (i > first_target_level) {
         level_max_bytes_[i] = MultiplyCheckOverflow(
             MultiplyCheckOverflow(level_max_bytes_[i - 1],
                                   options.max_bytes_for_level_multiplier),
@@ -3643,6 +4084,7 @@ VersionSet::VersionSet(const std::string& dbname,
       prev_log_number_(0),
       current_version_number_(0),
       manifest_file_size_(0),
+      manifest_snapshot_size_(0),
       file_options_(storage_options),
       block_cache_tracer_(block_cache_tracer) {}
 
@@ -3684,6 +4126,7 @@ void VersionSet::Reset() {
   current_version_number_ = 0;
   manifest_writers_.clear();
   manifest_file_size_ = 0;
+  manifest_snapshot_size_ = 0;
   obsolete_files_.clear();
   obsolete_manifests_.clear();
 }
@@ -3879,12 +4322,31 @@ Status VersionSet::ProcessManifestWrites(
 #endif  // NDEBUG
 
   uint64_t new_manifest_file_size = 0;
+  uint64_t new_manifest_snapshot_size = 0;
   Status s;
   IOStatus io_s;
 
+  // Edits appended to the manifest after its initial snapshot of the DB state
+  // are replayed on DB::Open, so start a new one with a fresh snapshot once
+  // they outgrow the snapshot by the configured ratio. Tails below a few MB
+  // are quick to replay whatever the size of the snapshot, so they never
+  // cause a roll over.
+  uint64_t min_manifest_tail_size = 4 << 20;
+  TEST_SYNC_POINT_CALLBACK("VersionSet::ProcessManifestWrites:MinTailSize",
+                           &min_manifest_tail_size);
+  const uint64_t manifest_tail_size =
+      manifest_file_size_ - manifest_snapshot_size_;
+  const bool manifest_tail_too_large =
+      db_options_->max_manifest_tail_size_pct > 0 &&
+      manifest_tail_size >= min_manifest_tail_size &&
+      static_cast<double>(manifest_tail_size) >
+          static_cast<double>(manifest_snapshot_size_) *
+              db_options_->max_manifest_tail_size_pct / 100;
+
   assert(pending_manifest_file_number_ == 0);
   if (!descriptor_log_ ||
-      manifest_file_size_ > db_options_->max_manifest_file_size) {
+      manifest_file_size_ > db_options_->max_manifest_file_size ||
+      manifest_tail_too_large) {
     TEST_SYNC_POINT("VersionSet::ProcessManifestWrites:BeforeNewManifest");
     new_descriptor_log = true;
   } else {
@@ -3959,6 +4421,7 @@ Status VersionSet::ProcessManifestWrites(
         descriptor_log_.reset(
             new log::Writer(std::move(file_writer), 0, false));
         s = WriteCurrentStateToManifest(curr_state, descriptor_log_.get());
+        new_manifest_snapshot_size = descriptor_log_->file()->GetFileSize();
       }
     }
 
@@ -4094,6 +4557,9 @@ Status VersionSet::ProcessManifestWrites(
     }
     manifest_file_number_ = pending_manifest_file_number_;
     manifest_file_size_ = new_manifest_file_size;
+    if (new_descriptor_log) {
+      manifest_snapshot_size_ = new_manifest_snapshot_size;
+    }
     prev_log_number_ = first_writer.edit_list.front()->prev_log_number_;
   } else {
     std::string version_edits;
@@ -4654,14 +5120,17 @@ Status VersionSet::Recover(
       assert(builders_iter != builders.end());
       auto builder = builders_iter->second->version_builder();
 
-      // unlimited table cache. Pre-load table handle now.
+      // unlimited table cache. Pre-load table handle now, unless the files
+      // are to be opened on first access.
       // Need to do it out of the mutex.
-      s = builder->LoadTableHandlers(
-          cfd->internal_stats(), db_options_->max_file_opening_threads,
-          false /* prefetch_index_and_filter_in_cache */,
-          true /* is_initial_load */,
-          cfd->GetLatestMutableCFOptions()->prefix_extractor.get(),
-          MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()));
+      if (!db_options_->skip_opening_table_readers_on_db_open) {
+        s = builder->LoadTableHandlers(
+            cfd->internal_stats(), db_options_->max_file_opening_threads,
+            false /* prefetch_index_and_filter_in_cache */,
+            true /* is_initial_load */,
+            cfd->GetLatestMutableCFOptions()->prefix_extractor.get(),
+            MaxFileSizeForL0MetaPin(*cfd->GetLatestMutableCFOptions()));
+      }
       if (!s.ok()) {
         if (db_options_->paranoid_checks) {
           return s;
@@ -5362,7 +5831,8 @@ Status VersionSet::WriteCurrentStateToManifest(
                        f->fd.smallest_seqno, f->fd.largest_seqno,
                        f->marked_for_compaction, f->oldest_blob_file_number,
                        f->oldest_ancester_time, f->file_creation_time,
-                       f->file_checksum, f->file_checksum_func_name);
+                       f->file_checksum, f->file_checksum_func_name,
+                       f->temperature);
         }
       }
 
@@ -5731,6 +6201,57 @@ InternalIterator* VersionSet::MakeInputIterator(
   return result;
 }
 
+Status VersionSet::AddInputRangeTombstones(
+    const Compaction* c, const Slice* start, const Slice* end,
+    CompactionRangeDelAggregator* range_del_agg) {
+  assert(range_del_agg != nullptr);
+  auto cfd = c->column_family_data();
+  const Comparator* ucmp = cfd->user_comparator();
+  // Same as in MakeInputIterator().
+  ReadOptions read_options;
+  read_options.verify_checksums = true;
+  read_options.fill_cache = false;
+  read_options.total_order_seek = true;
+
+  for (size_t which = 0; which < c->num_input_levels(); which++) {
+    const LevelFilesBrief* flevel = c->input_levels(which);
+    // Tombstones are truncated to the atomic compaction unit boundaries of
+    // their file, like LevelIterator does for the levels below L0.
+    const std::vector<AtomicCompactionUnitBoundary>* boundaries =
+        c->level(which) == 0 ? nullptr : c->boundaries(which);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      const FileMetaData& f = *flevel->files[i].file_metadata;
+      if ((start != nullptr &&
+           ucmp->Compare(f.largest.user_key(), *start) < 0) ||
+          (end != nullptr &&
+           ucmp->Compare(f.smallest.user_key(), *end) >= 0)) {
+        continue;
+      }
+      std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter;
+      Status s = cfd->table_cache()->GetRangeTombstoneIterator(
+          read_options, cfd->internal_comparator(), f, &range_del_iter);
+      if (!s.ok()) {
+        return s;
+      }
+      if (range_del_iter != nullptr) {
+        s = range_del_iter->status();
+        if (!s.ok()) {
+          return s;
+        }
+      }
+      const InternalKey* smallest = &f.smallest;
+      const InternalKey* largest = &f.largest;
+      if (boundaries != nullptr) {
+        smallest = (*boundaries)[i].smallest;
+        largest = (*boundaries)[i].largest;
+      }
+      range_del_agg->AddTombstones(std::move(range_del_iter), smallest,
+                                   largest);
+    }
+  }
+  return Status::OK();
+}
+
 // verify that the files listed in this compaction are present
 // in the current version
 bool VersionSet::VerifyCompactionFileConsistency(Compaction* c) {
@@ -5836,6 +6357,7 @@ void VersionSet::GetLiveFilesMetaData(std::vector<LiveFileMetaData>* metadata) {
         filemetadata.being_compacted = file->being_compacted;
         filemetadata.num_entries = file->num_entries;
         filemetadata.num_deletions = file->num_deletions;
+        filemetadata.read_amp_score = file->ReadAmpScore();
         filemetadata.oldest_blob_file_number = file->oldest_blob_file_number;
         filemetadata.file_checksum = file->file_checksum;
         filemetadata.file_checksum_func_name = file->file_checksum_func_name;
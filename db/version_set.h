@@ -128,8 +128,21 @@ class VersionStorageInfo {
   // Update num_non_empty_levels_.
   void UpdateNumNonEmptyLevels();
 
+  // Records that the files of the levels flagged in `unchanged_levels` are
+  // the same as in `base`, which this is being built from. The state derived
+  // from these levels only is then copied from `base` instead of being
+  // recomputed, so that the cost of preparing a new version mostly depends on
+  // the levels its edits touch. `base` must stay alive until
+  // ClearUnchangedLevels() is called.
+  void SetUnchangedLevels(const VersionStorageInfo* base,
+                          std::vector<bool> unchanged_levels);
+  void ClearUnchangedLevels();
+
   void GenerateFileIndexer() {
-    file_indexer_.UpdateIndex(&arena_, num_non_empty_levels_, files_);
+    file_indexer_.UpdateIndex(
+        &arena_, num_non_empty_levels_, files_,
+        base_vstorage_ != nullptr ? &base_vstorage_->file_indexer_ : nullptr,
+        unchanged_levels_);
   }
 
   // Update the accumulated stats from a file-meta.
@@ -166,6 +179,11 @@ class VersionStorageInfo {
       const ImmutableCFOptions& ioptions,
       const uint64_t periodic_compaction_seconds);
 
+  // This computes files_marked_for_temperature_change_ and is called by
+  // ComputeCompactionScore()
+  void ComputeFilesMarkedForTemperatureChange(
+      const ImmutableCFOptions& ioptions, const uint64_t cold_file_age_seconds);
+
   // This computes bottommost_files_marked_for_compaction_ and is called by
   // ComputeCompactionScore() or UpdateOldestSnapshot().
   //
@@ -377,6 +395,14 @@ class VersionStorageInfo {
     files_marked_for_periodic_compaction_.emplace_back(level, f);
   }
 
+  // REQUIRES: This version has been saved (see VersionSet::SaveTo)
+  // REQUIRES: DB mutex held during access
+  const autovector<std::pair<int, FileMetaData*>>&
+  FilesMarkedForTemperatureChange() const {
+    assert(finalized_);
+    return files_marked_for_temperature_change_;
+  }
+
   // REQUIRES: This version has been saved (see VersionSet::SaveTo)
   // REQUIRES: DB mutex held during access
   const autovector<std::pair<int, FileMetaData*>>&
@@ -505,6 +531,9 @@ class VersionStorageInfo {
   // A short brief metadata of files per level
   autovector<ROCKSDB_NAMESPACE::LevelFilesBrief> level_files_brief_;
   FileIndexer file_indexer_;
+  // See SetUnchangedLevels(). Only set while the version is being prepared.
+  const VersionStorageInfo* base_vstorage_;
+  std::vector<bool> unchanged_levels_;
   Arena arena_;  // Used to allocate space for file_levels_
 
   CompactionStyle compaction_style_;
@@ -557,6 +586,11 @@ class VersionStorageInfo {
   autovector<std::pair<int, FileMetaData*>>
       files_marked_for_periodic_compaction_;
 
+  // Files old enough and read rarely enough to be rewritten as
+  // Temperature::kCold. See cold_file_age_seconds.
+  autovector<std::pair<int, FileMetaData*>>
+      files_marked_for_temperature_change_;
+
   // These files are considered bottommost because none of their keys can exist
   // at lower levels. They are not necessarily all in the same level. The marked
   // ones are eligible for compaction because they contain duplicate key
@@ -674,6 +708,13 @@ class Version {
   void MultiGet(const ReadOptions&, MultiGetRange* range,
                 ReadCallback* callback = nullptr, bool* is_blob = nullptr);
 
+  // Retrieves the value referenced by the blob index `blob_index_slice`,
+  // written for user_key by a flush or compaction with enable_blob_files.
+  // The blob file must be part of this version. `blob_index_slice` may point
+  // into `*value`.
+  Status GetBlob(const ReadOptions& read_options, const Slice& user_key,
+                 const Slice& blob_index_slice, PinnableSlice* value) const;
+
   // Loads some stats information from files. Call without mutex held. It needs
   // to be called before applying the version to the version set.
   void PrepareApply(const MutableCFOptions& mutable_cf_options,
@@ -745,6 +786,20 @@ class Version {
 
   VersionSet* version_set() { return vset_; }
 
+  // Computes up to num_partitions - 1 user keys that split the user key
+  // range [begin, end) of this version into partitions holding roughly the
+  // same amount of table data. A nullptr begin or end means the range is
+  // unbounded on that side. The boundaries are stored in ascending order in
+  // *boundaries and the approximate size of each of the resulting
+  // boundaries->size() + 1 partitions is stored in *partition_sizes.
+  // Boundaries are sampled from the index blocks of the overlapping files,
+  // falling back to file boundaries for tables that cannot be sampled.
+  Status GetRangePartitions(const ReadOptions& read_options,
+                            const Slice* begin, const Slice* end,
+                            size_t num_partitions,
+                            std::vector<std::string>* boundaries,
+                            std::vector<uint64_t>* partition_sizes);
+
   void GetColumnFamilyMetaData(ColumnFamilyMetaData* cf_meta);
 
   uint64_t GetSstFilesSize();
@@ -776,6 +831,13 @@ class Version {
   // that it eventually expires from the cache.
   bool IsFilterSkipped(int level, bool is_file_last_in_level = false);
 
+  // Used by MultiGet() with ReadOptions::async_io. Groups the keys in range
+  // by the files of the given level that may contain them and, if more than
+  // one file is involved, issues read-ahead for the data blocks of all of
+  // them before the files are looked up one by one.
+  void MultiGetPrefetchLevel(const ReadOptions& read_options, int level,
+                             const MultiGetRange& range);
+
   // The helper function of UpdateAccumulatedStats, which may fill the missing
   // fields of file_meta from its associated TableProperties.
   // Returns true if it does initialize FileMetaData.
@@ -1108,6 +1170,15 @@ class VersionSet {
       const Compaction* c, RangeDelAggregator* range_del_agg,
       const FileOptions& file_options_compactions);
 
+  // Add the range tombstones of the compaction inputs for "*c" whose files
+  // overlap the user key range [start, end) to *range_del_agg, as the
+  // iterator returned by MakeInputIterator() would while iterating over that
+  // range. A nullptr start or end means the range is unbounded on that side.
+  // Used when the input iterator is made without an aggregator.
+  Status AddInputRangeTombstones(const Compaction* c, const Slice* start,
+                                 const Slice* end,
+                                 CompactionRangeDelAggregator* range_del_agg);
+
   // Add all files listed in any live version to *live_table_files and
   // *live_blob_files. Note that these lists may contain duplicates.
   void AddLiveFiles(std::vector<uint64_t>* live_table_files,
@@ -1281,6 +1352,9 @@ class VersionSet {
   // Current size of manifest file
   uint64_t manifest_file_size_;
 
+  // Size of the snapshot of the DB state at the start of the manifest file
+  uint64_t manifest_snapshot_size_;
+
   std::vector<ObsoleteFileInfo> obsolete_files_;
   std::vector<ObsoleteBlobFileInfo> obsolete_blob_files_;
   std::vector<std::string> obsolete_manifests_;
@@ -684,6 +684,63 @@ TEST_F(FindLevelFileTest, LevelOverlappingFiles) {
   ASSERT_TRUE(Overlaps("600", "700"));
 }
 
+TEST_F(FindLevelFileTest, LevelKeyPrefixes) {
+  // Boundaries that share prefixes of 8 bytes and more, are shorter than 8
+  // bytes or contain zero bytes, which pad the packed prefixes of short keys.
+  const std::vector<std::pair<std::string, std::string>> ranges = {
+      {"a", "abcdefgh"},
+      {std::string("abcdefgh\0", 9), "abcdefgh1"},
+      {"abcdefgh2", "abcdefgh9"},
+      {"abcdefgi", "b"},
+      {std::string("b\0", 2), std::string("b\0\1", 3)},
+      {"c", "zzzzzzzzzz"}};
+  std::vector<FileMetaData*> files;
+  for (const auto& range : ranges) {
+    FileMetaData* f = new FileMetaData();
+    f->fd = FileDescriptor(files.size() + 1, 0, 0);
+    f->smallest = InternalKey(range.first, 100, kTypeValue);
+    f->largest = InternalKey(range.second, 100, kTypeValue);
+    files.push_back(f);
+  }
+  DoGenerateLevelFilesBrief(&file_level_, files, &arena_);
+  ASSERT_NE(nullptr, file_level_.largest_key_prefixes);
+  LevelFilesBrief keys_only = file_level_;
+  keys_only.largest_key_prefixes = nullptr;
+
+  std::vector<std::string> targets = {"",
+                                      std::string("a\0", 2),
+                                      "abcdefg",
+                                      std::string("abcdefgh\0\0", 10),
+                                      "abcdefgh0",
+                                      "abcdefgz",
+                                      std::string("b\0\0", 3),
+                                      std::string("b\0\1\0", 4),
+                                      "zzzzzzzzzzz",
+                                      "\xff"};
+  for (const auto& range : ranges) {
+    targets.push_back(range.first);
+    targets.push_back(range.second);
+  }
+  InternalKeyComparator cmp(BytewiseComparator());
+  for (const auto& target : targets) {
+    for (SequenceNumber seq : {kMaxSequenceNumber, SequenceNumber{100},
+                               SequenceNumber{0}}) {
+      InternalKey key(target, seq, kTypeValue);
+      ASSERT_EQ(FindFile(cmp, keys_only, key.Encode()),
+                FindFile(cmp, file_level_, key.Encode()));
+    }
+  }
+  ASSERT_EQ(0, Find("abcdefgh"));
+  ASSERT_EQ(1, Find("abcdefgh0"));
+  ASSERT_EQ(3, Find("abcdefgz"));
+  ASSERT_EQ(5, Find("c"));
+  ASSERT_EQ(6, Find("zzzzzzzzzzz"));
+
+  for (FileMetaData* f : files) {
+    delete f;
+  }
+}
+
 class VersionSetTestBase {
  public:
   const static std::string kColumnFamilyName1;
@@ -17,6 +17,7 @@
 #include <unordered_set>
 #include <atomic>
 #include <list>
+#include <numeric>
 
 #ifdef OS_LINUX
 #include <fcntl.h>
@@ -35,6 +36,7 @@
 #include "port/malloc.h"
 #include "port/port.h"
 #include "rocksdb/env.h"
+#include "rocksdb/threadpool.h"
 #include "test_util/fault_injection_test_env.h"
 #include "test_util/fault_injection_test_fs.h"
 #include "test_util/sync_point.h"
@@ -1349,6 +1351,82 @@ TEST_F(EnvPosixTest, MultiReadNonAlignedLargeNum) {
   }
 }
 
+#ifndef OS_WIN
+TEST_F(EnvPosixTest, ReadAsync) {
+  std::shared_ptr<FileSystem> fs = FileSystem::Default();
+  std::string fname = test::PerThreadDBPath(env_, "testfile");
+
+  const size_t kBlockSize = 4096;
+  const size_t kNumBlocks = 8;
+  {
+    std::unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, EnvOptions()));
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      ASSERT_OK(
+          wfile->Append(std::string(kBlockSize, static_cast<char>('a' + i))));
+    }
+    ASSERT_OK(wfile->Close());
+  }
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_OK(fs->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+
+  std::vector<FSReadRequest> reqs(kNumBlocks);
+  std::vector<std::string> scratches(kNumBlocks, std::string(kBlockSize, 0));
+  std::vector<void*> io_handles(kNumBlocks);
+  std::vector<IOHandleDeleter> del_fns(kNumBlocks);
+  std::vector<int> num_callbacks(kNumBlocks);
+  auto submit_reads = [&]() {
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      num_callbacks[i] = 0;
+      reqs[i].offset = (kNumBlocks - 1 - i) * kBlockSize;
+      reqs[i].len = kBlockSize;
+      reqs[i].scratch = &scratches[i][0];
+      ASSERT_OK(file->ReadAsync(
+          reqs[i], IOOptions(),
+          [&](const FSReadRequest& req, void* cb_arg) {
+            size_t idx = reinterpret_cast<size_t>(cb_arg);
+            ASSERT_EQ(&reqs[idx], &req);
+            ++num_callbacks[idx];
+          },
+          reinterpret_cast<void*>(i), &io_handles[i], &del_fns[i], nullptr));
+    }
+  };
+  auto free_handles = [&]() {
+    for (size_t i = 0; i < kNumBlocks; ++i) {
+      if (io_handles[i] != nullptr) {
+        del_fns[i](io_handles[i]);
+        io_handles[i] = nullptr;
+      }
+    }
+  };
+
+  submit_reads();
+  ASSERT_OK(fs->Poll(io_handles, 1));
+  ASSERT_GE(std::accumulate(num_callbacks.begin(), num_callbacks.end(), 0), 1);
+  ASSERT_OK(fs->Poll(io_handles, kNumBlocks));
+  // Polling completed reads again doesn't call their callbacks again.
+  ASSERT_OK(fs->Poll(io_handles, kNumBlocks));
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(1, num_callbacks[i]);
+    ASSERT_OK(reqs[i].status);
+    const char expected = static_cast<char>('a' + kNumBlocks - 1 - i);
+    ASSERT_EQ(std::string(kBlockSize, expected), reqs[i].result.ToString());
+  }
+  free_handles();
+
+  // The callbacks of aborted reads are not called.
+  submit_reads();
+  ASSERT_OK(fs->AbortIO(io_handles));
+  ASSERT_OK(fs->Poll(io_handles, kNumBlocks));
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(0, num_callbacks[i]);
+  }
+  free_handles();
+
+  ASSERT_OK(env_->DeleteFile(fname));
+}
+#endif  // !OS_WIN
+
 // Only works in linux platforms
 #ifdef OS_WIN
 TEST_P(EnvPosixTestWithParam, DISABLED_InvalidateCache) {
@@ -2170,6 +2248,85 @@ TEST_F(EnvTest, MultipleCompositeEnv) {
   ASSERT_EQ(env2->GetBackgroundThreads(Env::HIGH), 8);
 }
 
+TEST_F(EnvTest, WorkStealingThreadPool) {
+  std::unique_ptr<ThreadPool> thread_pool(NewWorkStealingThreadPool(4));
+  ASSERT_EQ(4, thread_pool->GetBackgroundThreads());
+
+  const int kSubmitters = 4;
+  const int kJobsPerSubmitter = 1000;
+  std::atomic<int> num_finished(0);
+  for (int round = 0; round < 2; round++) {
+    std::vector<port::Thread> submitters;
+    for (int i = 0; i < kSubmitters; i++) {
+      submitters.emplace_back([&]() {
+        for (int j = 0; j < kJobsPerSubmitter; j++) {
+          thread_pool->SubmitJob([&]() { num_finished++; });
+        }
+      });
+    }
+    for (auto& submitter : submitters) {
+      submitter.join();
+    }
+    // All jobs run before the threads exit, and the pool can be used again
+    // afterwards.
+    thread_pool->WaitForJobsAndJoinAllThreads();
+    ASSERT_EQ((round + 1) * kSubmitters * kJobsPerSubmitter,
+              num_finished.load());
+    ASSERT_EQ(0U, thread_pool->GetQueueLen());
+    thread_pool->SetBackgroundThreads(2);
+  }
+  thread_pool->JoinAllThreads();
+}
+
+TEST_F(EnvTest, WorkStealingEnv) {
+  constexpr int kWaitMicros = 60000000;  // 1min
+  std::unique_ptr<Env> env(NewWorkStealingEnv(Env::Default()));
+  env->SetBackgroundThreads(1, Env::Priority::HIGH);
+  env->SetBackgroundThreads(1, Env::Priority::LOW);
+
+  // Start the LOW thread.
+  test::SleepingBackgroundTask low_task;
+  env->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &low_task,
+                Env::Priority::LOW);
+  ASSERT_FALSE(low_task.TimedWaitUntilSleeping(kWaitMicros));
+  low_task.WakeUp();
+  ASSERT_FALSE(low_task.TimedWaitUntilDone(kWaitMicros));
+
+  // Block the HIGH thread. The idle LOW thread runs the next HIGH job.
+  test::SleepingBackgroundTask high_tasks[3];
+  env->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &high_tasks[0],
+                Env::Priority::HIGH);
+  ASSERT_FALSE(high_tasks[0].TimedWaitUntilSleeping(kWaitMicros));
+  env->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &high_tasks[1],
+                Env::Priority::HIGH);
+  ASSERT_FALSE(high_tasks[1].TimedWaitUntilSleeping(kWaitMicros));
+  ASSERT_EQ(0U, env->GetThreadPoolQueueLen(Env::Priority::HIGH));
+
+  // Neither pool has an idle thread, so jobs wait in their queue and can be
+  // unscheduled.
+  env->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &low_task,
+                Env::Priority::LOW, &low_task);
+  ASSERT_EQ(1U, env->GetThreadPoolQueueLen(Env::Priority::LOW));
+  ASSERT_EQ(1, env->UnSchedule(&low_task, Env::Priority::LOW));
+  ASSERT_EQ(0U, env->GetThreadPoolQueueLen(Env::Priority::LOW));
+
+  // A pool running at a lowered IO priority does not steal.
+  env->LowerThreadPoolIOPriority(Env::Priority::LOW);
+  high_tasks[1].WakeUp();
+  ASSERT_FALSE(high_tasks[1].TimedWaitUntilDone(kWaitMicros));
+  env->Schedule(&test::SleepingBackgroundTask::DoSleepTask, &high_tasks[2],
+                Env::Priority::HIGH);
+  Env::Default()->SleepForMicroseconds(kDelayMicros);
+  ASSERT_EQ(1U, env->GetThreadPoolQueueLen(Env::Priority::HIGH));
+  ASSERT_FALSE(high_tasks[2].IsSleeping());
+
+  high_tasks[0].WakeUp();
+  ASSERT_FALSE(high_tasks[0].TimedWaitUntilDone(kWaitMicros));
+  ASSERT_FALSE(high_tasks[2].TimedWaitUntilSleeping(kWaitMicros));
+  high_tasks[2].WakeUp();
+  ASSERT_FALSE(high_tasks[2].TimedWaitUntilDone(kWaitMicros));
+}
+
 TEST_F(EnvTest, IsDirectory) {
   Status s = Env::Default()->CreateDirIfMissing(test_directory_);
   ASSERT_OK(s);
@@ -258,7 +258,7 @@ class PosixFileSystem : public FileSystem {
           options
 #if defined(ROCKSDB_IOURING_PRESENT)
           ,
-          thread_local_io_urings_.get()
+          thread_local_io_urings_.get(), thread_local_async_io_urings_.get()
 #endif
               ));
     }
@@ -903,6 +903,15 @@ class PosixFileSystem : public FileSystem {
     return io_s;
   }
 
+  IOStatus Poll(std::vector<void*>& io_handles,
+                size_t min_completions) override {
+    return PollPosixAsyncReads(io_handles, min_completions);
+  }
+
+  IOStatus AbortIO(std::vector<void*>& io_handles) override {
+    return AbortPosixAsyncReads(io_handles);
+  }
+
   FileOptions OptimizeForLogWrite(const FileOptions& file_options,
                                  const DBOptions& db_options) const override {
     FileOptions optimized = file_options;
@@ -973,6 +982,8 @@ class PosixFileSystem : public FileSystem {
 #if defined(ROCKSDB_IOURING_PRESENT)
   // io_uring instance
   std::unique_ptr<ThreadLocalPtr> thread_local_io_urings_;
+  // io_uring instance for asynchronous reads
+  std::unique_ptr<ThreadLocalPtr> thread_local_async_io_urings_;
 #endif
 
   size_t page_size_;
@@ -1034,6 +1045,7 @@ PosixFileSystem::PosixFileSystem()
   struct io_uring* new_io_uring = CreateIOUring();
   if (new_io_uring != nullptr) {
     thread_local_io_urings_.reset(new ThreadLocalPtr(DeleteIOUring));
+    thread_local_async_io_urings_.reset(new ThreadLocalPtr(DeleteIOUring));
     delete new_io_uring;
   }
 #endif
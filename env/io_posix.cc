@@ -37,6 +37,7 @@
 #include "util/autovector.h"
 #include "util/coding.h"
 #include "util/string_util.h"
+#include "util/threadpool_imp.h"
 
 #if defined(OS_LINUX) && !defined(F_SET_RW_HINT)
 #define F_LINUX_SPECIFIC_BASE 1024
@@ -545,7 +546,8 @@ PosixRandomAccessFile::PosixRandomAccessFile(
     const EnvOptions& options
 #if defined(ROCKSDB_IOURING_PRESENT)
     ,
-    ThreadLocalPtr* thread_local_io_urings
+    ThreadLocalPtr* thread_local_io_urings,
+    ThreadLocalPtr* thread_local_async_io_urings
 #endif
     )
     : filename_(fname),
@@ -554,7 +556,8 @@ PosixRandomAccessFile::PosixRandomAccessFile(
       logical_sector_size_(logical_block_size)
 #if defined(ROCKSDB_IOURING_PRESENT)
       ,
-      thread_local_io_urings_(thread_local_io_urings)
+      thread_local_io_urings_(thread_local_io_urings),
+      thread_local_async_io_urings_(thread_local_async_io_urings)
 #endif
 {
   assert(!options.use_direct_reads || !options.use_mmap_reads);
@@ -747,6 +750,225 @@ IOStatus PosixRandomAccessFile::MultiRead(FSReadRequest* reqs,
 #endif
 }
 
+namespace {
+// Number of threads that run the reads of PosixRandomAccessFile::ReadAsync()
+// if no io_uring is available.
+const int kAsyncReadThreads = 4;
+
+ThreadPoolImpl* AsyncReadThreadPool() {
+  // Never destroyed, like the default Env, so that its threads don't have to
+  // be joined at exit.
+  static ThreadPoolImpl* const pool = [] {
+    ThreadPoolImpl* new_pool = new ThreadPoolImpl();
+    new_pool->SetThreadPriority(Env::Priority::USER);
+    new_pool->SetBackgroundThreads(kAsyncReadThreads);
+    return new_pool;
+  }();
+  return pool;
+}
+
+void RunAsyncRead(PosixAsyncReadHandle* handle) {
+  {
+    MutexLock l(&handle->mu);
+    if (handle->aborted) {
+      handle->done = true;
+      handle->cv.SignalAll();
+      return;
+    }
+  }
+  FSReadRequest* req = handle->req;
+  IOStatus s = handle->file->Read(req->offset, req->len, handle->opts,
+                                  &req->result, req->scratch, nullptr);
+  MutexLock l(&handle->mu);
+  req->status = s;
+  handle->done = true;
+  handle->cv.SignalAll();
+}
+
+#if defined(ROCKSDB_IOURING_PRESENT)
+// Waits for the next completion of iu and finishes the read it belongs to,
+// which need not be one the caller is waiting for.
+void ReapAsyncReadCompletion(struct io_uring* iu) {
+  // Submits what a failed io_uring_submit() left in the submission queue.
+  io_uring_submit(iu);
+  struct io_uring_cqe* cqe;
+  int ret = io_uring_wait_cqe(iu, &cqe);
+  if (ret == -EINTR) {
+    return;
+  }
+  assert(!ret);
+  auto* handle = static_cast<PosixAsyncReadHandle*>(io_uring_cqe_get_data(cqe));
+  int res = cqe->res;
+  io_uring_cqe_seen(iu, cqe);
+  // The completions of cancellations have no handle.
+  if (handle != nullptr) {
+    handle->file->FinishAsyncRead(handle, res);
+  }
+}
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
+bool IsAsyncReadDone(PosixAsyncReadHandle* handle) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (handle->iu != nullptr) {
+    return handle->done;
+  }
+#endif
+  MutexLock l(&handle->mu);
+  return handle->done;
+}
+
+void WaitForAsyncRead(PosixAsyncReadHandle* handle) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (handle->iu != nullptr) {
+    while (!handle->done) {
+      ReapAsyncReadCompletion(handle->iu);
+    }
+    return;
+  }
+#endif
+  MutexLock l(&handle->mu);
+  while (!handle->done) {
+    handle->cv.Wait();
+  }
+}
+}  // namespace
+
+void DeletePosixAsyncReadHandle(void* io_handle) {
+  delete static_cast<PosixAsyncReadHandle*>(io_handle);
+}
+
+IOStatus PollPosixAsyncReads(std::vector<void*>& io_handles,
+                             size_t min_completions) {
+  min_completions = std::min(min_completions, io_handles.size());
+  while (true) {
+    size_t num_completed = 0;
+    PosixAsyncReadHandle* pending = nullptr;
+    for (void* io_handle : io_handles) {
+      auto* handle = static_cast<PosixAsyncReadHandle*>(io_handle);
+      if (handle == nullptr || handle->delivered) {
+        ++num_completed;
+      } else if (IsAsyncReadDone(handle)) {
+        handle->delivered = true;
+        handle->cb(*handle->req, handle->cb_arg);
+        ++num_completed;
+      } else if (pending == nullptr) {
+        pending = handle;
+      }
+    }
+    if (num_completed >= min_completions || pending == nullptr) {
+      break;
+    }
+    WaitForAsyncRead(pending);
+  }
+  return IOStatus::OK();
+}
+
+IOStatus AbortPosixAsyncReads(std::vector<void*>& io_handles) {
+  for (void* io_handle : io_handles) {
+    auto* handle = static_cast<PosixAsyncReadHandle*>(io_handle);
+    if (handle == nullptr || handle->delivered) {
+      continue;
+    }
+#if defined(ROCKSDB_IOURING_PRESENT)
+    if (handle->iu != nullptr) {
+      struct io_uring_sqe* sqe =
+          handle->done ? nullptr : io_uring_get_sqe(handle->iu);
+      // Without a free submission queue entry, the read is waited for below.
+      if (sqe != nullptr) {
+        io_uring_prep_cancel(sqe, handle, 0);
+        io_uring_sqe_set_data(sqe, nullptr);
+        io_uring_submit(handle->iu);
+      }
+      continue;
+    }
+#endif
+    MutexLock l(&handle->mu);
+    handle->aborted = true;
+  }
+  for (void* io_handle : io_handles) {
+    auto* handle = static_cast<PosixAsyncReadHandle*>(io_handle);
+    if (handle == nullptr || handle->delivered) {
+      continue;
+    }
+    WaitForAsyncRead(handle);
+    handle->delivered = true;
+  }
+  return IOStatus::OK();
+}
+
+IOStatus PosixRandomAccessFile::ReadAsync(
+    FSReadRequest& req, const IOOptions& opts,
+    std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+    void** io_handle, IOHandleDeleter* del_fn, IODebugContext* /*dbg*/) {
+  if (use_direct_io()) {
+    assert(IsSectorAligned(req.offset, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(req.len, GetRequiredBufferAlignment()));
+    assert(IsSectorAligned(req.scratch, GetRequiredBufferAlignment()));
+  }
+  auto* handle =
+      new PosixAsyncReadHandle(this, &req, opts, std::move(cb), cb_arg);
+  *io_handle = handle;
+  *del_fn = DeletePosixAsyncReadHandle;
+
+#if defined(ROCKSDB_IOURING_PRESENT)
+  struct io_uring* iu = nullptr;
+  if (thread_local_async_io_urings_) {
+    iu = static_cast<struct io_uring*>(thread_local_async_io_urings_->Get());
+    if (iu == nullptr) {
+      iu = CreateIOUring();
+      if (iu != nullptr) {
+        thread_local_async_io_urings_->Reset(iu);
+      }
+    }
+  }
+  // If the submission queue is full, the read is handed to the thread pool.
+  struct io_uring_sqe* sqe = iu != nullptr ? io_uring_get_sqe(iu) : nullptr;
+  if (sqe != nullptr) {
+    handle->iu = iu;
+    handle->iov.iov_base = req.scratch;
+    handle->iov.iov_len = req.len;
+    io_uring_prep_readv(sqe, fd_, &handle->iov, 1, req.offset);
+    io_uring_sqe_set_data(sqe, handle);
+    // If this fails, e.g. because the completion queue is full, the read
+    // stays in the submission queue and is submitted again when it is polled.
+    io_uring_submit(iu);
+    return IOStatus::OK();
+  }
+#endif
+
+  AsyncReadThreadPool()->SubmitJob([handle]() { RunAsyncRead(handle); });
+  return IOStatus::OK();
+}
+
+void PosixRandomAccessFile::FinishAsyncRead(PosixAsyncReadHandle* handle,
+                                            int res) const {
+  FSReadRequest* req = handle->req;
+  if (res < 0) {
+    req->result = Slice(req->scratch, 0);
+    req->status = IOError("Req failed", filename_, -res);
+  } else if (static_cast<size_t>(res) < req->len) {
+    // Like in MultiRead(), a short read can mean EOF or a partial result, so
+    // the rest is read with pread(), unless direct I/O ended in the middle of
+    // a sector, which only happens at the end of the file.
+    size_t bytes_read = static_cast<size_t>(res);
+    if (use_direct_io() &&
+        !IsSectorAligned(bytes_read, GetRequiredBufferAlignment())) {
+      req->result = Slice(req->scratch, bytes_read);
+      req->status = IOStatus::OK();
+    } else {
+      Slice tmp_slice;
+      req->status = Read(req->offset + bytes_read, req->len - bytes_read,
+                         handle->opts, &tmp_slice, req->scratch + bytes_read,
+                         nullptr);
+      req->result = Slice(req->scratch, bytes_read + tmp_slice.size());
+    }
+  } else {
+    req->result = Slice(req->scratch, req->len);
+    req->status = IOStatus::OK();
+  }
+  handle->done = true;
+}
+
 IOStatus PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n,
                                          const IOOptions& /*opts*/,
                                          IODebugContext* /*dbg*/) {
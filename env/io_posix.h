@@ -17,6 +17,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 #include "port/port.h"
 #include "rocksdb/env.h"
 #include "rocksdb/file_system.h"
@@ -169,6 +170,58 @@ inline struct io_uring* CreateIOUring() {
 }
 #endif  // defined(ROCKSDB_IOURING_PRESENT)
 
+class PosixRandomAccessFile;
+
+// The io_handle of a read submitted by PosixRandomAccessFile::ReadAsync().
+// The read is either submitted to the io_uring for asynchronous reads of the
+// submitting thread, and completed by whoever reaps its completion from that
+// io_uring, or it is run by a thread of a pool shared by all the files.
+struct PosixAsyncReadHandle {
+  PosixAsyncReadHandle(const PosixRandomAccessFile* _file, FSReadRequest* _req,
+                       const IOOptions& _opts,
+                       std::function<void(const FSReadRequest&, void*)> _cb,
+                       void* _cb_arg)
+      : file(_file),
+        req(_req),
+        opts(_opts),
+        cb(std::move(_cb)),
+        cb_arg(_cb_arg),
+        cv(&mu) {}
+
+  const PosixRandomAccessFile* file;
+  FSReadRequest* req;
+  IOOptions opts;
+  std::function<void(const FSReadRequest&, void*)> cb;
+  void* cb_arg;
+
+  port::Mutex mu;
+  port::CondVar cv;
+  // Whether the read has finished and req holds its result. Protected by mu
+  // for reads run by the thread pool.
+  bool done = false;
+  // Whether the read was aborted. Protected by mu.
+  bool aborted = false;
+  // Whether cb was called or the read was aborted. Only used by the thread
+  // that polls the handle.
+  bool delivered = false;
+
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // The io_uring the read was submitted to, or nullptr if it was handed to
+  // the thread pool.
+  struct io_uring* iu = nullptr;
+  struct iovec iov;
+#endif
+};
+
+extern void DeletePosixAsyncReadHandle(void* io_handle);
+
+// FileSystem::Poll() and FileSystem::AbortIO() for the handles of
+// PosixRandomAccessFile::ReadAsync(). The reads submitted to an io_uring have
+// to be polled or aborted by the thread that submitted them.
+extern IOStatus PollPosixAsyncReads(std::vector<void*>& io_handles,
+                                    size_t min_completions);
+extern IOStatus AbortPosixAsyncReads(std::vector<void*>& io_handles);
+
 class PosixRandomAccessFile : public FSRandomAccessFile {
  protected:
   std::string filename_;
@@ -177,6 +230,9 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
   size_t logical_sector_size_;
 #if defined(ROCKSDB_IOURING_PRESENT)
   ThreadLocalPtr* thread_local_io_urings_;
+  // Separate from thread_local_io_urings_, as MultiRead() reaps every
+  // completion of its io_uring.
+  ThreadLocalPtr* thread_local_async_io_urings_;
 #endif
 
  public:
@@ -185,7 +241,8 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
                         const EnvOptions& options
 #if defined(ROCKSDB_IOURING_PRESENT)
                         ,
-                        ThreadLocalPtr* thread_local_io_urings
+                        ThreadLocalPtr* thread_local_io_urings,
+                        ThreadLocalPtr* thread_local_async_io_urings
 #endif
   );
   virtual ~PosixRandomAccessFile();
@@ -198,6 +255,15 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
                              const IOOptions& options,
                              IODebugContext* dbg) override;
 
+  virtual IOStatus ReadAsync(
+      FSReadRequest& req, const IOOptions& opts,
+      std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) override;
+
+  // Completes a read of ReadAsync() that returned res, the result of a
+  // pread(2), from an io_uring.
+  void FinishAsyncRead(PosixAsyncReadHandle* handle, int res) const;
+
   virtual IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& opts,
                             IODebugContext* dbg) override;
 
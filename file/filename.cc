@@ -144,6 +144,19 @@ std::string TableFileName(const std::vector<DbPath>& db_paths, uint64_t number,
   return MakeTableFileName(path, number);
 }
 
+uint32_t GetPathIdForTemperature(const std::vector<DbPath>& db_paths,
+                                 Temperature temperature,
+                                 uint32_t default_path_id) {
+  if (temperature != Temperature::kUnknown) {
+    for (size_t i = 0; i < db_paths.size(); ++i) {
+      if (db_paths[i].temperature == temperature) {
+        return static_cast<uint32_t>(i);
+      }
+    }
+  }
+  return default_path_id;
+}
+
 void FormatFileNumber(uint64_t number, uint32_t path_id, char* out_buf,
                       size_t out_buf_size) {
   if (path_id == 0) {
@@ -90,6 +90,12 @@ extern uint64_t TableFileNameToNumber(const std::string& name);
 extern std::string TableFileName(const std::vector<DbPath>& db_paths,
                                  uint64_t number, uint32_t path_id);
 
+// Return the id of the first of db_paths tagged with the given temperature,
+// or default_path_id if there is none.
+extern uint32_t GetPathIdForTemperature(const std::vector<DbPath>& db_paths,
+                                        Temperature temperature,
+                                        uint32_t default_path_id);
+
 // Sufficient buffer size for FormatFileNumber.
 const size_t kFormatFileNumberBufSize = 38;
 
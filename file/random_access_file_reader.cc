@@ -14,6 +14,7 @@
 
 #include "monitoring/histogram.h"
 #include "monitoring/iostats_context_imp.h"
+#include "monitoring/statistics.h"
 #include "port/port.h"
 #include "table/format.h"
 #include "test_util/sync_point.h"
@@ -22,13 +23,69 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-Status RandomAccessFileReader::Read(const IOOptions& opts, uint64_t offset,
-                                    size_t n, Slice* result, char* scratch,
-                                    AlignedBuf* aligned_buf,
+namespace {
+// Returns the IOOptions to issue a read with, with an unknown activity
+// replaced by the one of the current thread.
+IOOptions FillIOActivity(const IOOptions& opts, bool for_compaction) {
+  IOOptions io_opts = opts;
+  if (io_opts.activity == IOActivity::kUnknown) {
+    io_opts.activity =
+        for_compaction ? IOActivity::kCompaction : IOSTATS_IO_ACTIVITY();
+  }
+  return io_opts;
+}
+
+// Records the latency and size of a read in the histograms of its IOType and
+// IOActivity.
+void RecordIOClassStats(Statistics* stats, const IOOptions& opts,
+                        uint64_t elapsed, size_t bytes) {
+  switch (opts.type) {
+    case IOType::kData:
+      RecordTimeToHistogram(stats, FILE_READ_DATA_BLOCK_MICROS, elapsed);
+      break;
+    case IOType::kIndex:
+      RecordTimeToHistogram(stats, FILE_READ_INDEX_BLOCK_MICROS, elapsed);
+      break;
+    case IOType::kFilter:
+      RecordTimeToHistogram(stats, FILE_READ_FILTER_BLOCK_MICROS, elapsed);
+      break;
+    case IOType::kMetadata:
+      RecordTimeToHistogram(stats, FILE_READ_METADATA_BLOCK_MICROS, elapsed);
+      break;
+    default:
+      break;
+  }
+  switch (opts.activity) {
+    case IOActivity::kUserRead:
+      RecordTimeToHistogram(stats, FILE_READ_USER_MICROS, elapsed);
+      RecordInHistogram(stats, FILE_READ_USER_BYTES, bytes);
+      break;
+    case IOActivity::kFlush:
+      RecordTimeToHistogram(stats, FILE_READ_FLUSH_MICROS, elapsed);
+      RecordInHistogram(stats, FILE_READ_FLUSH_BYTES, bytes);
+      break;
+    case IOActivity::kCompaction:
+      RecordTimeToHistogram(stats, FILE_READ_COMPACTION_MICROS, elapsed);
+      RecordInHistogram(stats, FILE_READ_COMPACTION_BYTES, bytes);
+      break;
+    case IOActivity::kRecovery:
+      RecordTimeToHistogram(stats, FILE_READ_RECOVERY_MICROS, elapsed);
+      RecordInHistogram(stats, FILE_READ_RECOVERY_BYTES, bytes);
+      break;
+    default:
+      break;
+  }
+}
+}  // namespace
+
+Status RandomAccessFileReader::Read(const IOOptions& io_options,
+                                    uint64_t offset, size_t n, Slice* result,
+                                    char* scratch, AlignedBuf* aligned_buf,
                                     bool for_compaction) const {
   (void)aligned_buf;
 
   TEST_SYNC_POINT_CALLBACK("RandomAccessFileReader::Read", nullptr);
+  const IOOptions opts = FillIOActivity(io_options, for_compaction);
   Status s;
   uint64_t elapsed = 0;
   {
@@ -163,8 +220,11 @@ Status RandomAccessFileReader::Read(const IOOptions& opts, uint64_t offset,
     IOSTATS_ADD_IF_POSITIVE(bytes_read, result->size());
     SetPerfLevel(prev_perf_level);
   }
-  if (stats_ != nullptr && file_read_hist_ != nullptr) {
-    file_read_hist_->Add(elapsed);
+  if (stats_ != nullptr) {
+    if (file_read_hist_ != nullptr) {
+      file_read_hist_->Add(elapsed);
+    }
+    RecordIOClassStats(stats_, opts, elapsed, result->size());
   }
 
   return s;
@@ -202,13 +262,16 @@ bool TryMerge(FSReadRequest* dest, const FSReadRequest& src) {
   return true;
 }
 
-Status RandomAccessFileReader::MultiRead(const IOOptions& opts,
+Status RandomAccessFileReader::MultiRead(const IOOptions& io_options,
                                          FSReadRequest* read_reqs,
                                          size_t num_reqs,
                                          AlignedBuf* aligned_buf) const {
   (void)aligned_buf;  // suppress warning of unused variable in LITE mode
   assert(num_reqs > 0);
+  const IOOptions opts =
+      FillIOActivity(io_options, false /* for_compaction */);
   Status s;
+  size_t total_bytes = 0;
   uint64_t elapsed = 0;
   {
     StopWatch sw(env_, stats_, hist_type_,
@@ -298,11 +361,15 @@ Status RandomAccessFileReader::MultiRead(const IOOptions& opts,
       }
 #endif  // ROCKSDB_LITE
       IOSTATS_ADD_IF_POSITIVE(bytes_read, read_reqs[i].result.size());
+      total_bytes += read_reqs[i].result.size();
     }
     SetPerfLevel(prev_perf_level);
   }
-  if (stats_ != nullptr && file_read_hist_ != nullptr) {
-    file_read_hist_->Add(elapsed);
+  if (stats_ != nullptr) {
+    if (file_read_hist_ != nullptr) {
+      file_read_hist_->Add(elapsed);
+    }
+    RecordIOClassStats(stats_, opts, elapsed, total_bytes);
   }
 
   return s;
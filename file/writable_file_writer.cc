@@ -11,12 +11,14 @@
 
 #include <algorithm>
 #include <mutex>
+#include <utility>
 
 #include "db/version_edit.h"
 #include "monitoring/histogram.h"
 #include "monitoring/iostats_context_imp.h"
 #include "port/port.h"
 #include "test_util/sync_point.h"
+#include "util/mutexlock.h"
 #include "util/random.h"
 #include "util/rate_limiter.h"
 
@@ -33,7 +35,9 @@ IOStatus WritableFileWriter::Append(const Slice& data) {
   // Calculate the checksum of appended data
   UpdateFileChecksum(data);
 
-  {
+  // With background writes, the background thread prepares the writes of the
+  // buffers it writes out, as it may be using the file right now.
+  if (!background_writes_) {
     IOSTATS_TIMER_GUARD(prepare_write_nanos);
     TEST_SYNC_POINT("WritableFileWriter::Append:BeforePrepareWrite");
     writable_file_->PrepareWrite(static_cast<size_t>(GetFileSize()), left,
@@ -59,7 +63,7 @@ IOStatus WritableFileWriter::Append(const Slice& data) {
   // Flush only when buffered I/O
   if (!use_direct_io() && (buf_.Capacity() - buf_.CurrentSize()) < left) {
     if (buf_.CurrentSize() > 0) {
-      s = Flush();
+      s = FlushFullBuffer();
       if (!s.ok()) {
         return s;
       }
@@ -67,17 +71,17 @@ IOStatus WritableFileWriter::Append(const Slice& data) {
     assert(buf_.CurrentSize() == 0);
   }
 
-  // We never write directly to disk with direct I/O on.
-  // or we simply use it for its original purpose to accumulate many small
-  // chunks
-  if (use_direct_io() || (buf_.Capacity() >= left)) {
+  // We never write directly to disk with direct I/O on, nor with background
+  // writes, or we simply use it for its original purpose to accumulate many
+  // small chunks
+  if (use_direct_io() || background_writes_ || (buf_.Capacity() >= left)) {
     while (left > 0) {
       size_t appended = buf_.Append(src, left);
       left -= appended;
       src += appended;
 
       if (left > 0) {
-        s = Flush();
+        s = FlushFullBuffer();
         if (!s.ok()) {
           break;
         }
@@ -109,7 +113,7 @@ IOStatus WritableFileWriter::Pad(const size_t pad_bytes) {
     buf_.PadWith(append_bytes, 0);
     left -= append_bytes;
     if (left > 0) {
-      IOStatus s = Flush();
+      IOStatus s = FlushFullBuffer();
       if (!s.ok()) {
         return s;
       }
@@ -134,6 +138,7 @@ IOStatus WritableFileWriter::Close() {
   }
 
   s = Flush();  // flush cache to OS
+  StopBackgroundThread();
 
   IOStatus interim;
   // In direct I/O mode we write whole pages so
@@ -172,6 +177,17 @@ IOStatus WritableFileWriter::Flush() {
   TEST_KILL_RANDOM("WritableFileWriter::Flush:0",
                    rocksdb_kill_odds * REDUCE_ODDS2);
 
+  if (background_writes_) {
+    // The background thread flushes the file after writing out a buffer.
+    if (buf_.CurrentSize() > 0) {
+      s = ScheduleBackgroundWrite();
+    }
+    if (s.ok()) {
+      s = WaitForBackgroundWrite();
+    }
+    return s;
+  }
+
   if (buf_.CurrentSize() > 0) {
     if (use_direct_io()) {
 #ifndef ROCKSDB_LITE
@@ -181,13 +197,20 @@ IOStatus WritableFileWriter::Flush() {
 #endif  // !ROCKSDB_LITE
     } else {
       s = WriteBuffered(buf_.BufferStart(), buf_.CurrentSize());
+      if (s.ok()) {
+        buf_.Size(0);
+      }
     }
     if (!s.ok()) {
       return s;
     }
   }
 
-  s = writable_file_->Flush(IOOptions(), nullptr);
+  return FlushFile(filesize_);
+}
+
+IOStatus WritableFileWriter::FlushFile(uint64_t file_size) {
+  IOStatus s = writable_file_->Flush(IOOptions(), nullptr);
 
   if (!s.ok()) {
     return s;
@@ -208,8 +231,8 @@ IOStatus WritableFileWriter::Flush() {
     const uint64_t kBytesNotSyncRange =
         1024 * 1024;                                // recent 1MB is not synced.
     const uint64_t kBytesAlignWhenSync = 4 * 1024;  // Align 4KB.
-    if (filesize_ > kBytesNotSyncRange) {
-      uint64_t offset_sync_to = filesize_ - kBytesNotSyncRange;
+    if (file_size > kBytesNotSyncRange) {
+      uint64_t offset_sync_to = file_size - kBytesNotSyncRange;
       offset_sync_to -= offset_sync_to % kBytesAlignWhenSync;
       assert(offset_sync_to >= last_sync_size_);
       if (offset_sync_to > 0 &&
@@ -343,7 +366,111 @@ IOStatus WritableFileWriter::WriteBuffered(const char* data, size_t size) {
     left -= allowed;
     src += allowed;
   }
-  buf_.Size(0);
+  return s;
+}
+
+IOStatus WritableFileWriter::FlushFullBuffer() {
+  if (background_writes_) {
+    return ScheduleBackgroundWrite();
+  }
+  return Flush();
+}
+
+IOStatus WritableFileWriter::ScheduleBackgroundWrite() {
+  assert(background_writes_);
+  assert(buf_.CurrentSize() > 0);
+  IOStatus s = WaitForBackgroundWrite();
+  if (!s.ok()) {
+    return s;
+  }
+  if (!bg_thread_) {
+    bg_thread_.reset(new port::Thread([this] { BGWorkWrite(); }));
+  }
+  // bg_buf_ is empty now. Give it at least the capacity of the buffer being
+  // handed over, so the two stay interchangeable as the buffer grows.
+  std::swap(buf_, bg_buf_);
+  if (buf_.Capacity() < bg_buf_.Capacity()) {
+    buf_.AllocateNewBuffer(bg_buf_.Capacity());
+  }
+  bg_file_size_ += bg_buf_.CurrentSize();
+  bg_perf_level_ = GetPerfLevel();
+
+  MutexLock l(&bg_mutex_);
+  bg_pending_ = true;
+  bg_cv_.SignalAll();
+  return s;
+}
+
+IOStatus WritableFileWriter::WaitForBackgroundWrite() {
+  MutexLock l(&bg_mutex_);
+  while (bg_pending_) {
+    bg_cv_.Wait();
+  }
+  // Account the IOs of the background thread to the caller's thread, as if
+  // it had issued them itself.
+  IOSTATS_ADD(bytes_written, bg_iostats_.bytes_written);
+  IOSTATS_ADD(write_nanos, bg_iostats_.write_nanos);
+  IOSTATS_ADD(range_sync_nanos, bg_iostats_.range_sync_nanos);
+  IOSTATS_ADD(prepare_write_nanos, bg_iostats_.prepare_write_nanos);
+  IOSTATS_ADD(cpu_write_nanos, bg_iostats_.cpu_write_nanos);
+  bg_iostats_ = IOStatsContext();
+  return bg_status_;
+}
+
+void WritableFileWriter::StopBackgroundThread() {
+  if (!bg_thread_) {
+    return;
+  }
+  {
+    MutexLock l(&bg_mutex_);
+    bg_stop_ = true;
+    bg_cv_.SignalAll();
+  }
+  bg_thread_->join();
+  bg_thread_.reset();
+}
+
+void WritableFileWriter::BGWorkWrite() {
+  MutexLock l(&bg_mutex_);
+  while (true) {
+    while (!bg_pending_ && !bg_stop_) {
+      bg_cv_.Wait();
+    }
+    if (!bg_pending_) {
+      break;
+    }
+    bg_mutex_.Unlock();
+    IOStatus s = WriteBackground();
+    bg_mutex_.Lock();
+    if (!s.ok() && bg_status_.ok()) {
+      bg_status_ = s;
+    }
+    bg_iostats_.bytes_written += IOSTATS(bytes_written);
+    bg_iostats_.write_nanos += IOSTATS(write_nanos);
+    bg_iostats_.range_sync_nanos += IOSTATS(range_sync_nanos);
+    bg_iostats_.prepare_write_nanos += IOSTATS(prepare_write_nanos);
+    bg_iostats_.cpu_write_nanos += IOSTATS(cpu_write_nanos);
+    bg_pending_ = false;
+    bg_cv_.SignalAll();
+  }
+}
+
+IOStatus WritableFileWriter::WriteBackground() {
+  SetPerfLevel(bg_perf_level_);
+  IOSTATS_RESET_ALL();
+  IOSTATS_RESET(cpu_write_nanos);
+
+  const size_t size = bg_buf_.CurrentSize();
+  {
+    IOSTATS_TIMER_GUARD(prepare_write_nanos);
+    writable_file_->PrepareWrite(static_cast<size_t>(bg_file_size_ - size),
+                                 size, IOOptions(), nullptr);
+  }
+  IOStatus s = WriteBuffered(bg_buf_.BufferStart(), size);
+  bg_buf_.Size(0);
+  if (s.ok()) {
+    s = FlushFile(bg_file_size_);
+  }
   return s;
 }
 
@@ -9,6 +9,7 @@
 
 #pragma once
 #include <atomic>
+#include <memory>
 #include <string>
 #include "db/version_edit.h"
 #include "port/port.h"
@@ -16,7 +17,9 @@
 #include "rocksdb/file_checksum.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/io_status.h"
+#include "rocksdb/iostats_context.h"
 #include "rocksdb/listener.h"
+#include "rocksdb/perf_level.h"
 #include "rocksdb/rate_limiter.h"
 #include "test_util/sync_point.h"
 #include "util/aligned_buffer.h"
@@ -31,6 +34,10 @@ class Statistics;
 // - Flush and Sync the data to the underlying filesystem.
 // - Notify any interested listeners on the completion of a write.
 // - Update IO stats.
+// - Write out full buffers on a background thread, if
+//   FileOptions::background_writes is set (buffered writes only). The thread
+//   owns the file while it writes a buffer, and the caller fills a second
+//   buffer in the meantime. Flush(), Sync() and Close() wait for it.
 class WritableFileWriter {
  private:
 #ifndef ROCKSDB_LITE
@@ -76,6 +83,25 @@ class WritableFileWriter {
   std::unique_ptr<FileChecksumGenerator> checksum_generator_;
   bool checksum_finalized_;
 
+  // State of the background writes. bg_buf_, bg_file_size_ and bg_perf_level_
+  // are only accessed by the background thread while a write is pending.
+  bool background_writes_;
+  AlignedBuffer bg_buf_;
+  // The size of the file once the pending write is done.
+  uint64_t bg_file_size_;
+  PerfLevel bg_perf_level_;
+  port::Mutex bg_mutex_;
+  port::CondVar bg_cv_;
+  // Protected by bg_mutex_.
+  bool bg_pending_;
+  bool bg_stop_;
+  // The first error of a background write. No more writes are issued after
+  // it.
+  IOStatus bg_status_;
+  // IO stats of the background writes not yet added to the caller's thread.
+  IOStatsContext bg_iostats_;
+  std::unique_ptr<port::Thread> bg_thread_;
+
  public:
   WritableFileWriter(
       std::unique_ptr<FSWritableFile>&& file, const std::string& _file_name,
@@ -99,11 +125,23 @@ class WritableFileWriter {
         stats_(stats),
         listeners_(),
         checksum_generator_(nullptr),
-        checksum_finalized_(false) {
+        checksum_finalized_(false),
+        background_writes_(options.background_writes),
+        bg_buf_(),
+        bg_file_size_(0),
+        bg_perf_level_(PerfLevel::kDisable),
+        bg_cv_(&bg_mutex_),
+        bg_pending_(false),
+        bg_stop_(false),
+        bg_iostats_() {
     TEST_SYNC_POINT_CALLBACK("WritableFileWriter::WritableFileWriter:0",
                              reinterpret_cast<void*>(max_buffer_size_));
     buf_.Alignment(writable_file_->GetRequiredBufferAlignment());
     buf_.AllocateNewBuffer(std::min((size_t)65536, max_buffer_size_));
+    if (use_direct_io()) {
+      background_writes_ = false;
+    }
+    bg_buf_.Alignment(buf_.Alignment());
 #ifndef ROCKSDB_LITE
     std::for_each(listeners.begin(), listeners.end(),
                   [this](const std::shared_ptr<EventListener>& e) {
@@ -152,6 +190,12 @@ class WritableFileWriter {
   uint64_t GetFileSize() const { return filesize_; }
 
   IOStatus InvalidateCache(size_t offset, size_t length) {
+    if (background_writes_) {
+      IOStatus s = WaitForBackgroundWrite();
+      if (!s.ok()) {
+        return s;
+      }
+    }
     return writable_file_->InvalidateCache(offset, length);
   }
 
@@ -178,7 +222,23 @@ class WritableFileWriter {
 #endif  // !ROCKSDB_LITE
   // Normal write
   IOStatus WriteBuffered(const char* data, size_t size);
+  // Flushes the file, and range syncs it every bytes_per_sync_ bytes, given
+  // that `file_size` bytes have been written to it.
+  IOStatus FlushFile(uint64_t file_size);
   IOStatus RangeSync(uint64_t offset, uint64_t nbytes);
   IOStatus SyncInternal(bool use_fsync);
+
+  // Writes out the buffer once it is full: hands it to the background thread
+  // with background writes, flushes it otherwise.
+  IOStatus FlushFullBuffer();
+  // Waits for the pending background write, then hands the buffer to the
+  // background thread and swaps in the other one.
+  IOStatus ScheduleBackgroundWrite();
+  // Waits for the pending background write, if any, and returns the status of
+  // the background writes.
+  IOStatus WaitForBackgroundWrite();
+  void StopBackgroundThread();
+  void BGWorkWrite();
+  IOStatus WriteBackground();
 };
 }  // namespace ROCKSDB_NAMESPACE
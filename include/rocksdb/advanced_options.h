@@ -54,6 +54,30 @@ enum CompactionPri : char {
   // and its size is the smallest. It in many cases can optimize write
   // amplification.
   kMinOverlappingRatio = 0x3,
+  // First compact files with the highest read amplification score (sampled
+  // reads, weighted by the file's tombstone density) per byte the
+  // compaction would rewrite, i.e. its size plus the overlapping size in the
+  // next level. Files that have not been read are ordered as in
+  // kMinOverlappingRatio. Useful for read-heavy workloads with skewed key
+  // access, where compacting hot files first reduces the number of files
+  // point lookups probe.
+  kMaxReadAmpRatio = 0x4,
+};
+
+// How often the data of an SST file is expected to be accessed. It is passed
+// to the FileSystem as a hint when the file is created (see
+// FileOptions::temperature), and files are placed in the first of cf_paths
+// (or db_paths) tagged with their temperature, if any (see DbPath).
+enum class Temperature : uint8_t {
+  kUnknown = 0,
+  // Fresh data: files written by flushes and intra-L0 compactions.
+  kHot = 1,
+  // Files written by compactions into non-bottommost levels.
+  kWarm = 2,
+  // Files written by compactions into the bottommost level, by compactions
+  // of cold or old enough data, and files migrated because of
+  // cold_file_age_seconds.
+  kCold = 3,
 };
 
 struct CompactionOptionsFIFO {
@@ -514,6 +538,26 @@ struct AdvancedColumnFamilyOptions {
   // Default: false
   bool level_compaction_dynamic_level_bytes = false;
 
+  // EXPERIMENTAL
+  // With level-based compaction, when set to K > 1, the first K levels
+  // (L0 to L(K-1)) are size-tiered and the remaining levels are leveled.
+  // Every L0 file and every non-empty level among L1 to L(K-1) is a sorted
+  // run of the tiered part, which is compacted like universal compaction
+  // (see compaction_options_universal): once it holds
+  // level0_file_num_compaction_trigger sorted runs, runs of similar size are
+  // merged into one, which lowers write amplification compared to leveled
+  // compaction. L(K-1) is the largest run of the tiered part; its target
+  // size is max_bytes_for_level_base, and once it exceeds it, its files are
+  // compacted into L(K) like in leveled compaction. The targets of the lower
+  // levels grow by max_bytes_for_level_multiplier from there.
+  //
+  // level_compaction_dynamic_level_bytes is ignored when this is set.
+  // Values of K >= num_levels are reduced to num_levels - 1; 0 and 1 mean
+  // plain leveled compaction. Not supported in ROCKSDB_LITE.
+  //
+  // Default: 0
+  int level_compaction_num_tiered_levels = 0;
+
   // Default: 10.
   //
   // Dynamically changeable through SetOptions() API
@@ -715,6 +759,80 @@ struct AdvancedColumnFamilyOptions {
   // data is left uncompressed (unless compression is also requested).
   uint64_t sample_for_compression = 0;
 
+  // When set, flush and compaction write values of at least min_blob_size
+  // bytes to separate blob files, and store only a reference to the blob in
+  // the SST files. The blob files are tracked in the MANIFEST alongside the
+  // table files, and Get, MultiGet and iterators transparently read the
+  // values back. This avoids rewriting large values at every compaction,
+  // reducing write amplification when values are large compared to keys.
+  // Not supported together with a merge operator, or in RocksDB lite.
+  //
+  // Default: false
+  bool enable_blob_files = false;
+
+  // The size of the smallest value to be stored in a blob file when
+  // enable_blob_files is set. Smaller values are kept in the SST files.
+  //
+  // Default: 0
+  uint64_t min_blob_size = 0;
+
+  // A new blob file is started once the current one reaches this size.
+  //
+  // Default: 256MB
+  uint64_t blob_file_size = 1ULL << 28;
+
+  // The compression algorithm applied to the values written to blob files.
+  //
+  // Default: kNoCompression
+  CompressionType blob_compression_type;
+
+  // When set, compactions relocate the live blobs they encounter in the
+  // oldest blob files to new blob files (or inline them into the output SST
+  // files if enable_blob_files is not set), so that the old blob files turn
+  // into garbage and get deleted. Compactions always record the garbage they
+  // produce (blobs of overwritten or deleted keys) in the MANIFEST, and blob
+  // files are deleted once all their blobs are garbage.
+  //
+  // Default: false
+  bool enable_blob_garbage_collection = false;
+
+  // The fraction of blob files, oldest first, whose blobs are relocated by
+  // compactions when enable_blob_garbage_collection is set. Must be in the
+  // range [0.0, 1.0].
+  //
+  // Default: 0.25
+  double blob_garbage_collection_age_cutoff = 0.25;
+
+  // EXPERIMENTAL
+  // If set to N > 1, compactions into L1 and below replace every run of at
+  // least N consecutive point deletions (Delete()) in their output by a
+  // single range tombstone, as long as that deletes nothing else: the run
+  // must not be split by a snapshot, and the files outside of the compaction
+  // must hold no other keys in the range than older versions of the deleted
+  // ones, which is checked by reading them. This shrinks the output and lets
+  // iterators skip the deleted range at once instead of one tombstone at a
+  // time. Not used at the bottommost level, where the deletions are dropped
+  // anyway, with allow_ingest_behind or preserve_deletes, or with
+  // transactions that use a snapshot checker.
+  //
+  // Default: 0 (disabled)
+  size_t compaction_deletion_run_threshold = 0;
+
+  // EXPERIMENTAL
+  // If non-zero, leveled compaction rewrites the files of L1 and below whose
+  // data is older than this many seconds (by the flush time of the oldest
+  // file that contributed to them) and that have not been read since the DB
+  // was opened, as far as read sampling tells, as Temperature::kCold files
+  // in the same level. Together with a DbPath tagged with kCold, this moves
+  // data to cheaper storage as it cools down. Files that are already cold are
+  // left alone, and compactions whose inputs are all cold or older than this
+  // write cold files.
+  //
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetOptions() API
+  uint64_t cold_file_age_seconds = 0;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
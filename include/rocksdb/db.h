@@ -699,6 +699,27 @@ class DB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) = 0;
 
+  // Splits the key range of the column family between
+  // options.iterate_lower_bound and options.iterate_upper_bound (either may be
+  // nullptr for an unbounded side) into at most num_partitions consecutive
+  // sub-ranges holding roughly the same amount of data, and returns one
+  // iterator per sub-range in *iterators, in key order. The split points are
+  // sampled from the index blocks of the SST files, so the partitions are
+  // approximate; data in memtables is not taken into account.
+  //
+  // All the iterators read from the same consistent state of the column
+  // family, so they can be consumed by different threads to scan the range in
+  // parallel. Each iterator is bounded to its own sub-range and, if
+  // options.readahead_size is set, gets a readahead size no larger than the
+  // approximate size of its sub-range. The iterators do not support Refresh().
+  // They are heap allocated and need to be deleted before the db is deleted.
+  virtual Status NewPartitionedIterators(
+      const ReadOptions& /*options*/, ColumnFamilyHandle* /*column_family*/,
+      size_t /*num_partitions*/, std::vector<Iterator*>* /*iterators*/) {
+    return Status::NotSupported(
+        "NewPartitionedIterators() is not implemented.");
+  }
+
   // Return a handle to the current DB state.  Iterators created with
   // this handle will all observe a stable snapshot of the current DB
   // state.  The caller must call ReleaseSnapshot(result) when the
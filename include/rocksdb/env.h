@@ -1640,6 +1640,15 @@ Status NewHdfsEnv(Env** hdfs_env, const std::string& fsname);
 // This is a factory method for TimedEnv defined in utilities/env_timed.cc.
 Env* NewTimedEnv(Env* base_env);
 
+// Returns a new environment that runs the background jobs of Schedule() on
+// work-stealing thread pools: every worker has a queue of its own, threads
+// are started as jobs are queued, and idle LOW and BOTTOM priority workers
+// run the queued jobs of the pools of higher priority, so that flushes need
+// not wait for a HIGH priority thread. All other calls go to base_env.
+// This is a factory method for WorkStealingEnv defined in
+// util/work_stealing_thread_pool.cc.
+Env* NewWorkStealingEnv(Env* base_env);
+
 // Returns an instance of logger that can be used for storing informational
 // messages.
 // This is a factory method for EnvLogger declared in logging/env_logging.h
@@ -72,6 +72,17 @@ enum class IOType : uint8_t {
   kInvalid,
 };
 
+// The activity on whose behalf an IO is issued. Like IOType, it can be passed
+// down for the FileSystem implementation to tell apart, for example, user
+// reads from compaction reads.
+enum class IOActivity : uint8_t {
+  kUserRead,
+  kFlush,
+  kCompaction,
+  kRecovery,
+  kUnknown,
+};
+
 // Per-request options that can be passed down to the FileSystem
 // implementation. These are hints and are not necessarily guaranteed to be
 // honored. More hints can be added here in the future to indicate things like
@@ -86,7 +97,15 @@ struct IOOptions {
   // Type of data being read/written
   IOType type;
 
-  IOOptions() : timeout(0), prio(IOPriority::kIOLow), type(IOType::kUnknown) {}
+  // Activity the data is read/written for. If kUnknown, RocksDB fills in the
+  // activity of the calling thread, if known, before issuing the IO.
+  IOActivity activity;
+
+  IOOptions()
+      : timeout(0),
+        prio(IOPriority::kIOLow),
+        type(IOType::kUnknown),
+        activity(IOActivity::kUnknown) {}
 };
 
 // File scope options that control how a file is opened/created and accessed
@@ -97,6 +116,15 @@ struct FileOptions : EnvOptions {
   // to be issued for the file open/creation
   IOOptions io_options;
 
+  // The temperature of the SST file to create, as a hint for the placement of
+  // its data. Only set by NewWritableFile() for SST files.
+  Temperature temperature = Temperature::kUnknown;
+
+  // If true, the WritableFileWriter of a file opened with buffered writes
+  // writes out each full buffer on a background thread while it fills the
+  // next one. Only set for the SST files written by flushes and compactions.
+  bool background_writes = false;
+
   FileOptions() : EnvOptions() {}
 
   FileOptions(const DBOptions& opts)
@@ -106,7 +134,10 @@ struct FileOptions : EnvOptions {
     : EnvOptions(opts) {}
 
   FileOptions(const FileOptions& opts)
-    : EnvOptions(opts), io_options(opts.io_options) {}
+    : EnvOptions(opts),
+      io_options(opts.io_options),
+      temperature(opts.temperature),
+      background_writes(opts.background_writes) {}
 
   FileOptions& operator=(const FileOptions& opts) = default;
 };
@@ -530,6 +561,27 @@ class FileSystem {
                                const IOOptions& options, bool* is_dir,
                                IODebugContext* /*dgb*/) = 0;
 
+  // EXPERIMENTAL
+  // Waits until at least min_completions of the asynchronous reads in
+  // io_handles, submitted with FSRandomAccessFile::ReadAsync() of files of
+  // this FileSystem, have completed, and calls the callbacks of all the
+  // completed ones that were not called yet. nullptr handles count as
+  // completed. The handles have to be freed by the caller.
+  virtual IOStatus Poll(std::vector<void*>& /*io_handles*/,
+                        size_t /*min_completions*/) {
+    return IOStatus::OK();
+  }
+
+  // EXPERIMENTAL
+  // Cancels the asynchronous reads in io_handles, submitted with
+  // FSRandomAccessFile::ReadAsync() of files of this FileSystem, that have not
+  // been polled yet, and waits until none of them is in flight anymore. Their
+  // callbacks are not called, and their requests are left in an unspecified
+  // state. The handles have to be freed by the caller.
+  virtual IOStatus AbortIO(std::vector<void*>& /*io_handles*/) {
+    return IOStatus::OK();
+  }
+
   // If you're adding methods here, remember to add them to EnvWrapper too.
 
  private:
@@ -611,6 +663,10 @@ struct FSReadRequest {
   IOStatus status;
 };
 
+// Frees the io_handle of an asynchronous read. See
+// FSRandomAccessFile::ReadAsync().
+typedef void (*IOHandleDeleter)(void*);
+
 // A file abstraction for randomly reading the contents of a file.
 class FSRandomAccessFile {
  public:
@@ -657,6 +713,33 @@ class FSRandomAccessFile {
     return IOStatus::OK();
   }
 
+  // EXPERIMENTAL
+  // Submits a read of req.len bytes at req.offset into req.scratch and
+  // returns without waiting for it. Once the read has completed, cb is called
+  // with req, whose result and status are set, and cb_arg. If the read is
+  // still in flight when this returns, *io_handle is set to a handle of it,
+  // which has to be passed to FileSystem::Poll() to wait for the read and
+  // have cb called, or to FileSystem::AbortIO() to cancel it, and then freed
+  // with *del_fn. Otherwise *io_handle is set to nullptr and cb has already
+  // been called. req, its scratch and this file must stay alive until the
+  // read has completed or been aborted.
+  //
+  // A non-OK return status means that the read could not be submitted, and
+  // cb is not called.
+  //
+  // The default implementation reads synchronously.
+  virtual IOStatus ReadAsync(
+      FSReadRequest& req, const IOOptions& options,
+      std::function<void(const FSReadRequest&, void*)> cb, void* cb_arg,
+      void** io_handle, IOHandleDeleter* del_fn, IODebugContext* dbg) {
+    *io_handle = nullptr;
+    *del_fn = nullptr;
+    req.status =
+        Read(req.offset, req.len, options, &req.result, req.scratch, dbg);
+    cb(req, cb_arg);
+    return IOStatus::OK();
+  }
+
   // Tries to get an unique ID for this file that will be the same each time
   // the file is opened (and will stay the same while the file is open).
   // Furthermore, it tries to make this ID at most "max_size" bytes. If such an
@@ -1205,6 +1288,13 @@ class FileSystemWrapper : public FileSystem {
                        bool* is_dir, IODebugContext* dbg) override {
     return target_->IsDirectory(path, options, is_dir, dbg);
   }
+  IOStatus Poll(std::vector<void*>& io_handles,
+                size_t min_completions) override {
+    return target_->Poll(io_handles, min_completions);
+  }
+  IOStatus AbortIO(std::vector<void*>& io_handles) override {
+    return target_->AbortIO(io_handles);
+  }
 
  private:
   std::shared_ptr<FileSystem> target_;
@@ -1251,6 +1341,13 @@ class FSRandomAccessFileWrapper : public FSRandomAccessFile {
                      const IOOptions& options, IODebugContext* dbg) override {
     return target_->MultiRead(reqs, num_reqs, options, dbg);
   }
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& options,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    return target_->ReadAsync(req, options, std::move(cb), cb_arg, io_handle,
+                              del_fn, dbg);
+  }
   IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
                     IODebugContext* dbg) override {
     return target_->Prefetch(offset, n, options, dbg);
@@ -62,6 +62,7 @@ struct SstFileMetaData {
         being_compacted(false),
         num_entries(0),
         num_deletions(0),
+        read_amp_score(0),
         oldest_blob_file_number(0) {}
 
   SstFileMetaData(const std::string& _file_name, uint64_t _file_number,
@@ -85,6 +86,7 @@ struct SstFileMetaData {
         being_compacted(_being_compacted),
         num_entries(0),
         num_deletions(0),
+        read_amp_score(0),
         oldest_blob_file_number(_oldest_blob_file_number),
         oldest_ancester_time(_oldest_ancester_time),
         file_creation_time(_file_creation_time),
@@ -109,6 +111,9 @@ struct SstFileMetaData {
 
   uint64_t num_entries;
   uint64_t num_deletions;
+  // Read amplification caused by the file: num_reads_sampled weighted by
+  // the fraction of deletion entries. See CompactionPri::kMaxReadAmpRatio.
+  double read_amp_score;
 
   uint64_t oldest_blob_file_number;  // The id of the oldest blob file
                                      // referenced by the file.
@@ -39,6 +39,7 @@ class ConcurrentTaskLimiter;
 class Env;
 enum InfoLogLevel : unsigned char;
 class SstFileManager;
+class SstPartitionerFactory;
 class FilterPolicy;
 class Logger;
 class MergeOperator;
@@ -308,6 +309,17 @@ struct ColumnFamilyOptions : public AdvancedColumnFamilyOptions {
   // Default: nullptr
   std::shared_ptr<ConcurrentTaskLimiter> compaction_thread_limiter = nullptr;
 
+  // EXPERIMENTAL
+  // If non-nullptr, use the given factory to create an SstPartitioner for
+  // each compaction, which can force the compaction to end an output file
+  // between two keys, e.g. so that each output file holds a single key
+  // prefix. Output files of non-L0 compactions are also ended at the end of a
+  // file of the next level once they reach half of the target file size,
+  // regardless of this option.
+  //
+  // Default: nullptr
+  std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory = nullptr;
+
   // Create ColumnFamilyOptions with default values for all fields
   ColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
@@ -342,9 +354,16 @@ enum class WALRecoveryMode : char {
 struct DbPath {
   std::string path;
   uint64_t target_size;  // Target size of total files under the path, in byte.
-
-  DbPath() : target_size(0) {}
-  DbPath(const std::string& p, uint64_t t) : path(p), target_size(t) {}
+  // If not kUnknown, SST files of this temperature are placed in the first
+  // path tagged with it, regardless of target_size. Other files are placed by
+  // target_size as usual, and DB::CompactFiles() always writes to the path
+  // it is given.
+  Temperature temperature;
+
+  DbPath() : target_size(0), temperature(Temperature::kUnknown) {}
+  DbPath(const std::string& p, uint64_t t,
+         Temperature temp = Temperature::kUnknown)
+      : path(p), target_size(t), temperature(temp) {}
 };
 
 struct DBOptions {
@@ -560,6 +579,17 @@ struct DBOptions {
   // Default: 1 (i.e. no subcompactions)
   uint32_t max_subcompactions = 1;
 
+  // EXPERIMENTAL
+  // If true, each compaction (or subcompaction) reads, decompresses and
+  // merges its input files on a separate thread, a bounded number of entries
+  // ahead of the thread that processes the entries and builds the output
+  // files. Together with CompressionOptions::parallel_threads, which
+  // compresses the output blocks on further threads, this lets a single
+  // compaction that cannot be split into subcompactions use several cores.
+  //
+  // Default: false
+  bool enable_pipelined_compaction = false;
+
   // NOT SUPPORTED ANYMORE: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -616,6 +646,22 @@ struct DBOptions {
   // reach the limit of storage capacity.
   uint64_t max_manifest_file_size = 1024 * 1024 * 1024;
 
+  // Every new manifest file starts with a snapshot of the current state of
+  // the DB (the live files of every column family), followed by the version
+  // edits applied since, and DB::Open replays the whole file. If set to a
+  // positive value, the manifest file is also rolled over once the edits
+  // after the snapshot exceed this percentage of the size of the snapshot,
+  // and 4MB, which bounds the time to open the DB by the size of its state
+  // rather than by the length of its history. Larger values write less to
+  // the manifest, smaller ones make DB::Open faster: the manifest is at most
+  // 1 + max_manifest_tail_size_pct / 100 times the size of a snapshot (or
+  // the snapshot plus 4MB of edits), and rewriting snapshots adds at most
+  // 100 / max_manifest_tail_size_pct bytes per byte of edits. The 4MB floor
+  // keeps a small DB from starting a new manifest every few edits.
+  //
+  // Default: 0 (only max_manifest_file_size applies)
+  int max_manifest_tail_size_pct = 0;
+
   // Number of shards used for table cache.
   int table_cache_numshardbits = 6;
 
@@ -991,10 +1037,43 @@ struct DBOptions {
   // Default: false
   bool skip_checking_sst_file_sizes_on_db_open = false;
 
+  // If true, then DB::Open() will not open the table readers of the existing
+  // sst files, which reads their footers, properties, index and filter
+  // blocks, even if max_open_files is -1. Each file is opened through the
+  // table cache on its first access instead, so files that are never read
+  // cost neither DB::Open() time nor memory. Files written after the DB is
+  // opened are still opened when they are added. Set
+  // skip_stats_update_on_db_open as well to keep DB::Open() from reading the
+  // table properties of some of the files.
+  //
+  // Default: false
+  bool skip_opening_table_readers_on_db_open = false;
+
   // Recovery mode to control the consistency while replaying WAL
   // Default: kPointInTimeRecovery
   WALRecoveryMode wal_recovery_mode = WALRecoveryMode::kPointInTimeRecovery;
 
+  // EXPERIMENTAL
+  // If true, DB::Open reads each WAL being recovered, and verifies the
+  // checksums of its records, on a separate thread, a bounded number of bytes
+  // ahead of the thread inserting the records into the memtables, so that the
+  // device reads overlap with the memtable inserts.
+  //
+  // Default: false
+  bool enable_pipelined_wal_recovery = false;
+
+  // EXPERIMENTAL
+  // If true, flushes and compactions hand each full write buffer of the SST
+  // file they build to a background thread and keep building the file in a
+  // second buffer while the first one is written out, so that table building
+  // overlaps with the writes (and range syncs) to the device. Every SST file
+  // being written then holds up to two buffers of
+  // writable_file_max_buffer_size bytes and a thread. Has no effect with
+  // use_direct_io_for_flush_and_compaction.
+  //
+  // Default: false
+  bool enable_background_table_file_writes = false;
+
   // if set to false then recovery will fail when a prepared
   // transaction is encountered in the WAL
   bool allow_2pc = false;
@@ -1004,6 +1083,19 @@ struct DBOptions {
   // Not supported in ROCKSDB_LITE mode!
   std::shared_ptr<Cache> row_cache = nullptr;
 
+  // A global cache for the final results of point lookups that are served
+  // from SST files. Unlike row_cache, which caches the entries of a key found
+  // in a single SST file, this caches the result of looking up a key in all
+  // the SST files of a column family, after merge operands are applied,
+  // including "not found" results. Entries are keyed by user key and are
+  // invalidated when the column family installs a new SuperVersion (e.g.
+  // after a flush or compaction).
+  // Only Get() calls that read the latest data without a snapshot, read
+  // callback, blob index or user-defined timestamp use this cache.
+  // Default: nullptr (disabled)
+  // Not supported in ROCKSDB_LITE mode!
+  std::shared_ptr<Cache> db_row_cache = nullptr;
+
 #ifndef ROCKSDB_LITE
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
@@ -1319,6 +1411,29 @@ struct ReadOptions {
   // Default: empty (every table will be scanned)
   std::function<bool(const TableProperties&)> table_filter;
 
+  // A callback to determine whether an entry should be returned by an
+  // iterator. It is passed the user key and the final value (after merge
+  // operands are applied) of each entry the iterator is about to return. If
+  // it returns false, the iterator skips the entry as if it were deleted.
+  // The value is inspected in place, so rejected entries are never copied
+  // or surfaced to the caller. The number of rejected entries is reported in
+  // PerfContext::iter_value_filtered_count. Entries that are blob indexes, as
+  // well as scans with iter_start_seqnum set, are not filtered. This option
+  // only affects Iterators and has no impact on point lookups.
+  // Default: empty (every entry is returned)
+  std::function<bool(const Slice& key, const Slice& value)>
+      iterate_value_filter;
+
+  // A callback to transform the values returned by an iterator, e.g. to
+  // extract only the fields the caller is interested in. It is passed the
+  // user key and value of each entry accepted by iterate_value_filter and
+  // stores the value the iterator should return in *projected (which is
+  // passed empty). The same exceptions as for iterate_value_filter apply.
+  // Default: empty (values are returned unmodified)
+  std::function<void(const Slice& key, const Slice& value,
+                     std::string* projected)>
+      iterate_value_projection;
+
   // Needed to support differential snapshots. Has 2 effects:
   // 1) Iterator will skip all internal keys with seqnum < iter_start_seqnum
   // 2) if this param > 0 iterator will return INTERNAL keys instead of
@@ -1356,6 +1471,27 @@ struct ReadOptions {
   // Default: std::numeric_limits<uint64_t>::max()
   uint64_t value_size_soft_limit;
 
+  // Experimental
+  //
+  // If true, batched MultiGet issues read-ahead hints for all the data blocks
+  // it may need from a level before looking up any of the keys in that level.
+  // This lets the reads for different SST files in the same level be in
+  // flight at the same time, instead of waiting for them one file after
+  // another. It has no effect with direct I/O or with read_tier set to
+  // kBlockCacheTier.
+  //
+  // Default: false
+  bool async_io;
+
+  // If true, iterators merge the memtables and SST files they read with a
+  // tournament (loser) tree instead of a binary heap. A step costs one
+  // comparison per level of the tree, and a single comparison while the
+  // same child keeps producing the smallest key, which can be cheaper when
+  // there are many L0 files or immutable memtables.
+  //
+  // Default: false
+  bool use_loser_tree_merge;
+
   ReadOptions();
   ReadOptions(bool cksum, bool cache);
 };
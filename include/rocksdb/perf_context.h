@@ -114,6 +114,10 @@ struct PerfContext {
   // How many values were fed into merge operator by iterators.
   //
   uint64_t internal_merge_count;
+  // How many entries iterators skipped because they were rejected by
+  // ReadOptions::iterate_value_filter.
+  //
+  uint64_t iter_value_filtered_count;
 
   uint64_t get_snapshot_time;        // total nanos spent on getting snapshot
   uint64_t get_from_memtable_time;   // total nanos spent on querying memtables
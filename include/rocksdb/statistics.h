@@ -366,6 +366,14 @@ enum Tickers : uint32_t {
   // # of files deleted immediately by sst file manger through delete scheduler.
   FILES_DELETED_IMMEDIATELY,
 
+  // # of Get() results served from / missing in DBOptions::db_row_cache.
+  DB_ROW_CACHE_HIT,
+  DB_ROW_CACHE_MISS,
+  // # of db_row_cache entries found but discarded because the column family
+  // installed a new SuperVersion after they were cached.
+  // REQUIRES: DB_ROW_CACHE_INVALIDATION <= DB_ROW_CACHE_MISS
+  DB_ROW_CACHE_INVALIDATION,
+
   TICKER_ENUM_MAX
 };
 
@@ -456,6 +464,23 @@ enum Histograms : uint32_t {
   FLUSH_TIME,
   SST_BATCH_SIZE,
 
+  // Latency of the reads of table file blocks, by block type. Reads issued
+  // with an unknown IOType, such as prefetches, are not recorded here.
+  FILE_READ_DATA_BLOCK_MICROS,
+  FILE_READ_INDEX_BLOCK_MICROS,
+  FILE_READ_FILTER_BLOCK_MICROS,
+  FILE_READ_METADATA_BLOCK_MICROS,
+  // Latency and size of the reads of SST and blob files, by the activity
+  // they are issued for.
+  FILE_READ_USER_MICROS,
+  FILE_READ_FLUSH_MICROS,
+  FILE_READ_COMPACTION_MICROS,
+  FILE_READ_RECOVERY_MICROS,
+  FILE_READ_USER_BYTES,
+  FILE_READ_FLUSH_BYTES,
+  FILE_READ_COMPACTION_BYTES,
+  FILE_READ_RECOVERY_BYTES,
+
   HISTOGRAM_ENUM_MAX,
 };
 
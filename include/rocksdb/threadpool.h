@@ -55,4 +55,10 @@ class ThreadPool {
 // with `num_threads` background threads.
 extern ThreadPool* NewThreadPool(int num_threads);
 
+// NewWorkStealingThreadPool() creates a ThreadPool with up to `num_threads`
+// background threads, in which every thread has a job queue of its own and
+// steals from the others once it runs out of jobs. Threads are started as
+// jobs are submitted.
+extern ThreadPool* NewWorkStealingThreadPool(int num_threads);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -193,6 +193,13 @@ class StackableDB : public DB {
     return db_->NewIterators(options, column_families, iterators);
   }
 
+  virtual Status NewPartitionedIterators(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      size_t num_partitions, std::vector<Iterator*>* iterators) override {
+    return db_->NewPartitionedIterators(options, column_family,
+                                        num_partitions, iterators);
+  }
+
   virtual const Snapshot* GetSnapshot() override { return db_->GetSnapshot(); }
 
   virtual void ReleaseSnapshot(const Snapshot* snapshot) override {
@@ -4547,6 +4547,8 @@ class CompactionPriorityJni {
         return 0x2;
       case ROCKSDB_NAMESPACE::CompactionPri::kMinOverlappingRatio:
         return 0x3;
+      case ROCKSDB_NAMESPACE::CompactionPri::kMaxReadAmpRatio:
+        return 0x4;
       default:
         return 0x0;  // undefined
     }
@@ -4565,6 +4567,8 @@ class CompactionPriorityJni {
         return ROCKSDB_NAMESPACE::CompactionPri::kOldestSmallestSeqFirst;
       case 0x3:
         return ROCKSDB_NAMESPACE::CompactionPri::kMinOverlappingRatio;
+      case 0x4:
+        return ROCKSDB_NAMESPACE::CompactionPri::kMaxReadAmpRatio;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionPri::kByCompensatedSize;
@@ -4949,6 +4953,12 @@ class TickerTypeJni {
         return -0x0E;
       case ROCKSDB_NAMESPACE::Tickers::FILES_DELETED_IMMEDIATELY:
         return -0X0F;
+      case ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_HIT:
+        return -0x10;
+      case ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_MISS:
+        return -0x11;
+      case ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_INVALIDATION:
+        return -0x12;
 
       case ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX:
         // 0x5F for backwards compatibility on current minor version.
@@ -5249,6 +5259,12 @@ class TickerTypeJni {
         return ROCKSDB_NAMESPACE::Tickers::FILES_MARKED_TRASH;
       case -0x0F:
         return ROCKSDB_NAMESPACE::Tickers::FILES_DELETED_IMMEDIATELY;
+      case -0x10:
+        return ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_HIT;
+      case -0x11:
+        return ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_MISS;
+      case -0x12:
+        return ROCKSDB_NAMESPACE::Tickers::DB_ROW_CACHE_INVALIDATION;
       case 0x5F:
         // 0x5F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX;
@@ -5361,6 +5377,30 @@ class HistogramTypeJni {
         return 0x2D;
       case ROCKSDB_NAMESPACE::Histograms::BLOB_DB_DECOMPRESSION_MICROS:
         return 0x2E;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_DATA_BLOCK_MICROS:
+        return 0x2F;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_INDEX_BLOCK_MICROS:
+        return 0x30;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_FILTER_BLOCK_MICROS:
+        return 0x31;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_METADATA_BLOCK_MICROS:
+        return 0x32;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_USER_MICROS:
+        return 0x33;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_FLUSH_MICROS:
+        return 0x34;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_COMPACTION_MICROS:
+        return 0x35;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_RECOVERY_MICROS:
+        return 0x36;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_USER_BYTES:
+        return 0x37;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_FLUSH_BYTES:
+        return 0x38;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_COMPACTION_BYTES:
+        return 0x39;
+      case ROCKSDB_NAMESPACE::Histograms::FILE_READ_RECOVERY_BYTES:
+        return 0x3A;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x1F for backwards compatibility on current minor version.
         return 0x1F;
@@ -5468,6 +5508,30 @@ class HistogramTypeJni {
         return ROCKSDB_NAMESPACE::Histograms::BLOB_DB_COMPRESSION_MICROS;
       case 0x2E:
         return ROCKSDB_NAMESPACE::Histograms::BLOB_DB_DECOMPRESSION_MICROS;
+      case 0x2F:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_DATA_BLOCK_MICROS;
+      case 0x30:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_INDEX_BLOCK_MICROS;
+      case 0x31:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_FILTER_BLOCK_MICROS;
+      case 0x32:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_METADATA_BLOCK_MICROS;
+      case 0x33:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_USER_MICROS;
+      case 0x34:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_FLUSH_MICROS;
+      case 0x35:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_COMPACTION_MICROS;
+      case 0x36:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_RECOVERY_MICROS;
+      case 0x37:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_USER_BYTES;
+      case 0x38:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_FLUSH_BYTES;
+      case 0x39:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_COMPACTION_BYTES;
+      case 0x3A:
+        return ROCKSDB_NAMESPACE::Histograms::FILE_READ_RECOVERY_BYTES;
       case 0x1F:
         // 0x1F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX;
@@ -33,7 +33,15 @@ public enum CompactionPriority {
    * and its size is the smallest. It in many cases can optimize write
    * amplification.
    */
-  MinOverlappingRatio((byte)0x3);
+  MinOverlappingRatio((byte)0x3),
+
+  /**
+   * First compact files with the highest read amplification score (sampled
+   * reads, weighted by the file's tombstone density) per byte the
+   * compaction would rewrite. Files that have not been read are ordered as
+   * in {@link #MinOverlappingRatio}.
+   */
+  MaxReadAmpRatio((byte)0x4);
 
 
   private final byte value;
@@ -159,6 +159,66 @@ public enum HistogramType {
    */
   BLOB_DB_DECOMPRESSION_MICROS((byte) 0x2E),
 
+  /**
+   * Latency of data block reads.
+   */
+  FILE_READ_DATA_BLOCK_MICROS((byte) 0x2F),
+
+  /**
+   * Latency of index block reads.
+   */
+  FILE_READ_INDEX_BLOCK_MICROS((byte) 0x30),
+
+  /**
+   * Latency of filter block reads.
+   */
+  FILE_READ_FILTER_BLOCK_MICROS((byte) 0x31),
+
+  /**
+   * Latency of other table metadata block reads.
+   */
+  FILE_READ_METADATA_BLOCK_MICROS((byte) 0x32),
+
+  /**
+   * Latency of table file reads issued for user reads.
+   */
+  FILE_READ_USER_MICROS((byte) 0x33),
+
+  /**
+   * Latency of table file reads issued for flushes.
+   */
+  FILE_READ_FLUSH_MICROS((byte) 0x34),
+
+  /**
+   * Latency of table file reads issued for compactions.
+   */
+  FILE_READ_COMPACTION_MICROS((byte) 0x35),
+
+  /**
+   * Latency of table file reads issued during DB recovery.
+   */
+  FILE_READ_RECOVERY_MICROS((byte) 0x36),
+
+  /**
+   * Size of table file reads issued for user reads.
+   */
+  FILE_READ_USER_BYTES((byte) 0x37),
+
+  /**
+   * Size of table file reads issued for flushes.
+   */
+  FILE_READ_FLUSH_BYTES((byte) 0x38),
+
+  /**
+   * Size of table file reads issued for compactions.
+   */
+  FILE_READ_COMPACTION_BYTES((byte) 0x39),
+
+  /**
+   * Size of table file reads issued during DB recovery.
+   */
+  FILE_READ_RECOVERY_BYTES((byte) 0x3A),
+
   // 0x1F for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x1F);
 
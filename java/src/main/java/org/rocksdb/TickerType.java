@@ -732,6 +732,22 @@ public enum TickerType {
      */
     FILES_DELETED_IMMEDIATELY((byte) -0x0f),
 
+    /**
+     * # of Get() results served from the DB row cache.
+     */
+    DB_ROW_CACHE_HIT((byte) -0x10),
+
+    /**
+     * # of Get() results missing in the DB row cache.
+     */
+    DB_ROW_CACHE_MISS((byte) -0x11),
+
+    /**
+     * # of DB row cache entries discarded because the column family
+     * installed a new SuperVersion after they were cached.
+     */
+    DB_ROW_CACHE_INVALIDATION((byte) -0x12),
+
     TICKER_ENUM_MAX((byte) 0x5F);
 
     private final byte value;
@@ -11,6 +11,7 @@ namespace ROCKSDB_NAMESPACE {
 
 #ifdef ROCKSDB_SUPPORT_THREAD_LOCAL
 __thread IOStatsContext iostats_context;
+__thread IOActivity iostats_io_activity = IOActivity::kUnknown;
 #endif
 
 IOStatsContext* get_iostats_context() {
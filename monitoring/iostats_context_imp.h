@@ -5,11 +5,31 @@
 //
 #pragma once
 #include "monitoring/perf_step_timer.h"
+#include "rocksdb/file_system.h"
 #include "rocksdb/iostats_context.h"
 
 #ifdef ROCKSDB_SUPPORT_THREAD_LOCAL
 namespace ROCKSDB_NAMESPACE {
 extern __thread IOStatsContext iostats_context;
+// The activity the current thread issues IOs for.
+extern __thread IOActivity iostats_io_activity;
+
+// Sets the IOActivity of the current thread for the lifetime of the guard and
+// restores the previous one on destruction.
+class IOActivityGuard {
+ public:
+  explicit IOActivityGuard(IOActivity activity)
+      : prev_activity_(iostats_io_activity) {
+    iostats_io_activity = activity;
+  }
+  ~IOActivityGuard() { iostats_io_activity = prev_activity_; }
+
+  IOActivityGuard(const IOActivityGuard&) = delete;
+  IOActivityGuard& operator=(const IOActivityGuard&) = delete;
+
+ private:
+  IOActivity prev_activity_;
+};
 }  // namespace ROCKSDB_NAMESPACE
 
 // increment a specific counter by the specified value
@@ -32,6 +52,11 @@ extern __thread IOStatsContext iostats_context;
 
 #define IOSTATS(metric) (iostats_context.metric)
 
+#define IOSTATS_IO_ACTIVITY_GUARD(activity) \
+  IOActivityGuard iostats_io_activity_guard(activity)
+
+#define IOSTATS_IO_ACTIVITY() (iostats_io_activity)
+
 // Declare and set start time of the timer
 #define IOSTATS_TIMER_GUARD(metric)                                     \
   PerfStepTimer iostats_step_timer_##metric(&(iostats_context.metric)); \
@@ -54,6 +79,9 @@ extern __thread IOStatsContext iostats_context;
 #define IOSTATS_THREAD_POOL_ID()
 #define IOSTATS(metric) 0
 
+#define IOSTATS_IO_ACTIVITY_GUARD(activity) static_cast<void>(activity)
+#define IOSTATS_IO_ACTIVITY() (IOActivity::kUnknown)
+
 #define IOSTATS_TIMER_GUARD(metric)
 #define IOSTATS_CPU_TIMER_GUARD(metric, env)   static_cast<void>(env)
 
@@ -186,6 +186,9 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
      "rocksdb.block.cache.compression.dict.add.redundant"},
     {FILES_MARKED_TRASH, "rocksdb.files.marked.trash"},
     {FILES_DELETED_IMMEDIATELY, "rocksdb.files.deleted.immediately"},
+    {DB_ROW_CACHE_HIT, "rocksdb.db.row.cache.hit"},
+    {DB_ROW_CACHE_MISS, "rocksdb.db.row.cache.miss"},
+    {DB_ROW_CACHE_INVALIDATION, "rocksdb.db.row.cache.invalidation"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -237,6 +240,19 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {BLOB_DB_DECOMPRESSION_MICROS, "rocksdb.blobdb.decompression.micros"},
     {FLUSH_TIME, "rocksdb.db.flush.micros"},
     {SST_BATCH_SIZE, "rocksdb.sst.batch.size"},
+    {FILE_READ_DATA_BLOCK_MICROS, "rocksdb.file.read.data.block.micros"},
+    {FILE_READ_INDEX_BLOCK_MICROS, "rocksdb.file.read.index.block.micros"},
+    {FILE_READ_FILTER_BLOCK_MICROS, "rocksdb.file.read.filter.block.micros"},
+    {FILE_READ_METADATA_BLOCK_MICROS,
+     "rocksdb.file.read.metadata.block.micros"},
+    {FILE_READ_USER_MICROS, "rocksdb.file.read.user.micros"},
+    {FILE_READ_FLUSH_MICROS, "rocksdb.file.read.flush.micros"},
+    {FILE_READ_COMPACTION_MICROS, "rocksdb.file.read.compaction.micros"},
+    {FILE_READ_RECOVERY_MICROS, "rocksdb.file.read.recovery.micros"},
+    {FILE_READ_USER_BYTES, "rocksdb.file.read.user.bytes"},
+    {FILE_READ_FLUSH_BYTES, "rocksdb.file.read.flush.bytes"},
+    {FILE_READ_COMPACTION_BYTES, "rocksdb.file.read.compaction.bytes"},
+    {FILE_READ_RECOVERY_BYTES, "rocksdb.file.read.recovery.bytes"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
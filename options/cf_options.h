@@ -92,6 +92,8 @@ struct ImmutableCFOptions {
 
   bool level_compaction_dynamic_level_bytes;
 
+  int level_compaction_num_tiered_levels;
+
   Options::AccessHint access_hint_on_compaction_start;
 
   bool new_table_reader_for_compaction_inputs;
@@ -102,6 +104,20 @@ struct ImmutableCFOptions {
 
   bool force_consistency_checks;
 
+  bool enable_blob_files;
+
+  uint64_t min_blob_size;
+
+  uint64_t blob_file_size;
+
+  CompressionType blob_compression_type;
+
+  bool enable_blob_garbage_collection;
+
+  double blob_garbage_collection_age_cutoff;
+
+  size_t compaction_deletion_run_threshold;
+
   bool allow_ingest_behind;
 
   bool preserve_deletes;
@@ -120,6 +136,8 @@ struct ImmutableCFOptions {
 
   std::shared_ptr<ConcurrentTaskLimiter> compaction_thread_limiter;
 
+  std::shared_ptr<SstPartitionerFactory> sst_partitioner_factory;
+
   FileChecksumGenFactory* file_checksum_gen_factory;
 };
 
@@ -151,6 +169,7 @@ struct MutableCFOptions {
         max_bytes_for_level_multiplier(options.max_bytes_for_level_multiplier),
         ttl(options.ttl),
         periodic_compaction_seconds(options.periodic_compaction_seconds),
+        cold_file_age_seconds(options.cold_file_age_seconds),
         max_bytes_for_level_multiplier_additional(
             options.max_bytes_for_level_multiplier_additional),
         compaction_options_fifo(options.compaction_options_fifo),
@@ -190,6 +209,7 @@ struct MutableCFOptions {
         max_bytes_for_level_multiplier(0),
         ttl(0),
         periodic_compaction_seconds(0),
+        cold_file_age_seconds(0),
         compaction_options_fifo(),
         max_sequential_skip_in_iterations(0),
         paranoid_file_checks(false),
@@ -242,6 +262,7 @@ struct MutableCFOptions {
   double max_bytes_for_level_multiplier;
   uint64_t ttl;
   uint64_t periodic_compaction_seconds;
+  uint64_t cold_file_age_seconds;
   std::vector<int> max_bytes_for_level_multiplier_additional;
   CompactionOptionsFIFO compaction_options_fifo;
   CompactionOptionsUniversal compaction_options_universal;
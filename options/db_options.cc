@@ -47,6 +47,7 @@ std::unordered_map<std::string, OptionTypeInfo>
         /*
          // not yet supported
           std::shared_ptr<Cache> row_cache;
+          std::shared_ptr<Cache> db_row_cache;
           std::shared_ptr<DeleteScheduler> delete_scheduler;
           std::shared_ptr<Logger> info_log;
           std::shared_ptr<RateLimiter> rate_limiter;
@@ -121,6 +122,10 @@ std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct DBOptions, skip_checking_sst_file_sizes_on_db_open),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone, 0}},
+        {"skip_opening_table_readers_on_db_open",
+         {offsetof(struct DBOptions, skip_opening_table_readers_on_db_open),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone, 0}},
         {"new_table_reader_for_compaction_inputs",
          {offsetof(struct DBOptions, new_table_reader_for_compaction_inputs),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -198,6 +203,10 @@ std::unordered_map<std::string, OptionTypeInfo>
         {"max_subcompactions",
          {offsetof(struct DBOptions, max_subcompactions), OptionType::kUInt32T,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone, 0}},
+        {"enable_pipelined_compaction",
+         {offsetof(struct DBOptions, enable_pipelined_compaction),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone, 0}},
         {"WAL_size_limit_MB",
          {offsetof(struct DBOptions, WAL_size_limit_MB), OptionType::kUInt64T,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone, 0}},
@@ -222,6 +231,10 @@ std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct DBOptions, max_manifest_file_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone, 0}},
+        {"max_manifest_tail_size_pct",
+         {offsetof(struct DBOptions, max_manifest_tail_size_pct),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone, 0}},
         {"max_total_wal_size",
          {offsetof(struct DBOptions, max_total_wal_size), OptionType::kUInt64T,
           OptionVerificationType::kNormal, OptionTypeFlags::kMutable,
@@ -272,6 +285,14 @@ std::unordered_map<std::string, OptionTypeInfo>
         {"wal_recovery_mode", OptionTypeInfo::Enum<WALRecoveryMode>(
                                   offsetof(struct DBOptions, wal_recovery_mode),
                                   &wal_recovery_mode_string_map)},
+        {"enable_pipelined_wal_recovery",
+         {offsetof(struct DBOptions, enable_pipelined_wal_recovery),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone, 0}},
+        {"enable_background_table_file_writes",
+         {offsetof(struct DBOptions, enable_background_table_file_writes),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone, 0}},
         {"enable_write_thread_adaptive_yield",
          {offsetof(struct DBOptions, enable_write_thread_adaptive_yield),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -408,11 +429,13 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       db_log_dir(options.db_log_dir),
       wal_dir(options.wal_dir),
       max_subcompactions(options.max_subcompactions),
+      enable_pipelined_compaction(options.enable_pipelined_compaction),
       max_log_file_size(options.max_log_file_size),
       log_file_time_to_roll(options.log_file_time_to_roll),
       keep_log_file_num(options.keep_log_file_num),
       recycle_log_file_num(options.recycle_log_file_num),
       max_manifest_file_size(options.max_manifest_file_size),
+      max_manifest_tail_size_pct(options.max_manifest_tail_size_pct),
       table_cache_numshardbits(options.table_cache_numshardbits),
       wal_ttl_seconds(options.WAL_ttl_seconds),
       wal_size_limit_mb(options.WAL_size_limit_MB),
@@ -446,9 +469,15 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       skip_stats_update_on_db_open(options.skip_stats_update_on_db_open),
       skip_checking_sst_file_sizes_on_db_open(
           options.skip_checking_sst_file_sizes_on_db_open),
+      skip_opening_table_readers_on_db_open(
+          options.skip_opening_table_readers_on_db_open),
       wal_recovery_mode(options.wal_recovery_mode),
+      enable_pipelined_wal_recovery(options.enable_pipelined_wal_recovery),
+      enable_background_table_file_writes(
+          options.enable_background_table_file_writes),
       allow_2pc(options.allow_2pc),
       row_cache(options.row_cache),
+      db_row_cache(options.db_row_cache),
 #ifndef ROCKSDB_LITE
       wal_filter(options.wal_filter),
 #endif  // ROCKSDB_LITE
@@ -493,6 +522,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(log,
                    "                 Options.max_manifest_file_size: %" PRIu64,
                    max_manifest_file_size);
+  ROCKS_LOG_HEADER(log, "             Options.max_manifest_tail_size_pct: %d",
+                   max_manifest_tail_size_pct);
   ROCKS_LOG_HEADER(
       log, "                  Options.log_file_time_to_roll: %" ROCKSDB_PRIszt,
       log_file_time_to_roll);
@@ -525,6 +556,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(log,
                    "                     Options.max_subcompactions: %" PRIu32,
                    max_subcompactions);
+  ROCKS_LOG_HEADER(log, "            Options.enable_pipelined_compaction: %d",
+                   enable_pipelined_compaction);
   ROCKS_LOG_HEADER(log,
                    "                        Options.WAL_ttl_seconds: %" PRIu64,
                    wal_ttl_seconds);
@@ -561,8 +594,14 @@ void ImmutableDBOptions::Dump(Logger* log) const {
   Header(
       log, "    Options.sst_file_manager.rate_bytes_per_sec: %" PRIi64,
       sst_file_manager ? sst_file_manager->GetDeleteRateBytesPerSecond() : 0);
+  ROCKS_LOG_HEADER(log, "  Options.skip_opening_table_readers_on_db_open: %d",
+                   skip_opening_table_readers_on_db_open);
   ROCKS_LOG_HEADER(log, "                      Options.wal_recovery_mode: %d",
                    static_cast<int>(wal_recovery_mode));
+  ROCKS_LOG_HEADER(log, "          Options.enable_pipelined_wal_recovery: %d",
+                   enable_pipelined_wal_recovery);
+  ROCKS_LOG_HEADER(log, "    Options.enable_background_table_file_writes: %d",
+                   enable_background_table_file_writes);
   ROCKS_LOG_HEADER(log, "                 Options.enable_thread_tracking: %d",
                    enable_thread_tracking);
   ROCKS_LOG_HEADER(log, "                 Options.enable_pipelined_write: %d",
@@ -588,6 +627,15 @@ void ImmutableDBOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "                              Options.row_cache: None");
   }
+  if (db_row_cache) {
+    ROCKS_LOG_HEADER(
+        log,
+        "                           Options.db_row_cache: %" ROCKSDB_PRIszt,
+        db_row_cache->GetCapacity());
+  } else {
+    ROCKS_LOG_HEADER(log,
+                     "                           Options.db_row_cache: None");
+  }
 #ifndef ROCKSDB_LITE
   ROCKS_LOG_HEADER(log, "                             Options.wal_filter: %s",
                    wal_filter ? wal_filter->Name() : "None");
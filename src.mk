@@ -6,8 +6,12 @@ LIB_SOURCES =                                                   \
   cache/sharded_cache.cc                                        \
   db/arena_wrapped_db_iter.cc                                   \
   db/blob/blob_file_addition.cc                                 \
+  db/blob/blob_file_builder.cc                                  \
+  db/blob/blob_file_cache.cc                                    \
   db/blob/blob_file_garbage.cc                                  \
   db/blob/blob_file_meta.cc                                     \
+  db/blob/blob_file_reader.cc                                   \
+  db/blob/blob_garbage_meter.cc                                 \
   db/blob/blob_log_format.cc                                    \
   db/blob/blob_log_reader.cc                                    \
   db/blob/blob_log_writer.cc                                    \
@@ -20,8 +24,12 @@ LIB_SOURCES =                                                   \
   db/compaction/compaction_job.cc                               \
   db/compaction/compaction_picker.cc                            \
   db/compaction/compaction_picker_fifo.cc                       \
+  db/compaction/compaction_picker_hybrid.cc                     \
   db/compaction/compaction_picker_level.cc                      \
   db/compaction/compaction_picker_universal.cc                 	\
+  db/compaction/deletion_run_converter.cc                       \
+  db/compaction/pipelined_input_iterator.cc                     \
+  db/compaction/sst_partitioner.cc                              \
   db/convenience.cc                                             \
   db/db_filesnapshot.cc                                         \
   db/db_impl/db_impl.cc                                         \
@@ -54,6 +62,7 @@ LIB_SOURCES =                                                   \
   db/memtable_list.cc                                           \
   db/merge_helper.cc                                            \
   db/merge_operator.cc                                          \
+  db/pipelined_log_reader.cc                                    \
   db/range_del_aggregator.cc                                    \
   db/range_tombstone_fragmenter.cc                              \
   db/repair.cc                                                  \
@@ -195,6 +204,7 @@ LIB_SOURCES =                                                   \
   util/string_util.cc                                           \
   util/thread_local.cc                                          \
   util/threadpool_imp.cc                                        \
+  util/work_stealing_thread_pool.cc                             \
   util/xxhash.cc                                                \
   utilities/backupable/backupable_db.cc                         \
   utilities/blob_db/blob_compaction_filter.cc                   \
@@ -312,6 +322,8 @@ MAIN_SOURCES =                                                          \
   db_stress_tool/db_stress.cc                                           \
   db/blob/blob_file_addition_test.cc                                    \
   db/blob/blob_file_garbage_test.cc                                     \
+  db/blob/blob_garbage_meter_test.cc                                    \
+  db/blob/db_blob_basic_test.cc                                         \
   db/blob/db_blob_index_test.cc                                         \
   db/column_family_test.cc                                              \
   db/compact_files_test.cc                                              \
@@ -319,6 +331,7 @@ MAIN_SOURCES =                                                          \
   db/compaction/compaction_job_test.cc                                  \
   db/compaction/compaction_job_stats_test.cc                            \
   db/compaction/compaction_picker_test.cc                               \
+  db/compaction/pipelined_input_iterator_test.cc                        \
   db/comparator_db_test.cc                                              \
   db/corruption_test.cc                                                 \
   db/cuckoo_table_db_test.cc                                            \
@@ -1666,6 +1666,7 @@ void BlockBasedTable::RetrieveMultipleBlocks(
   AlignedBuf direct_io_buf;
   {
     IOOptions opts;
+    opts.type = IOType::kData;
     IOStatus s = PrepareIOFromReadOptions(options, file->env(), opts);
     if (s.IsTimedOut()) {
       for (FSReadRequest& req : read_reqs) {
@@ -2104,6 +2105,19 @@ FragmentedRangeTombstoneIterator* BlockBasedTable::NewRangeTombstoneIterator(
       rep_->fragmented_range_dels, rep_->internal_comparator, snapshot);
 }
 
+SequenceNumber BlockBasedTable::MaxCoveringTombstoneSeqnum(
+    const ReadOptions& read_options, const Slice& user_key) {
+  if (rep_->fragmented_range_dels == nullptr) {
+    return 0;
+  }
+  SequenceNumber snapshot = kMaxSequenceNumber;
+  if (read_options.snapshot != nullptr) {
+    snapshot = read_options.snapshot->GetSequenceNumber();
+  }
+  return rep_->fragmented_range_dels->MaxCoveringTombstoneSeqnum(
+      user_key, rep_->internal_comparator.user_comparator(), snapshot);
+}
+
 bool BlockBasedTable::FullFilterKeyMayMatch(
     const ReadOptions& read_options, FilterBlockReader* filter,
     const Slice& internal_key, const bool no_io,
@@ -2688,6 +2702,122 @@ void BlockBasedTable::MultiGet(const ReadOptions& read_options,
   }
 }
 
+void BlockBasedTable::MultiGetPrefetch(const ReadOptions& read_options,
+                                       const MultiGetRange* mget_range,
+                                       const SliceTransform* prefix_extractor,
+                                       bool skip_filters) {
+  // Read-ahead is a no-op with direct IO
+  if (mget_range->empty() || read_options.read_tier == kBlockCacheTier ||
+      rep_->file->use_direct_io()) {
+    return;
+  }
+
+  MultiGetRange sst_file_range(*mget_range, mget_range->begin(),
+                               mget_range->end());
+  uint64_t tracing_mget_id = BlockCacheTraceHelper::kReservedGetId;
+  if (sst_file_range.begin()->get_context) {
+    tracing_mget_id = sst_file_range.begin()->get_context->get_tracing_get_id();
+  }
+  BlockCacheLookupContext lookup_context{
+      TableReaderCaller::kUserMultiGet, tracing_mget_id,
+      /*get_from_user_specified_snapshot=*/read_options.snapshot != nullptr};
+
+  // Consult the full filter directly rather than through
+  // FullFilterKeysMayMatch(), which records the per-level filter statistics.
+  // The MultiGet() that follows consults the filter again, so the filter
+  // counters of the perf context are restored afterwards and each key is
+  // counted once, by MultiGet().
+  FilterBlockReader* const filter =
+      !skip_filters ? rep_->filter.get() : nullptr;
+  if (filter != nullptr && !filter->IsBlockBased()) {
+    PerfContext* const perf_ctx = get_perf_context();
+    const uint64_t prev_bloom_sst_hit_count = perf_ctx->bloom_sst_hit_count;
+    const uint64_t prev_bloom_sst_miss_count = perf_ctx->bloom_sst_miss_count;
+    if (rep_->whole_key_filtering) {
+      filter->KeysMayMatch(&sst_file_range, prefix_extractor, kNotValid,
+                           false /* no_io */, &lookup_context);
+    } else if (!read_options.total_order_seek && prefix_extractor &&
+               rep_->table_properties->prefix_extractor_name.compare(
+                   prefix_extractor->Name()) == 0) {
+      filter->PrefixesMayMatch(&sst_file_range, prefix_extractor, kNotValid,
+                               false /* no_io */, &lookup_context);
+    }
+    perf_ctx->bloom_sst_hit_count = prev_bloom_sst_hit_count;
+    perf_ctx->bloom_sst_miss_count = prev_bloom_sst_miss_count;
+  }
+  if (sst_file_range.empty()) {
+    return;
+  }
+
+  IndexBlockIter iiter_on_stack;
+  bool need_upper_bound_check = false;
+  if (rep_->index_type == BlockBasedTableOptions::kHashSearch) {
+    need_upper_bound_check = PrefixExtractorChanged(
+        rep_->table_properties.get(), prefix_extractor);
+  }
+  auto iiter =
+      NewIndexIterator(read_options, need_upper_bound_check, &iiter_on_stack,
+                       sst_file_range.begin()->get_context, &lookup_context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (iiter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(iiter);
+  }
+
+  Cache* const block_cache = rep_->table_options.block_cache.get();
+  char cache_key_storage[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+  uint64_t last_offset = std::numeric_limits<uint64_t>::max();
+  uint64_t prefetch_offset = 0;
+  size_t prefetch_len = 0;
+  for (auto miter = sst_file_range.begin(); miter != sst_file_range.end();
+       ++miter) {
+    iiter->Seek(miter->ikey);
+    if (!iiter->Valid()) {
+      // Errors, if any, are reported by MultiGet()
+      continue;
+    }
+    IndexValue v = iiter->value();
+    if (!v.first_internal_key.empty() && !skip_filters &&
+        UserComparatorWrapper(rep_->internal_comparator.user_comparator())
+                .Compare(miter->ukey, ExtractUserKey(v.first_internal_key)) <
+            0) {
+      // The key falls in the gap before the block, so it won't be read
+      continue;
+    }
+    const BlockHandle& handle = v.handle;
+    if (handle.offset() == last_offset) {
+      continue;
+    }
+    last_offset = handle.offset();
+    if (block_cache != nullptr) {
+      // Probe the cache without statistics; MultiGet() does the real lookup
+      Slice cache_key =
+          GetCacheKey(rep_->cache_key_prefix, rep_->cache_key_prefix_size,
+                      handle, cache_key_storage);
+      Cache::Handle* const cache_handle = block_cache->Lookup(cache_key);
+      if (cache_handle != nullptr) {
+        block_cache->Release(cache_handle);
+        continue;
+      }
+    }
+    if (prefetch_len > 0 && handle.offset() == prefetch_offset + prefetch_len) {
+      prefetch_len += static_cast<size_t>(block_size(handle));
+      continue;
+    }
+    if (prefetch_len > 0) {
+      TEST_SYNC_POINT_CALLBACK("BlockBasedTable::MultiGetPrefetch:Prefetch",
+                               &prefetch_len);
+      rep_->file->Prefetch(prefetch_offset, prefetch_len);
+    }
+    prefetch_offset = handle.offset();
+    prefetch_len = static_cast<size_t>(block_size(handle));
+  }
+  if (prefetch_len > 0) {
+    TEST_SYNC_POINT_CALLBACK("BlockBasedTable::MultiGetPrefetch:Prefetch",
+                             &prefetch_len);
+    rep_->file->Prefetch(prefetch_offset, prefetch_len);
+  }
+}
+
 Status BlockBasedTable::Prefetch(const Slice* const begin,
                                  const Slice* const end) {
   auto& comparator = rep_->internal_comparator;
@@ -3089,6 +3219,60 @@ uint64_t BlockBasedTable::ApproximateSize(const Slice& start, const Slice& end,
                                static_cast<double>(rep_->file_size));
 }
 
+Status BlockBasedTable::ApproximateKeyAnchors(const ReadOptions& read_options,
+                                              std::vector<Anchor>* anchors) {
+  uint64_t num_blocks = rep_->table_properties->num_data_blocks;
+  uint64_t num_blocks_per_anchor =
+      (num_blocks + kMaxNumAnchors - 1) / kMaxNumAnchors;
+  if (num_blocks_per_anchor == 0) {
+    num_blocks_per_anchor = 1;
+  }
+
+  BlockCacheLookupContext context(TableReaderCaller::kUserApproximateSize);
+  IndexBlockIter iiter_on_stack;
+  ReadOptions ro = read_options;
+  ro.total_order_seek = true;
+  auto index_iter =
+      NewIndexIterator(ro, /*disable_prefix_seek=*/true,
+                       /*input_iter=*/&iiter_on_stack, /*get_context=*/nullptr,
+                       /*lookup_context=*/&context);
+  std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
+  if (index_iter != &iiter_on_stack) {
+    iiter_unique_ptr.reset(index_iter);
+  }
+
+  // Every index key separates a data block from the next one, so every
+  // num_blocks_per_anchor-th of them makes an anchor. The range sizes are
+  // the data bytes covered; the last anchor also accounts for the metadata.
+  uint64_t count = 0;
+  uint64_t prev_offset = 0;
+  uint64_t range_size = 0;
+  std::string last_key;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    const BlockHandle& handle = index_iter->value().handle;
+    uint64_t block_end = handle.offset() + block_size(handle);
+    range_size += block_end - prev_offset;
+    prev_offset = block_end;
+    if (++count % num_blocks_per_anchor == 0) {
+      anchors->emplace_back(index_iter->user_key(), range_size);
+      range_size = 0;
+    } else {
+      last_key.assign(index_iter->user_key().data(),
+                      index_iter->user_key().size());
+    }
+  }
+  if (!index_iter->status().ok()) {
+    return index_iter->status();
+  }
+  if (range_size > 0) {
+    anchors->emplace_back(last_key, range_size);
+  }
+  if (!anchors->empty() && rep_->file_size > prev_offset) {
+    anchors->back().range_size += rep_->file_size - prev_offset;
+  }
+  return Status::OK();
+}
+
 bool BlockBasedTable::TEST_FilterBlockInCache() const {
   assert(rep_ != nullptr);
   return TEST_BlockInCache(rep_->filter_handle);
@@ -69,6 +69,9 @@ class BlockBasedTable : public TableReader {
   static const size_t kMaxAutoReadaheadSize;
   static const int kMinNumFileReadsToStartAutoReadahead = 2;
 
+  // Upper bound on the number of anchors returned by ApproximateKeyAnchors()
+  static const uint64_t kMaxNumAnchors = 128;
+
   // Attempt to open the table that is stored in bytes [0..file_size)
   // of "file", and read the metadata entries necessary to allow
   // retrieving data from the table.
@@ -126,6 +129,9 @@ class BlockBasedTable : public TableReader {
   FragmentedRangeTombstoneIterator* NewRangeTombstoneIterator(
       const ReadOptions& read_options) override;
 
+  SequenceNumber MaxCoveringTombstoneSeqnum(const ReadOptions& read_options,
+                                            const Slice& user_key) override;
+
   // @param skip_filters Disables loading/accessing the filter block
   Status Get(const ReadOptions& readOptions, const Slice& key,
              GetContext* get_context, const SliceTransform* prefix_extractor,
@@ -136,6 +142,14 @@ class BlockBasedTable : public TableReader {
                 const SliceTransform* prefix_extractor,
                 bool skip_filters = false) override;
 
+  // Checks the filter and the index for the keys in mget_range and issues
+  // read-ahead for the data blocks that are not in the block cache. Adjacent
+  // blocks are coalesced into a single hint.
+  void MultiGetPrefetch(const ReadOptions& readOptions,
+                        const MultiGetContext::Range* mget_range,
+                        const SliceTransform* prefix_extractor,
+                        bool skip_filters = false) override;
+
   // Pre-fetch the disk blocks that correspond to the key range specified by
   // (kbegin, kend). The call will return error status in the event of
   // IO or iteration error.
@@ -157,6 +171,11 @@ class BlockBasedTable : public TableReader {
   uint64_t ApproximateSize(const Slice& start, const Slice& end,
                            TableReaderCaller caller) override;
 
+  // Samples the index so that the table is split into at most
+  // kMaxNumAnchors ranges of about the same number of data blocks.
+  Status ApproximateKeyAnchors(const ReadOptions& read_options,
+                               std::vector<Anchor>* anchors) override;
+
   bool TEST_BlockInCache(const BlockHandle& handle) const;
 
   // Returns true if the block for the specified key is in cache.
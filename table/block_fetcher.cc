@@ -192,6 +192,21 @@ inline void BlockFetcher::GetBlockContents() {
 #endif
 }
 
+IOType BlockFetcher::GetIOType() const {
+  switch (block_type_) {
+    case BlockType::kData:
+      return IOType::kData;
+    case BlockType::kFilter:
+      return IOType::kFilter;
+    case BlockType::kIndex:
+      return IOType::kIndex;
+    case BlockType::kInvalid:
+      return IOType::kUnknown;
+    default:
+      return IOType::kMetadata;
+  }
+}
+
 Status BlockFetcher::ReadBlockContents() {
   if (TryGetUncompressBlockFromPersistentCache()) {
     compression_type_ = kNoCompression;
@@ -206,6 +221,7 @@ Status BlockFetcher::ReadBlockContents() {
     }
   } else if (!TryGetCompressedBlockFromPersistentCache()) {
     IOOptions opts;
+    opts.type = GetIOType();
     status_ = PrepareIOFromReadOptions(read_options_, file_->env(), opts);
     // Actual file read
     if (status_.ok()) {
@@ -125,5 +125,7 @@ class BlockFetcher {
   void InsertCompressedBlockToPersistentCacheIfNeeded();
   void InsertUncompressedBlockToPersistentCacheIfNeeded();
   void CheckBlockChecksum();
+  // The IOType to tag the read of the block with.
+  IOType GetIOType() const;
 };
 }  // namespace ROCKSDB_NAMESPACE
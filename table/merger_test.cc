@@ -12,7 +12,7 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-class MergerTest : public testing::Test {
+class MergerTest : public testing::TestWithParam<bool> {
  public:
   MergerTest()
       : icomp_(BytewiseComparator()),
@@ -107,7 +107,9 @@ class MergerTest : public testing::Test {
 
     merging_iterator_.reset(
         NewMergingIterator(&icomp_, &small_iterators[0],
-                           static_cast<int>(small_iterators.size())));
+                           static_cast<int>(small_iterators.size()),
+                           nullptr /* arena */, false /* prefix_seek_mode */,
+                           GetParam() /* use_loser_tree */));
     single_iterator_.reset(new test::VectorIterator(all_keys_));
   }
 
@@ -118,7 +120,7 @@ class MergerTest : public testing::Test {
   std::vector<std::string> all_keys_;
 };
 
-TEST_F(MergerTest, SeekToRandomNextTest) {
+TEST_P(MergerTest, SeekToRandomNextTest) {
   Generate(1000, 50, 50);
   for (int i = 0; i < 10; ++i) {
     SeekToRandom();
@@ -127,7 +129,7 @@ TEST_F(MergerTest, SeekToRandomNextTest) {
   }
 }
 
-TEST_F(MergerTest, SeekToRandomNextSmallStringsTest) {
+TEST_P(MergerTest, SeekToRandomNextSmallStringsTest) {
   Generate(1000, 50, 2);
   for (int i = 0; i < 10; ++i) {
     SeekToRandom();
@@ -136,7 +138,7 @@ TEST_F(MergerTest, SeekToRandomNextSmallStringsTest) {
   }
 }
 
-TEST_F(MergerTest, SeekToRandomPrevTest) {
+TEST_P(MergerTest, SeekToRandomPrevTest) {
   Generate(1000, 50, 50);
   for (int i = 0; i < 10; ++i) {
     SeekToRandom();
@@ -145,7 +147,7 @@ TEST_F(MergerTest, SeekToRandomPrevTest) {
   }
 }
 
-TEST_F(MergerTest, SeekToRandomRandomTest) {
+TEST_P(MergerTest, SeekToRandomRandomTest) {
   Generate(200, 50, 50);
   for (int i = 0; i < 3; ++i) {
     SeekToRandom();
@@ -154,7 +156,7 @@ TEST_F(MergerTest, SeekToRandomRandomTest) {
   }
 }
 
-TEST_F(MergerTest, SeekToFirstTest) {
+TEST_P(MergerTest, SeekToFirstTest) {
   Generate(1000, 50, 50);
   for (int i = 0; i < 10; ++i) {
     SeekToFirst();
@@ -163,7 +165,7 @@ TEST_F(MergerTest, SeekToFirstTest) {
   }
 }
 
-TEST_F(MergerTest, SeekToLastTest) {
+TEST_P(MergerTest, SeekToLastTest) {
   Generate(1000, 50, 50);
   for (int i = 0; i < 10; ++i) {
     SeekToLast();
@@ -172,6 +174,8 @@ TEST_F(MergerTest, SeekToLastTest) {
   }
 }
 
+INSTANTIATE_TEST_CASE_P(MergerTest, MergerTest, ::testing::Bool());
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
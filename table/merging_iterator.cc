@@ -23,6 +23,7 @@
 #include "test_util/sync_point.h"
 #include "util/autovector.h"
 #include "util/heap.h"
+#include "util/loser_tree.h"
 #include "util/stop_watch.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -30,15 +31,27 @@ namespace ROCKSDB_NAMESPACE {
 namespace {
 typedef BinaryHeap<IteratorWrapper*, MaxIteratorComparator> MergerMaxIterHeap;
 typedef BinaryHeap<IteratorWrapper*, MinIteratorComparator> MergerMinIterHeap;
+typedef LoserTree<IteratorWrapper*, MaxIteratorComparator> MergerMaxIterTree;
+typedef LoserTree<IteratorWrapper*, MinIteratorComparator> MergerMinIterTree;
 }  // namespace
 
 const size_t kNumIterReserve = 4;
 
+// Interface of the merging iterators, so that MergeIteratorBuilder can add
+// children regardless of how they are merged.
 class MergingIterator : public InternalIterator {
  public:
-  MergingIterator(const InternalKeyComparator* comparator,
-                  InternalIterator** children, int n, bool is_arena_mode,
-                  bool prefix_seek_mode)
+  virtual void AddIterator(InternalIterator* iter) = 0;
+};
+
+// MinIterHeap and MaxIterHeap order the children in forward and reverse
+// direction: either BinaryHeap or LoserTree.
+template <class MinIterHeap, class MaxIterHeap>
+class MergingIteratorImpl : public MergingIterator {
+ public:
+  MergingIteratorImpl(const InternalKeyComparator* comparator,
+                      InternalIterator** children, int n, bool is_arena_mode,
+                      bool prefix_seek_mode)
       : is_arena_mode_(is_arena_mode),
         comparator_(comparator),
         current_(nullptr),
@@ -62,7 +75,7 @@ class MergingIterator : public InternalIterator {
     }
   }
 
-  virtual void AddIterator(InternalIterator* iter) {
+  void AddIterator(InternalIterator* iter) override {
     assert(direction_ == kForward);
     children_.emplace_back(iter);
     if (pinned_iters_mgr_) {
@@ -75,7 +88,7 @@ class MergingIterator : public InternalIterator {
     }
   }
 
-  ~MergingIterator() override {
+  ~MergingIteratorImpl() override {
     for (auto& child : children_) {
       child.DeleteIter(is_arena_mode_);
     }
@@ -308,12 +321,12 @@ class MergingIterator : public InternalIterator {
     kReverse
   };
   Direction direction_;
-  MergerMinIterHeap minHeap_;
+  MinIterHeap minHeap_;
   bool prefix_seek_mode_;
 
   // Max heap is used for reverse iteration, which is way less common than
   // forward.  Lazily initialize it to save memory.
-  std::unique_ptr<MergerMaxIterHeap> maxHeap_;
+  std::unique_ptr<MaxIterHeap> maxHeap_;
   PinnedIteratorsManager* pinned_iters_mgr_;
 
   // In forward direction, process a child that is not in the min heap.
@@ -342,7 +355,9 @@ class MergingIterator : public InternalIterator {
   }
 };
 
-void MergingIterator::AddToMinHeapOrCheckStatus(IteratorWrapper* child) {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::AddToMinHeapOrCheckStatus(
+    IteratorWrapper* child) {
   if (child->Valid()) {
     assert(child->status().ok());
     minHeap_.push(child);
@@ -351,7 +366,9 @@ void MergingIterator::AddToMinHeapOrCheckStatus(IteratorWrapper* child) {
   }
 }
 
-void MergingIterator::AddToMaxHeapOrCheckStatus(IteratorWrapper* child) {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::AddToMaxHeapOrCheckStatus(
+    IteratorWrapper* child) {
   if (child->Valid()) {
     assert(child->status().ok());
     maxHeap_->push(child);
@@ -360,7 +377,8 @@ void MergingIterator::AddToMaxHeapOrCheckStatus(IteratorWrapper* child) {
   }
 }
 
-void MergingIterator::SwitchToForward() {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::SwitchToForward() {
   // Otherwise, advance the non-current children.  We advance current_
   // just after the if-block.
   ClearHeaps();
@@ -378,7 +396,8 @@ void MergingIterator::SwitchToForward() {
   direction_ = kForward;
 }
 
-void MergingIterator::SwitchToBackward() {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::SwitchToBackward() {
   ClearHeaps();
   InitMaxHeap();
   Slice target = key();
@@ -404,43 +423,69 @@ void MergingIterator::SwitchToBackward() {
   assert(current_ == CurrentReverse());
 }
 
-void MergingIterator::ClearHeaps() {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::ClearHeaps() {
   minHeap_.clear();
   if (maxHeap_) {
     maxHeap_->clear();
   }
 }
 
-void MergingIterator::InitMaxHeap() {
+template <class MinIterHeap, class MaxIterHeap>
+void MergingIteratorImpl<MinIterHeap, MaxIterHeap>::InitMaxHeap() {
   if (!maxHeap_) {
-    maxHeap_.reset(new MergerMaxIterHeap(comparator_));
+    maxHeap_.reset(new MaxIterHeap(comparator_));
+  }
+}
+
+namespace {
+template <class MinIterHeap, class MaxIterHeap>
+MergingIterator* NewMergingIteratorImpl(const InternalKeyComparator* cmp,
+                                        InternalIterator** list, int n,
+                                        Arena* arena, bool prefix_seek_mode) {
+  typedef MergingIteratorImpl<MinIterHeap, MaxIterHeap> Impl;
+  if (arena == nullptr) {
+    return new Impl(cmp, list, n, false, prefix_seek_mode);
+  } else {
+    auto mem = arena->AllocateAligned(sizeof(Impl));
+    return new (mem) Impl(cmp, list, n, true, prefix_seek_mode);
   }
 }
 
+MergingIterator* NewMergingIteratorImpl(const InternalKeyComparator* cmp,
+                                        InternalIterator** list, int n,
+                                        Arena* arena, bool prefix_seek_mode,
+                                        bool use_loser_tree) {
+  if (use_loser_tree) {
+    return NewMergingIteratorImpl<MergerMinIterTree, MergerMaxIterTree>(
+        cmp, list, n, arena, prefix_seek_mode);
+  }
+  return NewMergingIteratorImpl<MergerMinIterHeap, MergerMaxIterHeap>(
+      cmp, list, n, arena, prefix_seek_mode);
+}
+}  // namespace
+
 InternalIterator* NewMergingIterator(const InternalKeyComparator* cmp,
                                      InternalIterator** list, int n,
-                                     Arena* arena, bool prefix_seek_mode) {
+                                     Arena* arena, bool prefix_seek_mode,
+                                     bool use_loser_tree) {
   assert(n >= 0);
   if (n == 0) {
     return NewEmptyInternalIterator<Slice>(arena);
   } else if (n == 1) {
     return list[0];
   } else {
-    if (arena == nullptr) {
-      return new MergingIterator(cmp, list, n, false, prefix_seek_mode);
-    } else {
-      auto mem = arena->AllocateAligned(sizeof(MergingIterator));
-      return new (mem) MergingIterator(cmp, list, n, true, prefix_seek_mode);
-    }
+    return NewMergingIteratorImpl(cmp, list, n, arena, prefix_seek_mode,
+                                  use_loser_tree);
   }
 }
 
 MergeIteratorBuilder::MergeIteratorBuilder(
-    const InternalKeyComparator* comparator, Arena* a, bool prefix_seek_mode)
+    const InternalKeyComparator* comparator, Arena* a, bool prefix_seek_mode,
+    bool use_loser_tree)
     : first_iter(nullptr), use_merging_iter(false), arena(a) {
-  auto mem = arena->AllocateAligned(sizeof(MergingIterator));
-  merge_iter =
-      new (mem) MergingIterator(comparator, nullptr, 0, true, prefix_seek_mode);
+  merge_iter = NewMergingIteratorImpl(comparator, nullptr, 0, arena,
+                                      prefix_seek_mode, use_loser_tree);
 }
 
 MergeIteratorBuilder::~MergeIteratorBuilder() {
@@ -28,10 +28,14 @@ using InternalIterator = InternalIteratorBase<Slice>;
 // The result does no duplicate suppression.  I.e., if a particular
 // key is present in K child iterators, it will be yielded K times.
 //
+// If use_loser_tree is true, the children are merged with a tournament tree
+// (util/loser_tree.h) instead of a binary heap (util/heap.h).
+//
 // REQUIRES: n >= 0
 extern InternalIterator* NewMergingIterator(
     const InternalKeyComparator* comparator, InternalIterator** children, int n,
-    Arena* arena = nullptr, bool prefix_seek_mode = false);
+    Arena* arena = nullptr, bool prefix_seek_mode = false,
+    bool use_loser_tree = false);
 
 class MergingIterator;
 
@@ -40,8 +44,10 @@ class MergeIteratorBuilder {
  public:
   // comparator: the comparator used in merging comparator
   // arena: where the merging iterator needs to be allocated from.
+  // use_loser_tree: see NewMergingIterator().
   explicit MergeIteratorBuilder(const InternalKeyComparator* comparator,
-                                Arena* arena, bool prefix_seek_mode = false);
+                                Arena* arena, bool prefix_seek_mode = false,
+                                bool use_loser_tree = false);
   ~MergeIteratorBuilder();
 
   // Add iter to the merging iterator.
@@ -9,6 +9,8 @@
 
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 #include "db/range_tombstone_fragmenter.h"
 #include "rocksdb/slice_transform.h"
 #include "table/get_context.h"
@@ -58,6 +60,20 @@ class TableReader {
     return nullptr;
   }
 
+  // Returns the largest sequence number of the range tombstones in this table
+  // that cover user_key and are visible at the snapshot of read_options, or 0
+  // if there is none. Readers that keep their fragmented tombstones resident
+  // should override this to answer point lookups without allocating an
+  // iterator per call.
+  virtual SequenceNumber MaxCoveringTombstoneSeqnum(
+      const ReadOptions& read_options, const Slice& user_key) {
+    std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter(
+        NewRangeTombstoneIterator(read_options));
+    return range_del_iter == nullptr
+               ? 0
+               : range_del_iter->MaxCoveringTombstoneSeqnum(user_key);
+  }
+
   // Given a key, return an approximate byte offset in the file where
   // the data for that key begins (or would begin if the key were
   // present in the file).  The returned value is in terms of file
@@ -80,6 +96,26 @@ class TableReader {
   virtual uint64_t ApproximateSize(const Slice& start, const Slice& end,
                                    TableReaderCaller caller) = 0;
 
+  // A user key that roughly partitions the table, together with the
+  // approximate number of bytes between the previous anchor (or the start of
+  // the table) and this key.
+  struct Anchor {
+    Anchor(const Slice& _user_key, uint64_t _range_size)
+        : user_key(_user_key.ToString()), range_size(_range_size) {}
+    std::string user_key;
+    uint64_t range_size;
+  };
+
+  // Append to *anchors a list of user keys, in ascending order, that split
+  // the table into ranges of similar size. The ranges between consecutive
+  // anchors are finer than the whole file but coarse enough that the list
+  // stays short, which makes them suitable for splitting key ranges across
+  // threads.
+  virtual Status ApproximateKeyAnchors(const ReadOptions& /*read_options*/,
+                                       std::vector<Anchor>* /*anchors*/) {
+    return Status::NotSupported("ApproximateKeyAnchors() not supported.");
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
@@ -118,6 +154,15 @@ class TableReader {
     }
   }
 
+  // Issue read-ahead hints for the blocks that a subsequent MultiGet() of
+  // the keys in mget_range would have to read from storage, so that the
+  // reads for several tables can be in flight at the same time. This is
+  // best effort and does not change the result of the MultiGet().
+  virtual void MultiGetPrefetch(const ReadOptions& /*readOptions*/,
+                                const MultiGetContext::Range* /*mget_range*/,
+                                const SliceTransform* /*prefix_extractor*/,
+                                bool /*skip_filters*/ = false) {}
+
   // Prefetch data corresponding to a give range of keys
   // Typically this functionality is required for table implementations that
   // persists the data on a non volatile storage medium like disk/SSD
@@ -399,6 +399,11 @@ static const bool FLAGS_subcompactions_dummy
     __attribute__((__unused__)) = RegisterFlagValidator(&FLAGS_subcompactions,
                                                     &ValidateUint32Range);
 
+DEFINE_bool(enable_pipelined_compaction,
+            ROCKSDB_NAMESPACE::Options().enable_pipelined_compaction,
+            "Read, decompress and merge the input of each (sub)compaction on "
+            "a separate thread");
+
 DEFINE_int32(max_background_flushes,
              ROCKSDB_NAMESPACE::Options().max_background_flushes,
              "The maximum number of concurrent background flushes"
@@ -658,6 +663,17 @@ DEFINE_uint64(max_bytes_for_level_base,
 DEFINE_bool(level_compaction_dynamic_level_bytes, false,
             "Whether level size base is dynamic");
 
+DEFINE_int32(level_compaction_num_tiered_levels,
+             ROCKSDB_NAMESPACE::Options().level_compaction_num_tiered_levels,
+             "Number of size-tiered levels (L0 included) on top of the "
+             "leveled ones in level-style compaction; 0 or 1 disables it");
+
+DEFINE_uint64(
+    compaction_deletion_run_threshold,
+    ROCKSDB_NAMESPACE::Options().compaction_deletion_run_threshold,
+    "Minimum number of consecutive point deletions that compactions "
+    "replace by a range tombstone; 0 disables it");
+
 DEFINE_double(max_bytes_for_level_multiplier, 10,
               "A multiplier to compute max bytes for level-N (N >= 2)");
 
@@ -1236,6 +1252,9 @@ DEFINE_bool(total_order_seek, false,
             "Enable total order seek regardless of index format.");
 DEFINE_bool(prefix_same_as_start, false,
             "Enforce iterator to return keys with prefix same as seek key.");
+DEFINE_bool(use_loser_tree_merge, false,
+            "Merge the children of iterators with a loser tree instead of a "
+            "binary heap. Used by readseq, readreverse and seekrandom.");
 DEFINE_bool(
     seek_missing_prefix, false,
     "Iterator seek to keys with non-exist prefixes. Require prefix_size > 8");
@@ -3643,6 +3662,7 @@ class Benchmark {
     options.max_background_jobs = FLAGS_max_background_jobs;
     options.max_background_compactions = FLAGS_max_background_compactions;
     options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+    options.enable_pipelined_compaction = FLAGS_enable_pipelined_compaction;
     options.max_background_flushes = FLAGS_max_background_flushes;
     options.compaction_style = FLAGS_compaction_style_e;
     options.compaction_pri = FLAGS_compaction_pri_e;
@@ -3694,6 +3714,10 @@ class Benchmark {
     options.max_bytes_for_level_base = FLAGS_max_bytes_for_level_base;
     options.level_compaction_dynamic_level_bytes =
         FLAGS_level_compaction_dynamic_level_bytes;
+    options.level_compaction_num_tiered_levels =
+        FLAGS_level_compaction_num_tiered_levels;
+    options.compaction_deletion_run_threshold =
+        static_cast<size_t>(FLAGS_compaction_deletion_run_threshold);
     options.max_bytes_for_level_multiplier =
         FLAGS_max_bytes_for_level_multiplier;
     if ((FLAGS_prefix_size == 0) && (FLAGS_rep_factory == kPrefixHash ||
@@ -4871,6 +4895,7 @@ class Benchmark {
   void ReadSequential(ThreadState* thread, DB* db) {
     ReadOptions options(FLAGS_verify_checksum, true);
     options.tailing = FLAGS_use_tailing_iterator;
+    options.use_loser_tree_merge = FLAGS_use_loser_tree_merge;
 
     Iterator* iter = db->NewIterator(options);
     int64_t i = 0;
@@ -4966,7 +4991,9 @@ class Benchmark {
   }
 
   void ReadReverse(ThreadState* thread, DB* db) {
-    Iterator* iter = db->NewIterator(ReadOptions(FLAGS_verify_checksum, true));
+    ReadOptions options(FLAGS_verify_checksum, true);
+    options.use_loser_tree_merge = FLAGS_use_loser_tree_merge;
+    Iterator* iter = db->NewIterator(options);
     int64_t i = 0;
     int64_t bytes = 0;
     for (iter->SeekToLast(); i < reads_ && iter->Valid(); iter->Prev()) {
@@ -5717,6 +5744,7 @@ class Benchmark {
     options.prefix_same_as_start = FLAGS_prefix_same_as_start;
     options.tailing = FLAGS_use_tailing_iterator;
     options.readahead_size = FLAGS_readahead_size;
+    options.use_loser_tree_merge = FLAGS_use_loser_tree_merge;
 
     Iterator* single_iter = nullptr;
     std::vector<Iterator*> multi_iters;
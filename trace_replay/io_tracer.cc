@@ -41,6 +41,8 @@ Status IOTraceWriter::WriteIOOp(const IOTraceRecord& record) {
   // TODO: add below options based on file_operation
   trace.payload.push_back(record.len);
   PutFixed64(&trace.payload, record.offset);
+  trace.payload.push_back(static_cast<char>(record.io_type));
+  trace.payload.push_back(static_cast<char>(record.io_activity));
   std::string encoded_trace;
   TracerHelper::EncodeTrace(trace, &encoded_trace);
   return trace_writer_->Write(encoded_trace);
@@ -148,6 +150,16 @@ Status IOTraceReader::ReadIOOp(IOTraceRecord* record) {
     return Status::Incomplete(
         "Incomplete access record: Failed to read offset.");
   }
+  // Traces written before the IO class was recorded end here.
+  if (enc_slice.empty()) {
+    return Status::OK();
+  }
+  if (enc_slice.size() < 2 * kCharSize) {
+    return Status::Incomplete(
+        "Incomplete access record: Failed to read IO type and activity.");
+  }
+  record->io_type = static_cast<IOType>(enc_slice[0]);
+  record->io_activity = static_cast<IOActivity>(enc_slice[1]);
   return Status::OK();
 }
 
@@ -10,6 +10,7 @@
 
 #include "monitoring/instrumented_mutex.h"
 #include "rocksdb/env.h"
+#include "rocksdb/file_system.h"
 #include "rocksdb/options.h"
 #include "rocksdb/trace_reader_writer.h"
 #include "trace_replay/trace_replay.h"
@@ -31,6 +32,9 @@ struct IOTraceRecord {
   uint64_t offset = 0;
   size_t len = 0;
   uint64_t file_size = 0;
+  // The IOType and IOActivity of the IOOptions the operation was issued with.
+  IOType io_type = IOType::kUnknown;
+  IOActivity io_activity = IOActivity::kUnknown;
 
   IOTraceRecord() {}
 
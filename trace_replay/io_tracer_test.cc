@@ -46,6 +46,15 @@ class IOTracerTest : public testing::Test {
     assert(false);
   }
 
+  IOType GetIOType(uint32_t id) {
+    return static_cast<IOType>(id % static_cast<uint32_t>(IOType::kInvalid));
+  }
+
+  IOActivity GetIOActivity(uint32_t id) {
+    return static_cast<IOActivity>(
+        id % (static_cast<uint32_t>(IOActivity::kUnknown) + 1));
+  }
+
   void WriteIOOp(IOTraceWriter* writer, uint32_t nrecords) {
     assert(writer);
     for (uint32_t i = 0; i < nrecords; i++) {
@@ -55,6 +64,8 @@ class IOTracerTest : public testing::Test {
       record.file_name = kDummyFile + std::to_string(i);
       record.len = i;
       record.offset = i + 20;
+      record.io_type = GetIOType(i);
+      record.io_activity = GetIOActivity(i);
       ASSERT_OK(writer->WriteIOOp(record));
     }
   }
@@ -66,6 +77,8 @@ class IOTracerTest : public testing::Test {
     record.file_name = kDummyFile + std::to_string(i);
     record.len = i;
     record.offset = i + 20;
+    record.io_type = GetIOType(i);
+    record.io_activity = GetIOActivity(i);
     return record;
   }
 
@@ -79,6 +92,8 @@ class IOTracerTest : public testing::Test {
       ASSERT_EQ(record.len, i);
       ASSERT_EQ(record.offset, i + 20);
       ASSERT_EQ(record.file_name, kDummyFile + std::to_string(i));
+      ASSERT_EQ(record.io_type, GetIOType(i));
+      ASSERT_EQ(record.io_activity, GetIOActivity(i));
     }
   }
 
@@ -4,6 +4,8 @@
 //  (found in the LICENSE.Apache file in the root directory).
 //
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include "env/composite_env_wrapper.h"
 #include "file/random_access_file_reader.h"
@@ -183,6 +185,79 @@ TEST_F(WritableFileWriterTest, IncrementalBuffer) {
   }
 }
 
+TEST_F(WritableFileWriterTest, BackgroundWrites) {
+  class FakeWF : public WritableFile {
+   public:
+    explicit FakeWF(std::string* _file_data)
+        : file_data_(_file_data),
+          caller_thread_id_(std::this_thread::get_id()),
+          appends_on_caller_thread_(0),
+          io_error_(false) {}
+    ~FakeWF() override {}
+
+    Status Append(const Slice& data) override {
+      if (std::this_thread::get_id() == caller_thread_id_) {
+        appends_on_caller_thread_++;
+      }
+      if (io_error_) {
+        return Status::IOError("Fake IO error");
+      }
+      file_data_->append(data.data(), data.size());
+      return Status::OK();
+    }
+    Status Truncate(uint64_t /*size*/) override { return Status::OK(); }
+    Status Close() override { return Status::OK(); }
+    Status Flush() override { return Status::OK(); }
+    Status Sync() override { return Status::OK(); }
+    Status Fsync() override { return Status::OK(); }
+    uint64_t GetFileSize() override { return file_data_->size(); }
+    void SetIOError(bool val) { io_error_ = val; }
+
+    std::string* file_data_;
+    std::thread::id caller_thread_id_;
+    std::atomic<int> appends_on_caller_thread_;
+    std::atomic<bool> io_error_;
+  };
+
+  Random r(301);
+  FileOptions file_options;
+  file_options.writable_file_max_buffer_size = 64 * 1024;
+  file_options.background_writes = true;
+  std::string actual;
+  std::unique_ptr<FakeWF> wf(new FakeWF(&actual));
+  FakeWF* fake_wf = wf.get();
+  std::unique_ptr<WritableFileWriter> writer(
+      new WritableFileWriter(NewLegacyWritableFileWrapper(std::move(wf)),
+                             "" /* don't care */, file_options));
+
+  std::string target;
+  for (int i = 0; i < 100; i++) {
+    uint32_t num = r.Skewed(17) * 10 + r.Uniform(100);
+    std::string random_string;
+    test::RandomString(&r, num, &random_string);
+    ASSERT_OK(writer->Append(random_string));
+    target.append(random_string);
+
+    // Flush in a chance of 1/10.
+    if (r.Uniform(10) == 0) {
+      ASSERT_OK(writer->Flush());
+      ASSERT_EQ(target, actual);
+    }
+  }
+  // Everything appended is in the file once Sync() returns.
+  ASSERT_OK(writer->Sync(false /* use_fsync */));
+  ASSERT_EQ(target, actual);
+  ASSERT_EQ(0, fake_wf->appends_on_caller_thread_.load());
+
+  // An error of a background write is returned by the next operation that
+  // waits for it, and by Close().
+  fake_wf->SetIOError(true);
+  ASSERT_OK(writer->Append(std::string(100 * 1024, 'a')));
+  ASSERT_NOK(writer->Flush());
+  ASSERT_NOK(writer->Append(std::string(100 * 1024, 'b')));
+  ASSERT_NOK(writer->Close());
+}
+
 #ifndef ROCKSDB_LITE
 TEST_F(WritableFileWriterTest, AppendStatusReturn) {
   class FakeWF : public WritableFile {
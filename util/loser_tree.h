@@ -0,0 +1,177 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "port/port.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Tournament ("loser") tree with the same interface as BinaryHeap in
+// util/heap.h, as an alternative for multi-way merges with many inputs.
+// Comparison to BinaryHeap:
+// - replace_top() and pop() replay a single leaf-to-root path, which costs
+//   exactly ceil(logN) comparisons, where BinaryHeap's downheap needs up to
+//   ~2logN.
+// - When the replacement element is still the top, replace_top() costs a
+//   single comparison against the cached runner-up. The runner-up is
+//   computed whenever a replay leaves the same element on top, which is the
+//   common case when the merge takes a run of elements from one input.
+// - push() is O(1): the tree is rebuilt in O(N) on the next access, so
+//   filling the tree with N elements (e.g. on every Seek()) costs O(N)
+//   comparisons instead of O(NlogN).
+//
+// The container uses the same counterintuitive ordering as
+// std::priority_queue: the comparison operator is expected to provide the
+// less-than relation, but top() will return the maximum.
+
+template <typename T, typename Compare = std::less<T>>
+class LoserTree {
+ public:
+  LoserTree() {}
+  explicit LoserTree(Compare cmp) : cmp_(std::move(cmp)) {}
+
+  void push(const T& value) {
+    leaves_.emplace_back(value);
+    ++size_;
+    needs_rebuild_ = true;
+  }
+
+  const T& top() const {
+    assert(!empty());
+    MaybeRebuild();
+    return leaves_[winner_].value;
+  }
+
+  void replace_top(const T& value) {
+    assert(!empty());
+    MaybeRebuild();
+    leaves_[winner_].value = value;
+    if (runner_up_ != kNone && Beats(winner_, runner_up_)) {
+      // The winner still beats every loser on its path, so none of the
+      // matches change.
+      return;
+    }
+    Replay();
+  }
+
+  void pop() {
+    assert(!empty());
+    MaybeRebuild();
+    leaves_[winner_].valid = false;
+    if (--size_ == 0) {
+      clear();
+      return;
+    }
+    Replay();
+  }
+
+  void clear() {
+    leaves_.clear();
+    size_ = 0;
+    needs_rebuild_ = false;
+    runner_up_ = kNone;
+  }
+
+  bool empty() const { return size_ == 0; }
+
+  size_t size() const { return size_; }
+
+ private:
+  static const size_t kNone = port::kMaxSizet;
+
+  struct Leaf {
+    explicit Leaf(const T& _value) : value(_value), valid(true) {}
+
+    T value;
+    // False once the leaf was popped; it then loses every match.
+    bool valid;
+  };
+
+  // Returns true if leaf a wins the match against leaf b.
+  bool Beats(size_t a, size_t b) const {
+    return leaves_[a].valid &&
+           (!leaves_[b].valid || !cmp_(leaves_[a].value, leaves_[b].value));
+  }
+
+  // Replays the matches on the path of the current winner after its value
+  // changed.
+  void Replay() {
+    const size_t num_leaves = leaves_.size();
+    const size_t prev_winner = winner_;
+    size_t cur = winner_;
+    for (size_t node = (winner_ + num_leaves) / 2; node > 0; node /= 2) {
+      if (Beats(losers_[node], cur)) {
+        std::swap(losers_[node], cur);
+      }
+    }
+    winner_ = cur;
+    runner_up_ = cur == prev_winner ? FindRunnerUp() : kNone;
+  }
+
+  // The runner-up is the best of the losers on the path of the winner.
+  size_t FindRunnerUp() const {
+    size_t runner_up = kNone;
+    for (size_t node = (winner_ + leaves_.size()) / 2; node > 0; node /= 2) {
+      if (runner_up == kNone || Beats(losers_[node], runner_up)) {
+        runner_up = losers_[node];
+      }
+    }
+    return runner_up;
+  }
+
+  // Drops the popped leaves and plays all matches bottom-up. Leaf i is node
+  // i + N of an implicit binary tree whose internal nodes are [1, N).
+  void MaybeRebuild() const {
+    if (!needs_rebuild_) {
+      return;
+    }
+    needs_rebuild_ = false;
+    runner_up_ = kNone;
+    leaves_.erase(std::remove_if(leaves_.begin(), leaves_.end(),
+                                 [](const Leaf& leaf) { return !leaf.valid; }),
+                  leaves_.end());
+    const size_t num_leaves = leaves_.size();
+    assert(num_leaves == size_);
+    winner_ = 0;
+    losers_.resize(num_leaves);
+    winners_.resize(num_leaves);
+    for (size_t node = num_leaves - 1; node > 0; --node) {
+      size_t left = 2 * node;
+      size_t right = left + 1;
+      left = left >= num_leaves ? left - num_leaves : winners_[left];
+      right = right >= num_leaves ? right - num_leaves : winners_[right];
+      if (Beats(left, right)) {
+        winners_[node] = left;
+        losers_[node] = right;
+      } else {
+        winners_[node] = right;
+        losers_[node] = left;
+      }
+    }
+    if (num_leaves > 1) {
+      winner_ = winners_[1];
+    }
+  }
+
+  Compare cmp_;
+  // The tree is built lazily on the first access after push(), hence the
+  // mutable members.
+  mutable std::vector<Leaf> leaves_;
+  // losers_[node] is the leaf that lost the match at internal node `node`.
+  mutable std::vector<size_t> losers_;
+  // Scratch space for MaybeRebuild().
+  mutable std::vector<size_t> winners_;
+  mutable size_t winner_ = 0;
+  mutable size_t runner_up_ = kNone;
+  mutable bool needs_rebuild_ = false;
+  size_t size_ = 0;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,562 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "util/work_stealing_thread_pool.h"
+
+#ifndef OS_WIN
+#include <unistd.h>
+#endif
+
+#ifdef OS_LINUX
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "monitoring/thread_status_util.h"
+#include "test_util/sync_point.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The pool avoids lost wake-ups without taking mu_ on the fast paths: a
+// submitter increments queue_len_ before it reads num_idle_threads_, and a
+// worker increments num_idle_threads_ before it reads queue_len_ for the last
+// time ahead of waiting. With sequentially consistent atomics, either the
+// submitter sees the idle worker and signals it under mu_, or the worker sees
+// the job and does not wait.
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+    : env_(nullptr),
+      priority_(Env::LOW),
+      num_queues_(1),
+      next_queue_(0),
+      queue_len_(0),
+      total_threads_limit_(0),
+      num_threads_(0),
+      num_idle_threads_(0),
+      exit_all_threads_(false),
+      wait_for_jobs_to_complete_(false),
+      low_io_priority_(false),
+      cpu_priority_(CpuPriority::kNormal) {
+  queues_[0].reset(new Queue());
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  assert(bgthreads_.size() == 0U);
+}
+
+void WorkStealingThreadPool::AddHigherPriorityPool(
+    WorkStealingThreadPool* pool) {
+  assert(pool != this);
+  higher_priority_pools_.push_back(pool);
+  pool->lower_priority_pools_.push_back(this);
+}
+
+void WorkStealingThreadPool::JoinThreads(bool wait_for_jobs_to_complete) {
+  std::unique_lock<std::mutex> lock(mu_);
+  assert(!exit_all_threads_);
+
+  wait_for_jobs_to_complete_ = wait_for_jobs_to_complete;
+  exit_all_threads_ = true;
+  // prevent threads from being recreated right after they're joined, in case
+  // the user is concurrently submitting jobs.
+  total_threads_limit_ = 0;
+
+  lock.unlock();
+
+  bgsignal_.notify_all();
+
+  for (auto& th : bgthreads_) {
+    th.join();
+  }
+
+  bgthreads_.clear();
+  num_threads_ = 0;
+
+  exit_all_threads_ = false;
+  wait_for_jobs_to_complete_ = false;
+}
+
+void WorkStealingThreadPool::LowerIOPriority() { low_io_priority_ = true; }
+
+void WorkStealingThreadPool::LowerCPUPriority(CpuPriority pri) {
+  cpu_priority_ = pri;
+}
+
+bool WorkStealingThreadPool::CanSteal() const {
+  // Jobs of higher priority pools must not run at a lowered priority.
+  return !low_io_priority_.load() &&
+         cpu_priority_.load() == CpuPriority::kNormal;
+}
+
+bool WorkStealingThreadPool::HasWork() const {
+  if (queue_len_.load() > 0) {
+    return true;
+  }
+  if (CanSteal()) {
+    for (auto* pool : higher_priority_pools_) {
+      if (pool->queue_len_.load() > 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::TakeJob(const size_t* thread_id, BGItem* item) {
+  if (queue_len_.load() == 0) {
+    return false;
+  }
+  const size_t num_queues = num_queues_.load();
+  // Start with the worker's own queue, or anywhere when stolen from another
+  // pool, then go through the others in order.
+  const size_t first =
+      thread_id != nullptr
+          ? *thread_id % kMaxQueues
+          : next_queue_.load(std::memory_order_relaxed) % num_queues;
+  for (size_t i = 0; i < num_queues; ++i) {
+    Queue* queue = queues_[(first + i) % num_queues].get();
+    std::lock_guard<std::mutex> lock(queue->mu);
+    if (!queue->items.empty()) {
+      *item = std::move(queue->items.front());
+      queue->items.pop_front();
+      queue_len_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::StealFromHigherPriorityPools(
+    BGItem* item, WorkStealingThreadPool** from) {
+  if (!CanSteal()) {
+    return false;
+  }
+  for (auto* pool : higher_priority_pools_) {
+    if (pool->TakeJob(nullptr, item)) {
+      *from = pool;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::BGThread(size_t thread_id) {
+  bool low_io_priority = false;
+  CpuPriority current_cpu_priority = CpuPriority::kNormal;
+
+  while (true) {
+    BGItem item;
+    WorkStealingThreadPool* from = this;
+    bool found = false;
+    const bool exiting = exit_all_threads_.load();
+    if (exiting ? wait_for_jobs_to_complete_.load()
+                : !IsExcessiveThread(thread_id)) {
+      // Only run the own pool's jobs while waiting for them before exit.
+      found = TakeJob(&thread_id, &item) ||
+              (!exiting && StealFromHigherPriorityPools(&item, &from));
+    }
+
+    if (!found) {
+      std::unique_lock<std::mutex> lock(mu_);
+      if (exit_all_threads_) {  // mechanism to let BG threads exit safely
+        if (!wait_for_jobs_to_complete_ || queue_len_.load() == 0) {
+          break;
+        }
+        // A job is being added to a queue.
+        continue;
+      }
+
+      if (IsLastExcessiveThread(thread_id)) {
+        // Current thread is the last generated one and is excessive.
+        // We always terminate excessive thread in the reverse order of
+        // generation time.
+        auto& terminating_thread = bgthreads_.back();
+        terminating_thread.detach();
+        bgthreads_.pop_back();
+        num_threads_--;
+
+        if (HasExcessiveThread()) {
+          // There is still at least more excessive thread to terminate.
+          bgsignal_.notify_all();
+        }
+        break;
+      }
+
+      num_idle_threads_++;
+      if (IsExcessiveThread(thread_id) || !HasWork()) {
+        bgsignal_.wait(lock);
+      }
+      num_idle_threads_--;
+      continue;
+    }
+
+    bool decrease_io_priority = (low_io_priority != low_io_priority_.load());
+    CpuPriority cpu_priority = cpu_priority_.load();
+
+    if (cpu_priority < current_cpu_priority) {
+      TEST_SYNC_POINT_CALLBACK(
+          "WorkStealingThreadPool::BGThread::BeforeSetCpuPriority",
+          &current_cpu_priority);
+      // 0 means current thread.
+      port::SetCpuPriority(0, cpu_priority);
+      current_cpu_priority = cpu_priority;
+      TEST_SYNC_POINT_CALLBACK(
+          "WorkStealingThreadPool::BGThread::AfterSetCpuPriority",
+          &current_cpu_priority);
+    }
+
+#ifdef OS_LINUX
+    if (decrease_io_priority) {
+#define IOPRIO_CLASS_SHIFT (13)
+#define IOPRIO_PRIO_VALUE(class, data) (((class) << IOPRIO_CLASS_SHIFT) | data)
+      // Put schedule into IOPRIO_CLASS_IDLE class (lowest). See
+      // ThreadPoolImpl::Impl::BGThread().
+      syscall(SYS_ioprio_set, 1,  // IOPRIO_WHO_PROCESS
+              0,                  // current thread
+              IOPRIO_PRIO_VALUE(3, 0));
+      low_io_priority = true;
+    }
+#else
+    (void)decrease_io_priority;  // avoid 'unused variable' error
+#endif
+
+    TEST_SYNC_POINT_CALLBACK("WorkStealingThreadPool::BGThread:BeforeRun",
+                             &from->priority_);
+
+    item.function();
+  }
+}
+
+namespace {
+// Helper struct for passing arguments when creating threads.
+struct WorkerMetadata {
+  WorkStealingThreadPool* thread_pool_;
+  size_t thread_id_;  // Thread count in the thread.
+  WorkerMetadata(WorkStealingThreadPool* thread_pool, size_t thread_id)
+      : thread_pool_(thread_pool), thread_id_(thread_id) {}
+};
+}  // namespace
+
+void WorkStealingThreadPool::BGThreadWrapper(void* arg) {
+  WorkerMetadata* meta = reinterpret_cast<WorkerMetadata*>(arg);
+  size_t thread_id = meta->thread_id_;
+  WorkStealingThreadPool* tp = meta->thread_pool_;
+#ifdef ROCKSDB_USING_THREAD_STATUS
+  // initialize it because compiler isn't good enough to see we don't use it
+  // uninitialized
+  ThreadStatus::ThreadType thread_type = ThreadStatus::NUM_THREAD_TYPES;
+  switch (tp->GetThreadPriority()) {
+    case Env::Priority::HIGH:
+      thread_type = ThreadStatus::HIGH_PRIORITY;
+      break;
+    case Env::Priority::LOW:
+      thread_type = ThreadStatus::LOW_PRIORITY;
+      break;
+    case Env::Priority::BOTTOM:
+      thread_type = ThreadStatus::BOTTOM_PRIORITY;
+      break;
+    case Env::Priority::USER:
+      thread_type = ThreadStatus::USER;
+      break;
+    case Env::Priority::TOTAL:
+      assert(false);
+      return;
+  }
+  assert(thread_type != ThreadStatus::NUM_THREAD_TYPES);
+  ThreadStatusUtil::RegisterThread(tp->GetHostEnv(), thread_type);
+#endif
+  delete meta;
+  tp->BGThread(thread_id);
+#ifdef ROCKSDB_USING_THREAD_STATUS
+  ThreadStatusUtil::UnregisterThread();
+#endif
+  return;
+}
+
+void WorkStealingThreadPool::StartBGThread() {
+  size_t thread_id = bgthreads_.size();
+  if (thread_id < kMaxQueues && thread_id >= num_queues_.load()) {
+    queues_[thread_id].reset(new Queue());
+    num_queues_ = thread_id + 1;
+  }
+
+  port::Thread p_t(&BGThreadWrapper, new WorkerMetadata(this, thread_id));
+
+// Set the thread name to aid debugging
+#if defined(_GNU_SOURCE) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 12)
+  auto th_handle = p_t.native_handle();
+  std::string thread_priority = Env::PriorityToString(GetThreadPriority());
+  std::ostringstream thread_name_stream;
+  thread_name_stream << "rocksdb:";
+  for (char c : thread_priority) {
+    thread_name_stream << static_cast<char>(tolower(c));
+  }
+  thread_name_stream << thread_id;
+  pthread_setname_np(th_handle, thread_name_stream.str().c_str());
+#endif
+#endif
+  bgthreads_.push_back(std::move(p_t));
+  num_threads_++;
+}
+
+void WorkStealingThreadPool::SetBackgroundThreadsInternal(int num,
+                                                          bool allow_reduce) {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (exit_all_threads_) {
+    return;
+  }
+  if (num > total_threads_limit_ ||
+      (num < total_threads_limit_ && allow_reduce)) {
+    total_threads_limit_ = std::max(0, num);
+    bgsignal_.notify_all();
+    // Threads are otherwise started by Submit(), so start the ones needed by
+    // the jobs that are already queued.
+    while (static_cast<int>(bgthreads_.size()) < total_threads_limit_ &&
+           bgthreads_.size() < queue_len_.load()) {
+      StartBGThread();
+    }
+  }
+}
+
+void WorkStealingThreadPool::WakeUpOrStartWorker() {
+  if (num_idle_threads_.load() > 0) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!HasExcessiveThread()) {
+      // Wake up at least one waiting thread.
+      bgsignal_.notify_one();
+    } else {
+      // Need to wake up all threads to make sure the one woken
+      // up is not the one to terminate.
+      bgsignal_.notify_all();
+    }
+    return;
+  }
+
+  if (num_threads_.load() < total_threads_limit_.load()) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!exit_all_threads_ &&
+        static_cast<int>(bgthreads_.size()) < total_threads_limit_) {
+      StartBGThread();
+      return;
+    }
+  }
+
+  // All workers are busy, so let an idle worker of a lower priority pool take
+  // the job.
+  for (auto* pool : lower_priority_pools_) {
+    pool->WakeUpThief();
+  }
+}
+
+void WorkStealingThreadPool::WakeUpThief() {
+  if (!CanSteal() || num_idle_threads_.load() == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!HasExcessiveThread()) {
+    bgsignal_.notify_one();
+  } else {
+    bgsignal_.notify_all();
+  }
+}
+
+void WorkStealingThreadPool::Submit(std::function<void()>&& schedule,
+                                    std::function<void()>&& unschedule,
+                                    void* tag) {
+  if (exit_all_threads_.load()) {
+    return;
+  }
+
+  BGItem item;
+  item.tag = tag;
+  item.function = std::move(schedule);
+  item.unschedFunction = std::move(unschedule);
+
+  queue_len_++;
+  // Only use the queues of running workers, so that a single worker runs the
+  // jobs in submission order.
+  const size_t num_queues =
+      std::max<size_t>(1, std::min<size_t>(num_queues_.load(),
+                                           num_threads_.load()));
+  Queue* queue =
+      queues_[next_queue_.fetch_add(1, std::memory_order_relaxed) % num_queues]
+          .get();
+  {
+    std::lock_guard<std::mutex> lock(queue->mu);
+    queue->items.push_back(std::move(item));
+  }
+
+  WakeUpOrStartWorker();
+}
+
+int WorkStealingThreadPool::UnSchedule(void* arg) {
+  int count = 0;
+
+  std::vector<std::function<void()>> candidates;
+  const size_t num_queues = num_queues_.load();
+  for (size_t i = 0; i < num_queues; ++i) {
+    Queue* queue = queues_[i].get();
+    std::lock_guard<std::mutex> lock(queue->mu);
+    auto it = queue->items.begin();
+    while (it != queue->items.end()) {
+      if (arg == it->tag) {
+        if (it->unschedFunction) {
+          candidates.push_back(std::move(it->unschedFunction));
+        }
+        it = queue->items.erase(it);
+        queue_len_--;
+        count++;
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Run unschedule functions outside the mutexes
+  for (auto& f : candidates) {
+    f();
+  }
+
+  return count;
+}
+
+void WorkStealingThreadPool::JoinAllThreads() { JoinThreads(false); }
+
+void WorkStealingThreadPool::SetBackgroundThreads(int num) {
+  SetBackgroundThreadsInternal(num, true);
+}
+
+int WorkStealingThreadPool::GetBackgroundThreads() {
+  return total_threads_limit_.load();
+}
+
+unsigned int WorkStealingThreadPool::GetQueueLen() const {
+  return queue_len_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::WaitForJobsAndJoinAllThreads() {
+  JoinThreads(true);
+}
+
+void WorkStealingThreadPool::IncBackgroundThreadsIfNeeded(int num) {
+  SetBackgroundThreadsInternal(num, false);
+}
+
+void WorkStealingThreadPool::SubmitJob(const std::function<void()>& job) {
+  auto copy(job);
+  Submit(std::move(copy), std::function<void()>(), nullptr);
+}
+
+void WorkStealingThreadPool::SubmitJob(std::function<void()>&& job) {
+  Submit(std::move(job), std::function<void()>(), nullptr);
+}
+
+void WorkStealingThreadPool::Schedule(void (*function)(void* arg1), void* arg,
+                                      void* tag,
+                                      void (*unschedFunction)(void* arg)) {
+  if (unschedFunction == nullptr) {
+    Submit(std::bind(function, arg), std::function<void()>(), tag);
+  } else {
+    Submit(std::bind(function, arg), std::bind(unschedFunction, arg), tag);
+  }
+}
+
+ThreadPool* NewWorkStealingThreadPool(int num_threads) {
+  WorkStealingThreadPool* thread_pool = new WorkStealingThreadPool();
+  thread_pool->SetBackgroundThreads(num_threads);
+  return thread_pool;
+}
+
+namespace {
+// An Env that runs the background jobs of Schedule() on
+// WorkStealingThreadPools, with the LOW and BOTTOM pools helping the pools of
+// higher priority. Everything else is forwarded to the base Env.
+class WorkStealingEnv : public EnvWrapper {
+ public:
+  explicit WorkStealingEnv(Env* base_env)
+      : EnvWrapper(base_env), thread_pools_(Priority::TOTAL) {
+    thread_status_updater_ = base_env->GetThreadStatusUpdater();
+    for (int pool_id = 0; pool_id < Env::Priority::TOTAL; ++pool_id) {
+      thread_pools_[pool_id].SetThreadPriority(
+          static_cast<Env::Priority>(pool_id));
+      // This allows later initializing the thread-local-env of each thread.
+      thread_pools_[pool_id].SetHostEnv(this);
+    }
+    // The USER pool neither helps nor is helped.
+    thread_pools_[Priority::LOW].AddHigherPriorityPool(
+        &thread_pools_[Priority::HIGH]);
+    thread_pools_[Priority::BOTTOM].AddHigherPriorityPool(
+        &thread_pools_[Priority::HIGH]);
+    thread_pools_[Priority::BOTTOM].AddHigherPriorityPool(
+        &thread_pools_[Priority::LOW]);
+  }
+
+  ~WorkStealingEnv() override {
+    // Join all pools before destroying any, as their threads may still be
+    // stealing from the other pools.
+    for (auto& thread_pool : thread_pools_) {
+      thread_pool.JoinAllThreads();
+    }
+  }
+
+  void Schedule(void (*function)(void* arg1), void* arg, Priority pri = LOW,
+                void* tag = nullptr,
+                void (*unschedFunction)(void* arg) = nullptr) override {
+    assert(pri >= Priority::BOTTOM && pri <= Priority::HIGH);
+    thread_pools_[pri].Schedule(function, arg, tag, unschedFunction);
+  }
+
+  int UnSchedule(void* arg, Priority pri) override {
+    return thread_pools_[pri].UnSchedule(arg);
+  }
+
+  unsigned int GetThreadPoolQueueLen(Priority pri = LOW) const override {
+    assert(pri >= Priority::BOTTOM && pri <= Priority::HIGH);
+    return thread_pools_[pri].GetQueueLen();
+  }
+
+  void SetBackgroundThreads(int num, Priority pri) override {
+    assert(pri >= Priority::BOTTOM && pri <= Priority::HIGH);
+    thread_pools_[pri].SetBackgroundThreads(num);
+  }
+
+  int GetBackgroundThreads(Priority pri) override {
+    assert(pri >= Priority::BOTTOM && pri <= Priority::HIGH);
+    return thread_pools_[pri].GetBackgroundThreads();
+  }
+
+  void IncBackgroundThreadsIfNeeded(int num, Priority pri) override {
+    assert(pri >= Priority::BOTTOM && pri <= Priority::HIGH);
+    thread_pools_[pri].IncBackgroundThreadsIfNeeded(num);
+  }
+
+  void LowerThreadPoolIOPriority(Priority pool = LOW) override {
+    assert(pool >= Priority::BOTTOM && pool <= Priority::HIGH);
+    thread_pools_[pool].LowerIOPriority();
+  }
+
+  void LowerThreadPoolCPUPriority(Priority pool = LOW) override {
+    assert(pool >= Priority::BOTTOM && pool <= Priority::HIGH);
+    thread_pools_[pool].LowerCPUPriority(CpuPriority::kLow);
+  }
+
+  Status LowerThreadPoolCPUPriority(Priority pool, CpuPriority pri) override {
+    assert(pool >= Priority::BOTTOM && pool <= Priority::HIGH);
+    thread_pools_[pool].LowerCPUPriority(pri);
+    return Status::OK();
+  }
+
+ private:
+  std::vector<WorkStealingThreadPool> thread_pools_;
+};
+}  // namespace
+
+Env* NewWorkStealingEnv(Env* base_env) { return new WorkStealingEnv(base_env); }
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,152 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/env.h"
+#include "rocksdb/threadpool.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A ThreadPool in which every worker thread has a job queue of its own.
+// Submitted jobs are spread over the queues round-robin, so submitters and
+// workers only contend on the lock of a single queue instead of on the lock
+// of the whole pool. A worker runs the jobs of its own queue first and steals
+// from the other queues of the pool once it runs out of them.
+//
+// Worker threads are started on demand, when a job is submitted and no worker
+// is idle, up to the number of background threads of the pool.
+//
+// A pool can also steal from pools of higher priority (see
+// AddHigherPriorityPool()): a worker that finds no job in its own pool runs
+// the oldest queued job of the first higher priority pool that has one, so
+// that, for example, idle compaction threads pick up flushes that are waiting
+// for a flush thread. Pools whose threads run at a lowered IO or CPU priority
+// never steal.
+//
+// The interface mirrors the one of ThreadPoolImpl.
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  WorkStealingThreadPool();
+  ~WorkStealingThreadPool() override;
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // Implement ThreadPool interfaces
+  void JoinAllThreads() override;
+  void SetBackgroundThreads(int num) override;
+  int GetBackgroundThreads() override;
+  unsigned int GetQueueLen() const override;
+  void WaitForJobsAndJoinAllThreads() override;
+  void SubmitJob(const std::function<void()>&) override;
+  void SubmitJob(std::function<void()>&&) override;
+
+  void LowerIOPriority();
+  void LowerCPUPriority(CpuPriority pri);
+  void IncBackgroundThreadsIfNeeded(int num);
+
+  void Schedule(void (*function)(void* arg1), void* arg, void* tag,
+                void (*unschedFunction)(void* arg));
+  int UnSchedule(void* tag);
+
+  void SetHostEnv(Env* env) { env_ = env; }
+  Env* GetHostEnv() const { return env_; }
+
+  Env::Priority GetThreadPriority() const { return priority_; }
+  void SetThreadPriority(Env::Priority priority) { priority_ = priority; }
+
+  // Lets the idle workers of this pool run the jobs of `pool`. Pools are
+  // tried in the order they were added. Must be called before any job is
+  // submitted to either pool, and `pool` must outlive this one.
+  void AddHigherPriorityPool(WorkStealingThreadPool* pool);
+
+ private:
+  struct BGItem {
+    void* tag = nullptr;
+    std::function<void()> function;
+    std::function<void()> unschedFunction;
+  };
+
+  struct Queue {
+    std::mutex mu;
+    std::deque<BGItem> items;
+  };
+
+  // Queues are created with the workers owning them. Workers beyond
+  // kMaxQueues share the queues of the first ones.
+  static const size_t kMaxQueues = 64;
+
+  static void BGThreadWrapper(void* arg);
+  void BGThread(size_t thread_id);
+
+  void Submit(std::function<void()>&& schedule,
+              std::function<void()>&& unschedule, void* tag);
+  // Takes the next job of the pool, preferring the queue of worker
+  // `thread_id`, if any.
+  bool TakeJob(const size_t* thread_id, BGItem* item);
+  // Takes the next job of the first higher priority pool that has one.
+  bool StealFromHigherPriorityPools(BGItem* item,
+                                    WorkStealingThreadPool** from);
+  bool CanSteal() const;
+  bool HasWork() const;
+
+  // Wakes up an idle worker, or starts a new one if there is none and the
+  // pool has room for it. Then gives the pools stealing from this one a
+  // chance to run the job.
+  void WakeUpOrStartWorker();
+  // Wakes up an idle worker of this pool, if it may steal a job.
+  void WakeUpThief();
+
+  // REQUIRES: mu_ held
+  void StartBGThread();
+  bool HasExcessiveThread() const {
+    return static_cast<int>(bgthreads_.size()) > total_threads_limit_.load();
+  }
+  bool IsLastExcessiveThread(size_t thread_id) const {
+    return HasExcessiveThread() && thread_id == bgthreads_.size() - 1;
+  }
+  bool IsExcessiveThread(size_t thread_id) const {
+    return static_cast<int>(thread_id) >= total_threads_limit_.load();
+  }
+
+  void JoinThreads(bool wait_for_jobs_to_complete);
+  void SetBackgroundThreadsInternal(int num, bool allow_reduce);
+
+  Env* env_;
+  Env::Priority priority_;
+  std::vector<WorkStealingThreadPool*> higher_priority_pools_;
+  std::vector<WorkStealingThreadPool*> lower_priority_pools_;
+
+  std::unique_ptr<Queue> queues_[kMaxQueues];
+  std::atomic<size_t> num_queues_;
+  std::atomic<size_t> next_queue_;
+  std::atomic<unsigned int> queue_len_;
+
+  std::atomic<int> total_threads_limit_;
+  // Size of bgthreads_, readable without holding mu_.
+  std::atomic<int> num_threads_;
+  std::atomic<int> num_idle_threads_;
+  std::atomic<bool> exit_all_threads_;
+  std::atomic<bool> wait_for_jobs_to_complete_;
+  std::atomic<bool> low_io_priority_;
+  std::atomic<CpuPriority> cpu_priority_;
+
+  // Protects bgthreads_ and the waits on bgsignal_.
+  std::mutex mu_;
+  std::condition_variable bgsignal_;
+  std::vector<port::Thread> bgthreads_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
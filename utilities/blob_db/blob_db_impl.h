@@ -119,6 +119,13 @@ class BlobDBImpl : public BlobDB {
     return Status::NotSupported("Not implemented");
   }
 
+  virtual Status NewPartitionedIterators(
+      const ReadOptions& /*options*/, ColumnFamilyHandle* /*column_family*/,
+      size_t /*num_partitions*/,
+      std::vector<Iterator*>* /*iterators*/) override {
+    return Status::NotSupported("Not implemented");
+  }
+
   using BlobDB::MultiGet;
   virtual std::vector<Status> MultiGet(
       const ReadOptions& read_options,
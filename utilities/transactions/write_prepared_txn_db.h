@@ -105,6 +105,14 @@ class WritePreparedTxnDB : public PessimisticTransactionDB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) override;
 
+  virtual Status NewPartitionedIterators(
+      const ReadOptions& /*options*/, ColumnFamilyHandle* /*column_family*/,
+      size_t /*num_partitions*/,
+      std::vector<Iterator*>* /*iterators*/) override {
+    return Status::NotSupported(
+        "NewPartitionedIterators() is not supported by WritePreparedTxnDB.");
+  }
+
   // Check whether the transaction that wrote the value with sequence number seq
   // is visible to the snapshot with sequence number snapshot_seq.
   // Returns true if commit_seq <= snapshot_seq